@@ -59,8 +59,11 @@
  * @{
  */
 
-//! Flag to make a process shared binary semaphore.
+//! Flag to make a process shared binary semaphore, it has to be placed in shared memory.
 #define OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED         0x00000020u
+//! Flag to make a binary semaphore with a pollable file descriptor. The descriptor is
+//! local to the process, so it can not be combined with \ref OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED.
+#define OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE               0x00000040u
 
 //! Binary semaphore attribute type.
 typedef osal_uint32_t osal_binary_semaphore_attr_t;
@@ -79,7 +82,10 @@ extern "C" {
  *                      the defaults of the underlying mutex will be used.
  *
  *
- * \return OK or ERROR_CODE.
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       \ref OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE together with
+ *                                      \ref OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED.
+ * \return Other ERROR_CODE otherwise.
  */
 osal_retval_t osal_binary_semaphore_init(osal_binary_semaphore_t *sem, const osal_binary_semaphore_attr_t *attr);
 
@@ -130,6 +136,7 @@ osal_retval_t osal_binary_semaphore_trywait(osal_binary_semaphore_t *sem);
  *
  * \retval OK               on success.
  * \retval OSAL_ERR_TIMEOUT if there was no \ref osal_binary_semaphore_post in the specified timeout.
+ * \retval OSAL_ERR_INVALID_PARAM if the clock of \p to is invalid.
  */
 osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, const osal_timer_t *to);
 
@@ -143,6 +150,22 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
  */
 osal_retval_t osal_binary_semaphore_destroy(osal_binary_semaphore_t *sem);
 
+//! \brief Get pollable file descriptor of a binary_semaphore.
+/*!
+ * The binary semaphore has to be initialized with 
+ * \ref OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE. The descriptor becomes readable 
+ * when the binary semaphore was posted and can be added to a \ref osal_waitset_t.
+ * Readiness does not consume the signal, call \ref osal_binary_semaphore_trywait 
+ * afterwards. The descriptor is local to the calling process and only inherited by fork.
+ *
+ * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \retval OK                           on success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     if binary semaphore is not pollable.
+ */
+osal_retval_t osal_binary_semaphore_get_fd(osal_binary_semaphore_t *sem, osal_int32_t *fd);
+
 #ifdef __cplusplus
 };
 #endif
@@ -73,6 +73,8 @@
 #define OSAL_CONDVAR_ATTR__PROTOCOL__INHERIT      0x00000100u   //!< \brief Inherit protocol.
 #define OSAL_CONDVAR_ATTR__PROTOCOL__PROTECT      0x00000200u   //!< \brief Protect protocol.
 
+#define OSAL_CONDVAR_ATTR__CLOCK_REALTIME         0x00001000u   //!< \brief Timed waits on CLOCK_REALTIME instead of CLOCK_MONOTONIC.
+
 #define OSAL_CONDVAR_ATTR__PRIOCEILING__MASK      0xFFFF0000u   //!< \brief Mask for priority ceiling protocol.
 #define OSAL_CONDVAR_ATTR__PRIOCEILING__SHIFT     16u           //!< \brief Priority ceiling value shift.
 
@@ -84,7 +86,8 @@ extern "C" {
 
 //! \brief Initialize a condvar.
 /*!
- * This function initializes a condition variable.
+ * This function initializes a condition variable. Timed waits run on 
+ * the monotonic clock unless \ref OSAL_CONDVAR_ATTR__CLOCK_REALTIME is set.
  *
  * \param[in]   cv      Pointer to osal condvar structure. Content is OS dependent.
  * \param[in]   attr    Pointer to initial condvar attributes. Can be NULL then
@@ -120,12 +123,12 @@ osal_retval_t osal_condvar_wait(osal_condvar_t *cv, osal_mutex_t *mtx);
  *
  * \param[in]   cv      Pointer to osal condvar structure. Content is OS dependent.
  * \param[in]   mtx     Pointer to osal mutex structure. Content is OS dependent.
- * \param[in]   timeout Timeout
+ * \param[in]   timeout Timeout, converted if it is not on the clock of \p cv.
  *
  * \retval OSAL_OK                      On success.
  * \retval OSAL_ERR_TIMEOUT             Timeout expired waiting on condition.
  * \retval OSAL_ERR_PERMISSION_DENIED   Mutex was not owner by thread.
- * \retval OSAL_ERR_INVALID_PARAM       Condvar is invalid/not initalized.
+ * \retval OSAL_ERR_INVALID_PARAM       Condvar is invalid/not initalized or clock of \p timeout is invalid.
  */
 osal_retval_t osal_condvar_timedwait(osal_condvar_t *cv, osal_mutex_t *mtx, const osal_timer_t *timeout);
 
@@ -0,0 +1,144 @@
+#ifndef _INCLUDE_LIBOSAL_CONFIG_H
+#define _INCLUDE_LIBOSAL_CONFIG_H 1
+
+/* Use MINGW32 build on windows mingw32 */
+/* #undef LIBOSAL_BUILD_MINGW32 */
+
+/* Use PikeOS build */
+/* #undef LIBOSAL_BUILD_PIKEOS */
+
+/* Use POSIX build on linux */
+#define LIBOSAL_BUILD_POSIX 1
+
+/* Use VxWorks build */
+/* #undef LIBOSAL_BUILD_VXWORKS */
+
+/* Use Win32 build */
+/* #undef LIBOSAL_BUILD_WIN32 */
+
+/* Define to 1 if you have the <dlfcn.h> header file. */
+#define LIBOSAL_HAVE_DLFCN_H 1
+
+/* Check if errno ENOTRECOVERABLE is present. */
+#define LIBOSAL_HAVE_ENOTRECOVERABLE 1
+
+/* Define to 1 if you have the <inttypes.h> header file. */
+#define LIBOSAL_HAVE_INTTYPES_H 1
+
+/* Define to 1 if you have the <linux/futex.h> header file. */
+#define LIBOSAL_HAVE_LINUX_FUTEX_H 1
+
+/* Define to 1 if you have the <math.h> header file. */
+#define LIBOSAL_HAVE_MATH_H 1
+
+/* Define to 1 if you have the <mqueue.h> header file. */
+#define LIBOSAL_HAVE_MQUEUE_H 1
+
+/* Define to 1 if you have the <p4ext_threads.h> header file. */
+/* #undef LIBOSAL_HAVE_P4EXT_THREADS_H */
+
+/* Check if pikeos support p4_mutext_init_ext. */
+/* #undef LIBOSAL_HAVE_P4_MUTEX_INIT_EXT */
+
+/* Check if posix function pthread_mutexattr_setrobust present. */
+#define LIBOSAL_HAVE_PTHREAD_MUTEXATTR_SETROBUST 1
+
+/* Check if posix function pthread_setaffinity_np present. */
+#define LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP 1
+
+/* Check if posix function pthread_rwlockattr_setkind_np present. */
+#define LIBOSAL_HAVE_PTHREAD_RWLOCKATTR_SETKIND_NP 1
+
+/* Check if posix function pthread_rwlock_clockrdlock present. */
+#define LIBOSAL_HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK 1
+
+/* Check if posix function sem_clockwait present. */
+#define LIBOSAL_HAVE_SEM_CLOCKWAIT 1
+
+/* Check if signal SIGCONT is present. */
+#define LIBOSAL_HAVE_SIGCONT 1
+
+/* Check if signal SIGSTOP is present. */
+#define LIBOSAL_HAVE_SIGSTOP 1
+
+/* Define to 1 if you have the <stdint.h> header file. */
+#define LIBOSAL_HAVE_STDINT_H 1
+
+/* Define to 1 if you have the <stdio.h> header file. */
+#define LIBOSAL_HAVE_STDIO_H 1
+
+/* Define to 1 if you have the <stdlib.h> header file. */
+#define LIBOSAL_HAVE_STDLIB_H 1
+
+/* Define to 1 if you have the <strings.h> header file. */
+#define LIBOSAL_HAVE_STRINGS_H 1
+
+/* Define to 1 if you have the <string.h> header file. */
+#define LIBOSAL_HAVE_STRING_H 1
+
+/* Define to 1 if you have the <sys/epoll.h> header file. */
+#define LIBOSAL_HAVE_SYS_EPOLL_H 1
+
+/* Define to 1 if you have the `epoll_pwait2' function. */
+#define LIBOSAL_HAVE_EPOLL_PWAIT2 1
+
+/* Define to 1 if you have the <sys/eventfd.h> header file. */
+#define LIBOSAL_HAVE_SYS_EVENTFD_H 1
+
+/* Define to 1 if you have the <sys/mman.h> header file. */
+#define LIBOSAL_HAVE_SYS_MMAN_H 1
+
+/* Define to 1 if you have the <sys/prctl.h> header file. */
+#define LIBOSAL_HAVE_SYS_PRCTL_H 1
+
+/* Define to 1 if you have the <sys/stat.h> header file. */
+#define LIBOSAL_HAVE_SYS_STAT_H 1
+
+/* Define to 1 if you have the <sys/types.h> header file. */
+#define LIBOSAL_HAVE_SYS_TYPES_H 1
+
+/* Define to 1 if you have the <unistd.h> header file. */
+#define LIBOSAL_HAVE_UNISTD_H 1
+
+/* Define to the sub-directory where libtool stores uninstalled libraries. */
+/* #undef LIBOSAL_LT_OBJDIR */
+
+/* Name of package */
+#define LIBOSAL_PACKAGE ""
+
+/* Define to the address where bug reports for this package should be sent. */
+/* #undef LIBOSAL_PACKAGE_BUGREPORT */
+
+/* Define to the full name of this package. */
+#define LIBOSAL_PACKAGE_NAME ""
+
+/* Define to the full name and version of this package. */
+#define LIBOSAL_PACKAGE_STRING ""
+
+/* Define to the one symbol short name of this package. */
+#define LIBOSAL_PACKAGE_TARNAME ""
+
+/* Define to the home page for this package. */
+/* #undef LIBOSAL_PACKAGE_URL */
+
+/* Define to the version of this package. */
+#define LIBOSAL_PACKAGE_VERSION ""
+
+/* Define to 1 if all of the C90 standard headers exist (not just the ones
+   required in a freestanding environment). This macro is provided for
+   backward compatibility; new code need not use it. */
+#define LIBOSAL_STDC_HEADERS 1
+
+/* Version number of package */
+#define LIBOSAL_VERSION ""
+
+/* Define for Solaris 2.5.1 so the uint32_t typedef from <sys/synch.h>,
+   <pthread.h>, or <semaphore.h> is not used. If the typedef were allowed, the
+   #define below would cause a syntax error. */
+/* #undef LIBOSAL__UINT32_T */
+
+/* Define to the type of an unsigned integer type of width exactly 32 bits if
+   such a type exists and the standard includes do not define it. */
+/* #undef LIBOSAL_uint32_t */
+
+#endif
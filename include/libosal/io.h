@@ -51,16 +51,81 @@
  */
 
 #define LIBOSAL_IO_SHM_MAX_MSG_SIZE 512     //!< \brief Maximum message size.
+#define LIBOSAL_IO_SHM_MAX_ACQUIRE  256     //!< \brief Maximum messages returned by \ref osal_io_shm_acquire_messages.
+#define LIBOSAL_IO_SHM_FMT_TABLE_SIZE   65536u  //!< \brief Size of format table in shm.
+
+#define LIBOSAL_IO_SHM_MAX_TASK_RINGS   64u     //!< \brief Maximum number of per task rings.
+
+#define OSAL_IO_SHM_ATTR__BINARY                0x00000001u     //!< \brief Defer formatting of messages to the reader.
+#define OSAL_IO_SHM_ATTR__TASK_RINGS__MASK      0x0000FF00u     //!< \brief Number of per task rings mask.
+#define OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT     8u              //!< \brief Number of per task rings shift.
+
+#define OSAL_IO_SHM_ATTR__OVERFLOW__MASK        0x00000030u     //!< \brief Overflow policy mask.
+#define OSAL_IO_SHM_ATTR__OVERFLOW__DROP_OLDEST 0x00000000u     //!< \brief Drop oldest message if ring is full (default).
+#define OSAL_IO_SHM_ATTR__OVERFLOW__DROP_NEWEST 0x00000010u     //!< \brief Drop new message if ring is full.
+#define OSAL_IO_SHM_ATTR__OVERFLOW__BLOCK       0x00000020u     //!< \brief Wait for reader if ring is full.
+
+#define OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__MASK   0xFFFF0000u     //!< \brief Blocking timeout in [ms] mask, 0 waits forever.
+#define OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__SHIFT  16u             //!< \brief Blocking timeout in [ms] shift.
+
+//! \brief Shm io attributes.
+typedef osal_uint32_t osal_io_shm_attr_t;
+
+#define OSAL_IO_LOG_LEVEL__ERROR                1u              //!< \brief Error messages.
+#define OSAL_IO_LOG_LEVEL__WARNING              2u              //!< \brief Warning messages.
+#define OSAL_IO_LOG_LEVEL__INFO                 3u              //!< \brief Informational messages (default).
+#define OSAL_IO_LOG_LEVEL__DEBUG                4u              //!< \brief Debug messages.
+
+//! \brief Message in shm returned by \ref osal_io_shm_acquire_messages.
+typedef struct osal_io_shm_msg {
+    const osal_char_t  *msg;        //!< Pointer to message text in shm, zero-terminated.
+    osal_size_t         len;        //!< Length of message text.
+    osal_uint64_t       timestamp;  //!< Monotonic time of message in [ns].
+    osal_uint32_t       level;      //!< Log level, OSAL_IO_LOG_LEVEL__*.
+    osal_uint32_t       tid;        //!< Task id of writer.
+    const osal_char_t  *tag;        //!< Tag of message in shm, NULL if none.
+} osal_io_shm_msg_t;
+
+//! \brief Statistics of shm returned by \ref osal_io_shm_get_stats.
+typedef struct osal_io_shm_stats {
+    osal_uint32_t       num_rings;          //!< Number of rings including the shared ring.
+    osal_uint64_t       size;               //!< Size of each ring in bytes.
+    osal_uint64_t       messages;           //!< Number of published messages.
+    osal_uint64_t       bytes;              //!< Number of published bytes.
+    osal_uint64_t       dropped;            //!< Number of dropped messages.
+    osal_uint64_t       high_water_mark;    //!< Maximum number of used bytes in any ring.
+} osal_io_shm_stats_t;
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-//! \brief Get the current state of a created thread.
+//! \brief Log message with level and tag.
 /*!
+ * The level is checked before the arguments are evaluated or formatted, so 
+ * disabled levels only cost reading the log level and a compare.
+ *
+ * \param[in]   level   Log level, OSAL_IO_LOG_LEVEL__*.
+ * \param[in]   tag     Tag of message, a string literal or otherwise static
+ *                      string, may be NULL.
+ *
+ * \return See \ref osal_log_printf, OSAL_OK if level is disabled.
+ */
+#define osal_log(level, tag, ...) \
+    (((osal_uint32_t)(level) <= osal_io_get_log_level()) ? osal_log_printf((level), (tag), __VA_ARGS__) : OSAL_OK)
+
+//! \brief Format and print data.
+/*!
+ * If printing to shm was set up with \ref osal_io_shm_setup the message is
+ * published to the shm ring. This is lock-free and may be called concurrently
+ * from any number of tasks or processes.
+ *
  * \param[in]   fmt     Print format.
  *
- * \return OK or ERROR_CODE.
+ * \retval OSAL_OK          On success.
+ * \retval OSAL_ERR_BUSY    Shm ring was full and message was dropped.
+ * \retval OSAL_ERR_TIMEOUT Shm ring was full until blocking timeout expired, 
+ *                          message was dropped.
  */
 #ifdef LIBOSAL_BUILD_WIN32
 osal_retval_t osal_printf(const osal_char_t *fmt, ...);
@@ -68,6 +133,42 @@ osal_retval_t osal_printf(const osal_char_t *fmt, ...);
 osal_retval_t osal_printf(const osal_char_t *fmt, ...)  __attribute__ ((format (printf, 1, 2)));
 #endif
 
+//! \brief Format and print data with log level and tag.
+/*!
+ * Like \ref osal_printf but records \p level and \p tag with the message. 
+ * Printing to stdout prefixes the message with the tag. Tags are identified
+ * by their pointer like binary format strings, so they have to stay valid 
+ * for the lifetime of the process. Usually called by \ref osal_log.
+ *
+ * \param[in]   level   Log level, OSAL_IO_LOG_LEVEL__*.
+ * \param[in]   tag     Tag of message, may be NULL.
+ * \param[in]   fmt     Print format.
+ *
+ * \return See \ref osal_printf.
+ */
+#ifdef LIBOSAL_BUILD_WIN32
+osal_retval_t osal_log_printf(osal_uint32_t level, const osal_char_t *tag, const osal_char_t *fmt, ...);
+#else
+osal_retval_t osal_log_printf(osal_uint32_t level, const osal_char_t *tag, const osal_char_t *fmt, ...)
+    __attribute__ ((format (printf, 3, 4)));
+#endif
+
+//! \brief Set log level.
+/*!
+ * Messages above \p level are discarded, whether logged with \ref osal_log,
+ * \ref osal_log_printf or with \ref osal_printf, which logs at 
+ * OSAL_IO_LOG_LEVEL__INFO.
+ *
+ * \param[in]   level   Log level, OSAL_IO_LOG_LEVEL__*.
+ */
+osal_void_t osal_io_set_log_level(osal_uint32_t level);
+
+//! \brief Get log level.
+/*!
+ * \return Current log level.
+ */
+osal_uint32_t osal_io_get_log_level(osal_void_t);
+
 osal_int32_t osal_vfprintf(osal_file_t *stream, const osal_char_t *format, osal_va_list_t ap);
 
 //! \brief Write message to stdout
@@ -84,10 +185,57 @@ osal_retval_t osal_puts(const osal_char_t *msg);
  * \param[in]   max_msgs        Maximum number of messages.
  * \param[in]   max_msg_size    Maximum message size.
  *
+ * The ring is sized to hold \p max_msgs messages of \p max_msg_size bytes.
+ * Messages only take the space they need, so the ring holds correspondingly 
+ * more of shorter messages.
+ *
+ * If the shared memory already exists and was initialized by another process,
+ * its ring size and message size are used.
+ *
  * \return OSAL_OK on success, otherwise OSAL_ERR_*
  */
 osal_retval_t osal_io_shm_setup(const osal_char_t *shm_name, const osal_size_t max_msgs, const osal_size_t max_msg_size);
 
+//! \brief Set up printing to shm instead of stdout with attributes
+/*!
+ * With \ref OSAL_IO_SHM_ATTR__BINARY set, \ref osal_printf does not format
+ * the message. It only records a format id, a timestamp and the raw argument
+ * words, strings are copied into the message. Format strings are registered
+ * once per process in a format table exported in the shm, formatting is done
+ * by the reader in \ref osal_io_shm_get_message. Formats which can not be
+ * recorded this way (e.g. '%n', 'long double' or more than 16 arguments) are
+ * still formatted by the writer.
+ *
+ * The format string pointer identifies a format. If a buffer is reused for
+ * another format, the changed content is detected and these messages are
+ * formatted by the writer.
+ *
+ * With a number of task rings set in \ref OSAL_IO_SHM_ATTR__TASK_RINGS__MASK
+ * (at most \ref LIBOSAL_IO_SHM_MAX_TASK_RINGS), the shm additionally holds 
+ * that many single writer rings of the same size. A task takes 
+ * ownership of one of them on its first print and keeps it until it exits, so
+ * writers do not contend with each other. Rings of tasks which died without
+ * releasing them, e.g. in a crashed process, are taken over by new tasks.
+ * Tasks which do not get a ring of their own share the common ring. Readers 
+ * merge all rings by message timestamp. The number of task rings is fixed by 
+ * whoever creates the shm, if an existing shm has another number a warning 
+ * is printed and its layout is used.
+ *
+ * \ref OSAL_IO_SHM_ATTR__OVERFLOW__MASK selects what \ref osal_printf does 
+ * on a full ring: drop the oldest message, drop the new message, or wait for
+ * the reader for at most the time given in \ref OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__MASK.
+ * Like binary mode, the policy applies to the calling process only.
+ *
+ * \param[in]   shm_name        Name of logging shared memory.
+ * \param[in]   max_msgs        Maximum number of messages.
+ * \param[in]   max_msg_size    Maximum message size.
+ * \param[in]   attr            Pointer to shm io attributes, may be NULL.
+ *
+ * \return OSAL_OK on success, otherwise OSAL_ERR_*
+ */
+osal_retval_t osal_io_shm_setup_attr(const osal_char_t *shm_name, const osal_size_t max_msgs, 
+        const osal_size_t max_msg_size, const osal_io_shm_attr_t *attr);
+
 //! \brief Get next message printed to shm.
 /*!
  * \param[out]   msg        Message to be returned.
@@ -98,6 +246,69 @@ osal_retval_t osal_io_shm_setup(const osal_char_t *shm_name, const osal_size_t m
 osal_retval_t osal_io_shm_get_message(osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE],
         const osal_timer_t *to);
 
+//! \brief Get all available messages printed to shm.
+/*!
+ * Drains up to \p max_msgs messages. If no message is available and \p to
+ * is given the caller sleeps until a writer signals or the timeout expires.
+ * Writers only issue a wakeup while the reader is sleeping, so a burst of
+ * messages costs a single wakeup.
+ *
+ * \param[out]   msgs       Array of message buffers.
+ * \param[in]    max_msgs   Number of buffers in \p msgs.
+ * \param[out]   cnt        Number of messages returned.
+ * \param[in]    to         Absolute timeout when waiting if no message is 
+ *                          available, NULL to return immediately.
+ *
+ * \return OSAL_OK if at least one message was returned, otherwise OSAL_ERR_UNAVAILABLE 
+ */
+osal_retval_t osal_io_shm_get_messages(osal_char_t msgs[][LIBOSAL_IO_SHM_MAX_MSG_SIZE],
+        const osal_size_t max_msgs, osal_size_t *cnt, const osal_timer_t *to);
+
+//! \brief Get all available messages printed to shm without copying.
+/*!
+ * Like \ref osal_io_shm_get_messages but returns pointers into the mapped
+ * shm ring. The messages stay valid and are not overwritten by writers 
+ * until they are released with \ref osal_io_shm_commit_messages. While
+ * messages are held and the ring runs full, new messages are dropped.
+ *
+ * Binary messages (see \ref OSAL_IO_SHM_ATTR__BINARY) are formatted into 
+ * a process local buffer, at most \ref LIBOSAL_IO_SHM_MAX_ACQUIRE messages
+ * are returned per call.
+ *
+ * Only one batch may be held at a time by a process.
+ *
+ * \param[out]   msgs       Array of message descriptors.
+ * \param[in]    max_msgs   Number of descriptors in \p msgs.
+ * \param[out]   cnt        Number of messages returned.
+ * \param[in]    to         Absolute timeout when waiting if no message is 
+ *                          available, NULL to return immediately.
+ *
+ * \retval OSAL_OK                 At least one message was returned.
+ * \retval OSAL_ERR_UNAVAILABLE    No message available.
+ * \retval OSAL_ERR_BUSY           Previous batch was not committed.
+ */
+osal_retval_t osal_io_shm_acquire_messages(osal_io_shm_msg_t *msgs, const osal_size_t max_msgs, 
+        osal_size_t *cnt, const osal_timer_t *to);
+
+//! \brief Release messages returned by \ref osal_io_shm_acquire_messages.
+/*!
+ * \retval OSAL_OK                 On success.
+ * \retval OSAL_ERR_INVALID_PARAM  No messages are held.
+ */
+osal_retval_t osal_io_shm_commit_messages(osal_void_t);
+
+//! \brief Get statistics of shm.
+/*!
+ * Counters are kept in the shm and updated lock-free by all writers, 
+ * so a reader process like the logger tool can monitor them.
+ *
+ * \param[out]   stats      Statistics.
+ *
+ * \retval OSAL_OK                 On success.
+ * \retval OSAL_ERR_UNAVAILABLE    Printing to shm was not set up.
+ */
+osal_retval_t osal_io_shm_get_stats(osal_io_shm_stats_t *stats);
+
 #ifdef __cplusplus
 };
 #endif
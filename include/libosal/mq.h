@@ -60,6 +60,7 @@
 #define OSAL_MQ_ATTR__OFLAG__CREAT            0x00000008u   //!< \brief Message queue attribute flag create
 #define OSAL_MQ_ATTR__OFLAG__CLOEXEC          0x00000010u   //!< \brief Message queue attribute flag close execute
 #define OSAL_MQ_ATTR__OFLAG__EXCL             0x00000020u   //!< \brief Message queue attribute flag exclusive
+#define OSAL_MQ_ATTR__OFLAG__SHM_RING         0x00000040u   //!< \brief Message queue is a lock-free ring in shared memory
 
 typedef struct osal_mq_attr {
     osal_uint32_t   oflags;                 //!< \brief Message queue open flags.
@@ -68,12 +69,27 @@ typedef struct osal_mq_attr {
     osal_size_t     max_message_size;       //!< \brief Message queue maximum message size.
 } osal_mq_attr_t;                           //!< \brief Message queue attribute type.
 
+//! \brief Message for \ref osal_mq_send_batch and \ref osal_mq_receive_batch.
+typedef struct osal_mq_msg {
+    osal_char_t    *msg;                    //!< \brief Message buffer.
+    osal_size_t     len;                    //!< \brief Message length, size of buffer on receive.
+    osal_uint32_t   prio;                   //!< \brief Message priority.
+} osal_mq_msg_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 //! \brief Initialize a mq.
 /*!
+ * With \ref OSAL_MQ_ATTR__OFLAG__SHM_RING set, the queue is a lock-free ring
+ * of \p max_messages slots in a shared memory called \p name instead of an 
+ * OS message queue. Sending and receiving only copy the message and do not
+ * enter the kernel unless the peer is blocked on a full or empty ring.
+ * Priorities are passed through, but messages are received in FIFO order.
+ * Timeouts are absolute on the clock of the timer. If the shared memory 
+ * already exists, its ring parameters are used.
+ *
  * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
  * \param[in]   name    Pointer containing message queue name.
  * \param[in]   attr    Pointer to initial mq attributes. Can be NULL then
@@ -138,6 +154,117 @@ osal_retval_t osal_mq_receive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t
 osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t msg_len, 
         osal_uint32_t *prio, const osal_timer_t *to);
 
+//! \brief Send a batch of messages through message queue.
+/*!
+ * Sends the messages in order and waits if the queue is full. With 
+ * \ref OSAL_MQ_ATTR__OFLAG__SHM_RING blocked receivers are woken at most
+ * once per batch, and once more each time the sender has to wait for space.
+ *
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msgs    Messages to send.
+ * \param[in]   cnt     Number of messages.
+ * \param[out]  sent    Returns number of messages sent.
+ * \param[in]   to      Timeout waiting if message queue is full, NULL waits forever.
+ *
+ * \return OSAL_OK if all messages were sent, otherwise the error of the 
+ *         first message not sent, see \ref osal_mq_timedsend.
+ */
+osal_retval_t osal_mq_send_batch(osal_mq_t *mq, const osal_mq_msg_t *msgs, const osal_size_t cnt,
+        osal_size_t *sent, const osal_timer_t *to);
+
+//! \brief Receive a batch of messages through message queue.
+/*!
+ * Waits for the first message only, then receives what is available up to
+ * \p cnt messages. With \ref OSAL_MQ_ATTR__OFLAG__SHM_RING blocked senders 
+ * are woken at most once per batch.
+ *
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in,out] msgs      Message buffers, \p len has to be set to the buffer
+ *                          size and returns the message length.
+ * \param[in]   cnt         Number of message buffers.
+ * \param[out]  received    Returns number of messages received.
+ * \param[in]   to          Timeout waiting if message queue is empty, NULL waits forever.
+ *
+ * \return OSAL_OK if at least one message was received, otherwise see
+ *         \ref osal_mq_timedreceive.
+ */
+osal_retval_t osal_mq_receive_batch(osal_mq_t *mq, osal_mq_msg_t *msgs, const osal_size_t cnt,
+        osal_size_t *received, const osal_timer_t *to);
+
+//! \brief Reserve a message in the message queue.
+/*!
+ * The message is built directly in the queue storage and becomes visible
+ * to receivers with \ref osal_mq_commit. Waits like \ref osal_mq_send if 
+ * the queue is full. Messages are sent with priority 0. Only supported 
+ * with \ref OSAL_MQ_ATTR__OFLAG__SHM_RING.
+ *
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   len     Length of message.
+ * \param[out]  ptr     Returns pointer to \p len bytes of message storage.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p len exceeds the maximum message size.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Message queue is not a shm ring.
+ */
+osal_retval_t osal_mq_reserve(osal_mq_t *mq, const osal_size_t len, osal_void_t **ptr);
+
+//! \brief Commit a reserved message to the message queue.
+/*!
+ * Receivers get messages in the order they were reserved, so a message 
+ * which is reserved but not yet committed holds back later ones.
+ *
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_mq_reserve.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p ptr is no reserved message of \p mq,
+ *                                  e.g. it was committed already.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Message queue is not a shm ring.
+ */
+osal_retval_t osal_mq_commit(osal_mq_t *mq, osal_void_t *ptr);
+
+//! \brief Get next message in the message queue without copying it.
+/*!
+ * The message stays in the queue storage until it is released with
+ * \ref osal_mq_release. Waits like \ref osal_mq_receive if the queue is 
+ * empty. Only supported with \ref OSAL_MQ_ATTR__OFLAG__SHM_RING.
+ *
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to message.
+ * \param[out]  len     Returns length of message.
+ * \param[out]  prio    Returns priority of message, may be NULL.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Message queue is not a shm ring.
+ */
+osal_retval_t osal_mq_peek(osal_mq_t *mq, const osal_void_t **ptr, osal_size_t *len, osal_uint32_t *prio);
+
+//! \brief Release a message returned by \ref osal_mq_peek.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_mq_peek.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p ptr is no peeked message of \p mq,
+ *                                  e.g. it was released already.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Message queue is not a shm ring.
+ */
+osal_retval_t osal_mq_release(osal_mq_t *mq, const osal_void_t *ptr);
+
+//! \brief Get pollable file descriptor of message queue.
+/*!
+ * The descriptor becomes readable while messages are pending and can be 
+ * added to a \ref osal_waitset_t. Readiness does not consume a message, 
+ * call \ref osal_mq_timedreceive or \ref osal_mq_receive_batch afterwards.
+ *
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED Message queue has no pollable descriptor, e.g. a shm ring.
+ */
+osal_retval_t osal_mq_get_fd(osal_mq_t *mq, osal_int32_t *fd);
+
 //! \brief Closes an open mq.
 /*!
  * \param[in]   mq     Pointer to osal mq structure. Content is OS dependent.
@@ -64,6 +64,11 @@
 
 #define OSAL_MUTEX_ATTR__ROBUST                 0x00000010u     //!< \brief Robust mutex (unlocks if owner died)
 #define OSAL_MUTEX_ATTR__PROCESS_SHARED         0x00000020u     //!< \brief Process shared mutex.
+#define OSAL_MUTEX_ATTR__ADAPTIVE               0x00000040u     //!< \brief Spin bounded before blocking in \ref osal_mutex_lock.
+
+#define OSAL_MUTEX_ATTR__ADAPTIVE_SPIN__MASK    0x0000F000u     //!< \brief Adaptive spin mask, log2 of maximum spin iterations.
+#define OSAL_MUTEX_ATTR__ADAPTIVE_SPIN__SHIFT   12u             //!< \brief Adaptive spin shift, 0 selects the default.
+#define OSAL_MUTEX_ADAPTIVE_SPIN__DEFAULT       6u              //!< \brief Default log2 of maximum spin iterations.
 
 #define OSAL_MUTEX_ATTR__PROTOCOL__MASK         0x00000300u     //!< \brief Mutex protocol mask.
 #define OSAL_MUTEX_ATTR__PROTOCOL__NONE         0x00000000u     //!< \brief Mutex protocol default.
@@ -101,6 +106,11 @@ osal_retval_t osal_mutex_init(osal_mutex_t *mtx, const osal_mutex_attr_t *attr);
 /*!
  * This function tries to lock a mutex. If the mutex is already locked by another
  * task it blocks until the other task unlocks the mutex or an other error occures.
+ * Mutexes created with \ref OSAL_MUTEX_ATTR__ADAPTIVE first retry to acquire the
+ * lock with exponential backoff for a bounded number of attempts before blocking. 
+ * This avoids the sleep/wake round trip for short critical sections and keeps 
+ * priority inheritance and robustness of the underlying mutex. On systems with
+ * a single online cpu adaptive mutexes block immediately.
  *
  * \param[in]   mtx     Pointer to osal mutex structure. Content is OS dependent.
  *
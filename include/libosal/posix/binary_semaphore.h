@@ -31,12 +31,15 @@
 #ifndef LIBOSAL_POSIX_BINARY_SEMAPHORE__H
 #define LIBOSAL_POSIX_BINARY_SEMAPHORE__H
 
+#include <libosal/types.h>
 #include <pthread.h>
 
 typedef struct osal_binary_semaphore {
     pthread_mutex_t posix_mtx;
     pthread_cond_t posix_cond;
-    int value;
+    osal_uint32_t value;    //!< \brief State, futex word if futexes are available.
+    int shared;             //!< \brief Process shared binary semaphore.
+    int efd;                //!< \brief Eventfd if pollable, -1 otherwise.
 } osal_binary_semaphore_t;
 
 #endif /* LIBOSAL_POSIX_BINARY_SEMAPHORE__H */
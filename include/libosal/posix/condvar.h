@@ -35,6 +35,7 @@
 
 typedef struct osal_condvar {
     pthread_cond_t posix_cond;
+    clockid_t clock_id;         //!< \brief Clock of timed waits.
 } osal_condvar_t;
 
 #endif /* LIBOSAL_POSIX_CONDVAR__H */
@@ -32,9 +32,18 @@
 #define LIBOSAL_POSIX_MQ__H
 
 #include <mqueue.h>
+#include <libosal/shm.h>
+
+#define LIBOSAL_MQ_BACKEND_POSIX    0u      //!< \brief POSIX message queue.
+#define LIBOSAL_MQ_BACKEND_SHM_RING 1u      //!< \brief Lock-free ring in shared memory.
+
+struct osal_mq_ring;
 
 typedef struct osal_mq {
     mqd_t mq_desc;
+    osal_uint32_t backend;              //!< \brief Message queue backend, LIBOSAL_MQ_BACKEND_*.
+    osal_shm_t shm;                     //!< \brief Shared memory of ring.
+    struct osal_mq_ring *ring;          //!< \brief Ring in shared memory.
 } osal_mq_t;
 
 #endif /* LIBOSAL_POSIX_MQ__H */
@@ -35,6 +35,7 @@
 
 typedef struct osal_mutex {
     pthread_mutex_t posix_mtx;
+    unsigned int spin_count;    //!< \brief Maximum trylock attempts before blocking, 0 if not adaptive.
 } osal_mutex_t;
 
 #endif /* LIBOSAL_POSIX_MUTEX__H */
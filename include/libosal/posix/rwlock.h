@@ -0,0 +1,41 @@
+/**
+ * \file posix/rwlock.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL rwlock posix header.
+ *
+ * OSAL rwlock posix include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_RWLOCK__H
+#define LIBOSAL_POSIX_RWLOCK__H
+
+#include <pthread.h>
+
+typedef struct osal_rwlock {
+    pthread_rwlock_t posix_rwlock;
+} osal_rwlock_t;
+
+#endif /* LIBOSAL_POSIX_RWLOCK__H */
+
@@ -35,6 +35,7 @@
 
 typedef struct osal_semaphore {
     sem_t posix_sem;
+    int efd;                //!< \brief Eventfd if pollable, -1 otherwise.
 } osal_semaphore_t;
 
 #endif /* LIBOSAL_POSIX_SEMAPHORE__H */
@@ -31,10 +31,19 @@
 #ifndef LIBOSAL_POSIX_SPINLOCK__H
 #define LIBOSAL_POSIX_SPINLOCK__H
 
+#include <libosal/types.h>
 #include <pthread.h>
 
+struct osal_spinlock_mcs_node;
+
 typedef struct osal_spinlock {
-    pthread_spinlock_t posix_sl;
+    pthread_spinlock_t posix_sl;    //!< \brief Spinlock without owner tracking.
+    osal_uint32_t owner;            //!< \brief Task id of owner of robust or process shared spinlock, 0 if unlocked.
+    osal_uint32_t attr;             //!< \brief Spinlock attributes.
+    osal_uint32_t ticket_next;      //!< \brief Next ticket drawn by ticket spinlock waiter.
+    osal_uint32_t ticket_owner;     //!< \brief Ticket holding ticket spinlock.
+    struct osal_spinlock_mcs_node *mcs_tail;    //!< \brief Last waiter of MCS spinlock.
+    struct osal_spinlock_mcs_node *mcs_holder;  //!< \brief Queue node of MCS spinlock owner.
 } osal_spinlock_t;
 
 #endif /* LIBOSAL_POSIX_SPINLOCK__H */
@@ -31,10 +31,15 @@
 #ifndef LIBOSAL_POSIX_TASK__H
 #define LIBOSAL_POSIX_TASK__H
 
+#include <libosal/types.h>
 #include <pthread.h>
 
+struct osal_task_periodic;
+
 typedef struct osal_task {
     pthread_t tid;
+    struct osal_task_periodic *periodic;    //!< \brief State of periodic task, NULL otherwise.
+    osal_uint32_t started;                  //!< \brief Set to 1 by the new task, futex word of the start handshake.
 } osal_task_t;
 
 #endif /* LIBOSAL_POSIX_TASK__H */
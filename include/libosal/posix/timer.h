@@ -35,4 +35,15 @@
 #define LIBOSAL_CLOCK_MONOTONIC     CLOCK_MONOTONIC
 #define LIBOSAL_CLOCK_REALTIME      CLOCK_REALTIME
 
+//! \brief Invariant TSC, calibrated against LIBOSAL_CLOCK_MONOTONIC.
+/*!
+ * Only valid for \ref osal_timer_set_clock_source. Reads the time stamp 
+ * counter instead of calling clock_gettime and returns the same time base
+ * as LIBOSAL_CLOCK_MONOTONIC, which is used for all sleeps and waits. The
+ * conversion is re-synced with the monotonic clock every 100 ms by slewing
+ * its rate, so the TSC time stays continuous and does not drift. If the 
+ * cpu has no invariant TSC the monotonic clock is used instead.
+ */
+#define LIBOSAL_CLOCK_TSC           (0x7FFF)
+
 #endif /* LIBOSAL_POSIX_TIMER__H */
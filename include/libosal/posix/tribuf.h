@@ -0,0 +1,44 @@
+/**
+ * \file posix/tribuf.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL tribuf posix header.
+ *
+ * OSAL tribuf posix include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_TRIBUF__H
+#define LIBOSAL_POSIX_TRIBUF__H
+
+#include <libosal/shm.h>
+
+struct osal_tribuf_shm;
+
+typedef struct osal_tribuf {
+    osal_shm_t shm;                 //!< \brief Shared memory handle.
+    struct osal_tribuf_shm *buf;    //!< \brief Mapped triple buffer.
+} osal_tribuf_t;
+
+#endif /* LIBOSAL_POSIX_TRIBUF__H */
+
@@ -0,0 +1,177 @@
+/**
+ * \file rwlock.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL rwlock header.
+ *
+ * OSAL reader-writer lock include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_RWLOCK__H
+#define LIBOSAL_RWLOCK__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/timer.h>
+
+#ifdef LIBOSAL_BUILD_POSIX
+#include <libosal/posix/rwlock.h>
+#endif
+
+/** \defgroup rwlock_group Reader-writer lock
+ *
+ * Reader-writer locks allow any number of concurrent readers or a single 
+ * writer. They are meant for read-mostly data where readers would otherwise 
+ * serialize on a mutex they never contend for writes.
+ *
+ * @{
+ */
+
+#define OSAL_RWLOCK_ATTR__PROCESS_SHARED        0x00000020u     //!< \brief Process shared rwlock.
+#define OSAL_RWLOCK_ATTR__PREFER_WRITER         0x00000040u     //!< \brief Waiting writers block new readers.
+
+typedef osal_uint32_t osal_rwlock_attr_t;                       //!< \brief Rwlock attribute type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize a rwlock.
+/*!
+ * This function initializes a rwlock structure given by \p rw. If no attributes
+ * are given with \p attr a default rwlock is initialized, which prefers readers.
+ * With \ref OSAL_RWLOCK_ATTR__PREFER_WRITER a waiting writer blocks new readers, 
+ * so writers can't starve under continuous read load. Writers must not lock 
+ * recursively in that mode.
+ *
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to initial rwlock attributes. Can be NULL then
+ *                      the defaults of the underlying rwlock will be used.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Not enough system resources.
+ * \retval OSAL_ERR_OUT_OF_MEMORY           System is out of memory.
+ * \retval OSAL_ERR_PERMISSION_DENIED       Permission denied.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED         Writer preference is not supported by OS.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_init(osal_rwlock_t *rw, const osal_rwlock_attr_t *attr);
+
+//! \brief Lock a rwlock for reading.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Maximum number of readers exceeded.
+ * \retval OSAL_ERR_DEAD_LOCK               Calling task already holds the write lock.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_rdlock(osal_rwlock_t *rw);
+
+//! \brief Try to lock a rwlock for reading but don't block.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_BUSY                    Rwlock is held or requested by a writer.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Maximum number of readers exceeded.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_tryrdlock(osal_rwlock_t *rw);
+
+//! \brief Lock a rwlock for reading with timeout.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_TIMEOUT                 Rwlock could not be locked until \p to.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Maximum number of readers exceeded.
+ * \retval OSAL_ERR_DEAD_LOCK               Calling task already holds the write lock.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_timedrdlock(osal_rwlock_t *rw, const osal_timer_t *to);
+
+//! \brief Lock a rwlock for writing.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_DEAD_LOCK               Calling task already holds the rwlock.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_wrlock(osal_rwlock_t *rw);
+
+//! \brief Try to lock a rwlock for writing but don't block.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_BUSY                    Rwlock is held by readers or a writer.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_trywrlock(osal_rwlock_t *rw);
+
+//! \brief Lock a rwlock for writing with timeout.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_TIMEOUT                 Rwlock could not be locked until \p to.
+ * \retval OSAL_ERR_DEAD_LOCK               Calling task already holds the rwlock.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_timedwrlock(osal_rwlock_t *rw, const osal_timer_t *to);
+
+//! \brief Unlock a rwlock.
+/*!
+ * Releases a read or write lock held by the calling task.
+ *
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_PERMISSION_DENIED       Calling task does not hold the rwlock.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_unlock(osal_rwlock_t *rw);
+
+//! \brief Destroys a rwlock.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_BUSY                    Rwlock is still locked.
+ * \retval OSAL_ERR_INVALID_PARAM           Invalid input parameter.
+ */
+osal_retval_t osal_rwlock_destroy(osal_rwlock_t *rw);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_RWLOCK__H */
+
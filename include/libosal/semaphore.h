@@ -60,6 +60,7 @@
  */
 
 #define OSAL_SEMAPHORE_ATTR__PROCESS_SHARED         0x00000020u     //!< \brief Create a process shared semaphore.
+#define OSAL_SEMAPHORE_ATTR__POLLABLE               0x00000040u     //!< \brief Create a semaphore with a pollable file descriptor, not process shared.
 
 typedef osal_uint32_t osal_semaphore_attr_t;        //!< \brief Semaphore attribute type.
 
@@ -79,7 +80,8 @@ extern "C" {
  *
  * \retval OSAL_OK                      On success.
  * \retval OSAL_ERR_NOT_IMPLEMENTED     Shared was requested but there's not support from OS.
- * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter, e.g. \ref OSAL_SEMAPHORE_ATTR__POLLABLE
+ *                                      together with \ref OSAL_SEMAPHORE_ATTR__PROCESS_SHARED.
  */
 osal_retval_t osal_semaphore_init(osal_semaphore_t *sem, const osal_semaphore_attr_t *attr, osal_int32_t initval);
 
@@ -151,6 +153,22 @@ osal_retval_t osal_semaphore_timedwait(osal_semaphore_t *sem, const osal_timer_t
  */
 osal_retval_t osal_semaphore_destroy(osal_semaphore_t *sem);
 
+//! \brief Get pollable file descriptor of a semaphore.
+/*!
+ * The semaphore has to be initialized with \ref OSAL_SEMAPHORE_ATTR__POLLABLE. 
+ * The descriptor becomes readable while the counter is greater than 0 and 
+ * can be added to a \ref osal_waitset_t. Readiness does not consume the 
+ * semaphore, call \ref osal_semaphore_trywait afterwards. The descriptor 
+ * is local to the calling process and only inherited by fork.
+ *
+ * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Semaphore is not pollable.
+ */
+osal_retval_t osal_semaphore_get_fd(osal_semaphore_t *sem, osal_int32_t *fd);
+
 #ifdef __cplusplus
 };
 #endif
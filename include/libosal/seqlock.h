@@ -0,0 +1,171 @@
+/**
+ * \file seqlock.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL seqlock header.
+ *
+ * OSAL sequence lock include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_SEQLOCK__H
+#define LIBOSAL_SEQLOCK__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+
+#ifdef LIBOSAL_BUILD_POSIX
+#include <libosal/posix/seqlock.h>
+#endif
+
+/** \defgroup seqlock_group Sequence lock
+ *
+ * A sequence lock protects data with a single writer and any number of 
+ * readers. The writer never blocks, readers take a snapshot and retry 
+ * if the writer modified the data meanwhile. A low priority reader can 
+ * therefore never delay a realtime writer. Multiple writers have to be 
+ * serialized by the caller, e.g. with a \ref osal_mutex_t.
+ *
+ * The seqlock only consists of a counter without any pointers, so it can 
+ * be placed in memory returned by \ref osal_shm_map together with the 
+ * data it protects and be used between processes.
+ *
+ * @{
+ */
+
+#define OSAL_SEQLOCK_ATTR__PROCESS_SHARED       0x00000020u     //!< \brief Process shared seqlock.
+
+typedef osal_uint32_t osal_seqlock_attr_t;                      //!< \brief Seqlock attribute type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize a seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to initial seqlock attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_init(osal_seqlock_t *sl, const osal_seqlock_attr_t *attr);
+
+//! \brief Begin a write section.
+/*!
+ * Makes the sequence count odd, concurrent readers will retry.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_write_begin(osal_seqlock_t *sl);
+
+//! \brief End a write section.
+/*!
+ * Makes the sequence count even again and publishes the written data.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_write_end(osal_seqlock_t *sl);
+
+//! \brief Begin a read section.
+/*!
+ * Waits until no write section is active and returns the sequence count, 
+ * which has to be passed to \ref osal_seqlock_read_retry after reading 
+ * the data. Data read in between may be torn and must not be used before 
+ * \ref osal_seqlock_read_retry returned 0.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \return Sequence count at start of read section.
+ */
+osal_uint32_t osal_seqlock_read_begin(const osal_seqlock_t *sl);
+
+//! \brief Check if a read section has to be retried.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[in]   seq     Sequence count returned by \ref osal_seqlock_read_begin.
+ *
+ * \return 1 if the data was modified during the read section, 0 otherwise.
+ */
+osal_bool_t osal_seqlock_read_retry(const osal_seqlock_t *sl, osal_uint32_t seq);
+
+//! \brief Write data protected by seqlock.
+/*!
+ * Copies \p len bytes from \p src to \p dst inside a write section.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Protected data, e.g. in shared memory.
+ * \param[in]   src     New data.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_write(osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len);
+
+//! \brief Read consistent snapshot of data protected by seqlock.
+/*!
+ * Copies \p len bytes from \p src to \p dst and retries until the copy 
+ * was not modified by a writer.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Snapshot buffer.
+ * \param[in]   src     Protected data, e.g. in shared memory.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_read(const osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len);
+
+//! \brief Try to read consistent snapshot of data protected by seqlock.
+/*!
+ * Like \ref osal_seqlock_read but makes only a single attempt.
+ *
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Snapshot buffer, content is undefined on error.
+ * \param[in]   src     Protected data, e.g. in shared memory.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_BUSY                A writer was active, \p dst may be torn.
+ */
+osal_retval_t osal_seqlock_tryread(const osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len);
+
+//! \brief Destroys a seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_seqlock_destroy(osal_seqlock_t *sl);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_SEQLOCK__H */
+
@@ -56,15 +56,32 @@
  * waiting on a spinlock does an active/busy-wait and costs CPU-time, but does not have the 
  * side-effects of the OS-scheduler.
  *
+ * Robust and process shared spinlocks store the system wide task id of
+ * their owner in the lock word. They detect relocking by the owner and 
+ * unlocking by another task, and a robust spinlock detects an owner 
+ * which has died while holding the lock. The next locker then takes over
+ * and gets \ref OSAL_ERR_OWNER_DEAD, the data protected by the lock may 
+ * be inconsistent.
+ *
+ * The default spinlock is unfair and all waiters spin on the same cache 
+ * line. Under contention \ref OSAL_SPINLOCK_ATTR__TYPE__TICKET hands the 
+ * lock over in FIFO order. \ref OSAL_SPINLOCK_ATTR__TYPE__MCS queues the 
+ * waiters as well, but each waiter spins on its own cache line, so a 
+ * hand-off only touches the next waiter. A task may hold or wait for up 
+ * to 8 MCS spinlocks at once. Ticket spinlocks can be process shared, 
+ * neither of them can be robust.
+ *
  * @{
  */
 
-#define OSAL_SPINLOCK_ATTR__TYPE__MASK             0x00000003u      //!< \brief Spinlock type mask.
+#define OSAL_SPINLOCK_ATTR__TYPE__MASK             0x00000007u      //!< \brief Spinlock type mask.
 #define OSAL_SPINLOCK_ATTR__TYPE__NORMAL           0x00000000u      //!< \brief Spinlock normal/default type.
 #define OSAL_SPINLOCK_ATTR__TYPE__ERRORCHECK       0x00000001u      //!< \brief Spinlock error-checking type.
 #define OSAL_SPINLOCK_ATTR__TYPE__RECURSIVE        0x00000002u      //!< \brief Spinlock recursive type.
+#define OSAL_SPINLOCK_ATTR__TYPE__TICKET           0x00000003u      //!< \brief Spinlock FIFO ticket type.
+#define OSAL_SPINLOCK_ATTR__TYPE__MCS              0x00000004u      //!< \brief Spinlock FIFO queue type, waiters spin locally.
 
-#define OSAL_SPINLOCK_ATTR__ROBUST                 0x00000010u      //!< \brief Robust spinlock (unlocks if owner died).
+#define OSAL_SPINLOCK_ATTR__ROBUST                 0x00000010u      //!< \brief Robust spinlock (taken over if owner died).
 #define OSAL_SPINLOCK_ATTR__PROCESS_SHARED         0x00000020u      //!< \brief Process shared spinlock.
 
 #define OSAL_SPINLOCK_ATTR__PROTOCOL__MASK         0x00000300u      //!< \brief Spinlock protocol mask.
@@ -110,8 +127,8 @@ osal_retval_t osal_spinlock_init(osal_spinlock_t *mtx, const osal_spinlock_attr_
  * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    Not enough system resources.
  * \retval OSAL_ERR_INVALID_PARAM           Invalid input paratemer.
  * \retval OSAL_ERR_NOT_RECOVERABLE         Mutex not recoverable.
- * \retval OSAL_ERR_OWNER_DEAD              Old mutex owner dead (see ROBUST).
- * \retval OSAL_ERR_DEAD_LOCK               Would dead-lock (see RECURSIVE).
+ * \retval OSAL_ERR_OWNER_DEAD              Old owner dead, lock was taken over (see ROBUST).
+ * \retval OSAL_ERR_DEAD_LOCK               Already locked by calling task.
  * \retval OSAL_ERR_UNAVAILABLE             Other errors.
  */
 osal_retval_t osal_spinlock_lock(osal_spinlock_t *mtx);
@@ -135,7 +152,7 @@ osal_retval_t osal_spinlock_unlock(osal_spinlock_t *mtx);
  * \param[in]   mtx     Pointer to osal spinlock structure. Content is OS dependent.
  *
  * \retval OSAL_OK                          On success.
- * \retval OSAL_ERR_OPERATION_FAILED        Other errors.
+ * \retval OSAL_ERR_OPERATION_FAILED        Spinlock still locked or other errors.
  */
 osal_retval_t osal_spinlock_destroy(osal_spinlock_t *mtx);
 
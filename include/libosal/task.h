@@ -81,6 +81,23 @@ typedef void * osal_task_retval_t;                      //!< \brief Task handler
 
 typedef osal_uint32_t osal_task_state_t;                //!< \brief Task state type.
 
+//! \brief Periodic task handler function template.
+/*!
+ * Called once per period, returning anything but \ref OSAL_OK ends the task.
+ */
+typedef osal_retval_t (*osal_task_periodic_handler_t)(void *arg);
+
+struct osal_trace;
+
+//! \brief Cycle statistics of a periodic task.
+typedef struct osal_task_periodic_stats {
+    osal_uint64_t cycles;               //!< \brief Number of handler calls.
+    osal_uint64_t overruns;             //!< \brief Number of releases missed because the handler did not finish in time.
+    osal_uint64_t max_latency;          //!< \brief Maximum delay from release to handler call in [ns].
+    osal_uint64_t max_exec;             //!< \brief Maximum handler execution time in [ns].
+    struct osal_trace *trace;           //!< \brief Trace of handler call times on LIBOSAL_CLOCK_MONOTONIC.
+} osal_task_periodic_stats_t;           //!< \brief Periodic task statistics type.
+
 #define OSAL_STATE_THREAD_UNKNOWN_ID    (0u)            //!< \brief The thread has an unknown ID
 #define OSAL_STATE_THREAD_ACTIVE        (1u)            //!< \brief The thread is in an active state
 #define OSAL_STATE_THREAD_INACTIVE      (2u)            //!< \brief The thread is in an inactive state
@@ -107,6 +124,52 @@ extern "C" {
 osal_retval_t osal_task_create(osal_task_t *hdl, const osal_task_attr_t *attr, 
         osal_task_handler_t handler, osal_task_handler_arg_t arg);
 
+//! \brief Create a periodic task.
+/*!
+ * Creates a task which calls \p handler at absolute release times 
+ * k * \p period_ns + \p offset_ns on LIBOSAL_CLOCK_MONOTONIC, so tasks with 
+ * related periods keep a fixed phase to each other and releases do not 
+ * drift. If a handler call does not finish before the next release, the 
+ * missed releases are counted as overruns and the task continues with the 
+ * next release in the future.
+ *
+ * The task ends when \p handler returns anything but \ref OSAL_OK. 
+ * Statistics are available with \ref osal_task_get_periodic_stats until
+ * the task is joined.
+ *
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ * \param[in]   attr        Pointer to initial task attributes. Can be NULL then
+ *                          the defaults of the underlying task will be used.
+ * \param[in]   period_ns   Period in [ns].
+ * \param[in]   offset_ns   Release offset within period in [ns].
+ * \param[in]   handler     Handler to be called each period.
+ * \param[in]   arg         Pointer to argument passed to handler.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Period is 0 or offset not less than period.
+ * \retval OSAL_ERR_OUT_OF_MEMORY           Statistics could not be allocated.
+ * \retval OSAL_ERR_SYSTEM_LIMIT_REACHED    System is out of resources.
+ * \retval OSAL_ERR_PERMISSION_DENIED       Permission denied for priority/policy.
+ * \retval OSAL_ERR_OPERATION_FAILED        Other errors.
+ */
+osal_retval_t osal_task_create_periodic(osal_task_t *hdl, const osal_task_attr_t *attr, 
+        osal_uint64_t period_ns, osal_uint64_t offset_ns, 
+        osal_task_periodic_handler_t handler, osal_task_handler_arg_t arg);
+
+//! \brief Get cycle statistics of a periodic task.
+/*!
+ * The trace records the time of every handler call, \ref osal_trace_analyze
+ * on it returns the average cycle time and its jitter once the trace 
+ * buffer was filled.
+ *
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  stats   Returns current statistics.
+ *
+ * \retval OSAL_OK                          On success.
+ * \retval OSAL_ERR_INVALID_PARAM           Task is not periodic.
+ */
+osal_retval_t osal_task_get_periodic_stats(osal_task_t *hdl, osal_task_periodic_stats_t *stats);
+
 //! \brief Joins a task.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
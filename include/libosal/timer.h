@@ -50,17 +50,58 @@
 //! Specifies the amount of how much nanoseconds a second contains of.
 #define NSEC_PER_SEC                1000000000
 
+//! Tag marking the clock of a timer as set, see \ref osal_timer_t.
+#define OSAL_TIMER_CLOCK_TAG        0x4F540000
+//! Bits of the clock id in a tagged clock.
+#define OSAL_TIMER_CLOCK_MASK       0x0000FFFF
+
+#ifndef LIBOSAL_CLOCK_REALTIME
+#define LIBOSAL_CLOCK_REALTIME      0       //!< \brief Clock of untagged timers.
+#endif
+
 //! timer structure
+/*!
+ * An absolute time on the clock stored in \p clock_tag. Timers filled by
+ * \ref osal_timer_gettime or \ref osal_timer_init refer to the configured
+ * clock source.
+ *
+ * The clock is stored as OSAL_TIMER_CLOCK_TAG | clock id, so an 
+ * uninitialized \p clock_tag never selects a valid clock by chance. Timers
+ * without the tag, like zero initialized ones or timers built by hand from 
+ * \p sec and \p nsec only, refer to CLOCK_REALTIME as before the clock was 
+ * part of the timer. Use \ref osal_timer_clock and \ref osal_timer_set_clock
+ * to access the clock.
+ */
 typedef struct osal_timer {
     osal_uint64_t sec;       //!< seconds
     osal_uint64_t nsec;      //!< nanoseconds
+    int clock_tag;           //!< tagged clock the time refers to
 } osal_timer_t;
 
+//! Tagged clock value of clock \p clk.
+#define OSAL_TIMER_CLOCK(clk)   (OSAL_TIMER_CLOCK_TAG | ((clk) & OSAL_TIMER_CLOCK_MASK))
+
+//! Returns clock id of timer \p timer, CLOCK_REALTIME if its clock is not tagged.
+#define osal_timer_clock(timer)                                     \
+    ((((timer)->clock_tag & ~OSAL_TIMER_CLOCK_MASK) == OSAL_TIMER_CLOCK_TAG) ? \
+     ((timer)->clock_tag & OSAL_TIMER_CLOCK_MASK) : LIBOSAL_CLOCK_REALTIME)
+
+//! Sets clock of timer \p timer to clock id \p clk.
+#define osal_timer_set_clock(timer, clk)                            \
+    ((timer)->clock_tag = OSAL_TIMER_CLOCK(clk))
+
+//! Initializer of a timer on CLOCK_REALTIME.
+#define OSAL_TIMER_INITIALIZER                  { 0u, 0u, 0 }
+
+//! Initializer of a timer on clock \p clk like LIBOSAL_CLOCK_MONOTONIC.
+#define OSAL_TIMER_INITIALIZER_CLOCK(clk)       { 0u, 0u, OSAL_TIMER_CLOCK(clk) }
+
 //! Adding two timer structs and return as result.
 #define osal_timer_add(a, b, result)                                \
     do {                                                            \
         (result)->sec = (a)->sec + (b)->sec;                        \
         (result)->nsec = (a)->nsec + (b)->nsec;                     \
+        (result)->clock_tag = (a)->clock_tag;                         \
         if ((result)->nsec >= 1E9)                                  \
         {                                                           \
             ++(result)->sec;                                        \
@@ -73,6 +114,7 @@ typedef struct osal_timer {
     do {                                                            \
         (result)->sec = (a)->sec;                                   \
         (result)->nsec = (a)->nsec + (n);                           \
+        (result)->clock_tag = (a)->clock_tag;                         \
         if ((result)->nsec >= 1E9)                                  \
         {                                                           \
             ++(result)->sec;                                        \
@@ -103,8 +145,8 @@ void osal_sleep(osal_uint64_t nsec);
 
 //! Sleep until timer expired
 /*!
- * This function sleeps until \p timer is expired. It may fail in some
- * cases and return an error value.
+ * This function sleeps until \p timer is expired on the clock of 
+ * \p timer. It may fail in some cases and return an error value.
  *
  * \param[in]   timer   Pointer to timer struct with absolute end time.
  *
@@ -140,8 +182,29 @@ osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec);
  */
 osal_retval_t osal_busy_wait_until_nsec(osal_uint64_t nsec);
 
+//! Sleep until timer expired, then busy-wait for the remaining time
+/*!
+ * This function sleeps until a safety margin before \p timer and 
+ * busy-waits for the rest, which gives a far lower wakeup jitter than
+ * \ref osal_sleep_until while only spinning for a short time. The 
+ * margin is learned per task from the observed sleep wakeup latency, it
+ * grows immediately after a late wakeup and decays slowly otherwise.
+ * \param[in]   timer   Pointer to timer struct with absolute end time.
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid timer value.
+ * \retval OSAL_ERR_OPERATION_FAILED    Any other error.
+ */
+osal_retval_t osal_sleep_until_precise(osal_timer_t *timer);
+
 //! Globally sets the internal clock source used by the timer functions.
 /*!
+ * The clock source defaults to LIBOSAL_CLOCK_MONOTONIC. It is used by
+ * timers initialized from now on, timers carry their clock with them.
+ *
+ * LIBOSAL_CLOCK_TSC, where available, reads the invariant time stamp
+ * counter in \ref osal_timer_gettime and \ref osal_timer_gettime_nsec 
+ * and uses the monotonic clock for everything else. Selecting it finishes
+ * the calibration started in \ref osal_init and may sleep for up to 10 ms.
  *
  * \param[in] clock_id    Clock id of the clock source according to the <time.h>
  *                        header of your plattform like CLOKC_REALTIME.
@@ -151,7 +214,8 @@ void osal_timer_set_clock_source(int clock_id);
 //! Returns the internal clock source used by the timer functions.
 /*!
  *
- * \return  Currently configured clock id of the clock source.
+ * \return  Currently configured clock id of the clock source, the monotonic
+ *          clock if LIBOSAL_CLOCK_TSC was selected.
  */
 int osal_timer_get_clock_source();
 
@@ -187,10 +251,25 @@ osal_uint64_t osal_timer_gettime_nsec(void);
  */
 void osal_timer_init(osal_timer_t *timer, osal_uint64_t timeout);
 
+//! Initialize timer on a given clock with timeout.
+/*!
+ * Like \ref osal_timer_init, but independent of the configured clock
+ * source.
+ *
+ * \param[out] timer    Pointer to timer struct which will be initialized
+ *                      with current time of \p clock_id plus \p timeout.
+ * \param[in] clock_id  Clock id like LIBOSAL_CLOCK_MONOTONIC.
+ * \param[in] timeout   Timeout in nanoseconds.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Invalid \p clock_id.
+ */
+osal_retval_t osal_timer_init_clock(osal_timer_t *timer, int clock_id, osal_uint64_t timeout);
+
 //! Checks if timer is expired.
 /*!
- * This function checks against current system time if \p timer
- * is expired or not.
+ * This function checks against current time of the clock of \p timer
+ * if it is expired or not.
  *
  * \param[out] timer    Timer to check if it is expired.
  *
@@ -0,0 +1,202 @@
+/**
+ * \file timerwheel.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL timer wheel header.
+ *
+ * OSAL timer wheel include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_TIMERWHEEL__H
+#define LIBOSAL_TIMERWHEEL__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/mutex.h>
+#include <libosal/task.h>
+
+/** \defgroup timerwheel_group Timer wheel
+ *
+ * A hierarchical timer wheel calls one-shot and periodic software timers
+ * with a resolution of one tick. Arming and cancelling a timer is O(1)
+ * and does not allocate memory, the timer structures are owned by the
+ * caller. Each level of the wheel has \ref OSAL_TIMERWHEEL_SLOTS slots of
+ * 64 times the length of the level below, timers far in the future are
+ * moved down a level when their slot comes up.
+ *
+ * The wheel is either driven by a dedicated task started with
+ * \ref osal_timerwheel_start or by calling \ref osal_timerwheel_process
+ * from an existing cyclic loop, but never by both. Timer handlers run
+ * in that context without the wheel lock held, so they may arm and
+ * cancel timers themselves.
+ *
+ * @{
+ */
+
+#define OSAL_TIMERWHEEL_LEVEL_BITS      6u                                  //!< \brief Bits of tick per level.
+#define OSAL_TIMERWHEEL_SLOTS           (1u << OSAL_TIMERWHEEL_LEVEL_BITS)  //!< \brief Slots per level.
+#define OSAL_TIMERWHEEL_LEVELS          6u                                  //!< \brief Number of levels, 2^36 ticks range.
+
+//! \brief Timer handler function template.
+typedef osal_void_t (*osal_timerwheel_handler_t)(osal_void_t *arg);
+
+//! \brief Intrusive list node.
+typedef struct osal_timerwheel_node {
+    struct osal_timerwheel_node *next;  //!< \brief Next node, NULL if not linked.
+    struct osal_timerwheel_node *prev;  //!< \brief Previous node.
+} osal_timerwheel_node_t;
+
+//! \brief Timer structure, owned by the caller.
+typedef struct osal_timerwheel_timer {
+    osal_timerwheel_node_t node;        //!< \brief Slot list node, has to be first.
+    osal_uint64_t expiry;               //!< \brief Expiry tick.
+    osal_uint64_t period;               //!< \brief Period in ticks, 0 for one-shot timers.
+    osal_timerwheel_handler_t handler;  //!< \brief Handler called on expiry.
+    osal_void_t *arg;                   //!< \brief Argument passed to handler.
+} osal_timerwheel_timer_t;
+
+//! \brief Timer wheel structure.
+typedef struct osal_timerwheel {
+    osal_mutex_t mtx;                   //!< \brief Protects slots and timers.
+    osal_uint64_t tick_ns;              //!< \brief Length of a tick in [ns].
+    osal_uint64_t start_ns;             //!< \brief Time of tick 0 in [ns].
+    osal_uint64_t next_tick;            //!< \brief Next tick to be processed.
+    osal_size_t armed;                  //!< \brief Number of armed timers.
+    osal_timerwheel_node_t expired;     //!< \brief Timers due at or before the next processed tick.
+    osal_timerwheel_node_t slots[OSAL_TIMERWHEEL_LEVELS][OSAL_TIMERWHEEL_SLOTS];    //!< \brief Slot lists.
+    osal_task_t task;                   //!< \brief Dedicated task if started.
+    int running;                        //!< \brief Dedicated task is running.
+} osal_timerwheel_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize a timer wheel.
+/*!
+ * Tick 0 is the time of initialization on the configured clock source.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ * \param[in]   tick_ns Length of a tick in [ns], the resolution of all timers.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   \p tick_ns is 0.
+ */
+osal_retval_t osal_timerwheel_init(osal_timerwheel_t *tw, osal_uint64_t tick_ns);
+
+//! \brief Destroy a timer wheel.
+/*!
+ * Stops the dedicated task if it was started. Timers still armed are
+ * dropped without calling them.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timerwheel_destroy(osal_timerwheel_t *tw);
+
+//! \brief Start a dedicated task driving the timer wheel.
+/*!
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ * \param[in]   attr    Pointer to task attributes. Can be NULL.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_BUSY            Task is already running.
+ * \return Errors of \ref osal_task_create otherwise.
+ */
+osal_retval_t osal_timerwheel_start(osal_timerwheel_t *tw, const osal_task_attr_t *attr);
+
+//! \brief Stop the dedicated task.
+/*!
+ * Returns after the task finished its current tick.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ *
+ * \retval OSAL_OK              On success.
+ * \retval OSAL_ERR_NOT_FOUND   Task was not started.
+ */
+osal_retval_t osal_timerwheel_stop(osal_timerwheel_t *tw);
+
+//! \brief Process all ticks up to the current time.
+/*!
+ * Calls the handlers of all timers which expired since the last call.
+ * Use this to drive the wheel from an existing cyclic loop instead of
+ * starting a dedicated task.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timerwheel_process(osal_timerwheel_t *tw);
+
+//! \brief Initialize a timer.
+/*!
+ * Has to be called once before a timer is armed or cancelled.
+ *
+ * \param[in]   tmr     Pointer to timer structure.
+ * \param[in]   handler Handler called on expiry.
+ * \param[in]   arg     Argument passed to \p handler.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timerwheel_timer_init(osal_timerwheel_timer_t *tmr,
+        osal_timerwheel_handler_t handler, osal_void_t *arg);
+
+//! \brief Arm a timer.
+/*!
+ * The timer expires in the first tick after \p delay_ns passed and then
+ * every \p period_ns, rounded up to whole ticks. Periodic timers keep
+ * their phase, periods missed while the wheel was not processed are
+ * skipped. A timer which is already armed is re-armed.
+ *
+ * \param[in]   tw          Pointer to osal timer wheel structure.
+ * \param[in]   tmr         Pointer to initialized timer structure.
+ * \param[in]   delay_ns    Delay until first expiry in [ns].
+ * \param[in]   period_ns   Period in [ns], 0 for a one-shot timer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_timerwheel_arm(osal_timerwheel_t *tw, osal_timerwheel_timer_t *tmr,
+        osal_uint64_t delay_ns, osal_uint64_t period_ns);
+
+//! \brief Cancel a timer.
+/*!
+ * A handler which is already running is not waited for.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure.
+ * \param[in]   tmr     Pointer to initialized timer structure.
+ *
+ * \retval OSAL_OK              Timer was armed and is cancelled.
+ * \retval OSAL_ERR_NOT_FOUND   Timer was not armed.
+ */
+osal_retval_t osal_timerwheel_cancel(osal_timerwheel_t *tw, osal_timerwheel_timer_t *tmr);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_TIMERWHEEL__H */
+
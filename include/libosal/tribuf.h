@@ -0,0 +1,181 @@
+/**
+ * \file tribuf.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL tribuf header.
+ *
+ * OSAL triple buffer include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_TRIBUF__H
+#define LIBOSAL_TRIBUF__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/timer.h>
+
+#ifdef LIBOSAL_BUILD_POSIX
+#include <libosal/posix/tribuf.h>
+#endif
+
+/** \defgroup tribuf_group Triple buffer
+ *
+ * A triple buffer passes the latest sample from one producer to one 
+ * consumer through shared memory. The producer always owns a back buffer 
+ * to write to and the consumer always owns a front buffer to read from. 
+ * Both swap their buffer with a shared middle buffer by a single atomic 
+ * exchange, so \ref osal_tribuf_publish and \ref osal_tribuf_acquire_latest 
+ * are wait-free and a slow consumer can never stall the producer. Samples 
+ * the consumer did not pick up in time are overwritten.
+ *
+ * The buffer ownership is kept in shared memory, so producer and consumer
+ * may be different processes attaching by name. There must only be one 
+ * producer and one consumer at a time.
+ *
+ * @{
+ */
+
+#define OSAL_TRIBUF_ATTR__FLAG__CREAT           0x00000004u     //!< \brief Create shared memory if it does not exist.
+#define OSAL_TRIBUF_ATTR__FLAG__EXCL            0x00000008u     //!< \brief Fail if shared memory already exists.
+
+#define OSAL_TRIBUF_ATTR__MODE__MASK            0xFFFF0000u     //!< \brief Shared memory mode mask.
+#define OSAL_TRIBUF_ATTR__MODE__SHIFT           16u             //!< \brief Shared memory mode shift bits.
+
+typedef osal_uint32_t osal_tribuf_attr_t;                       //!< \brief Triple buffer attribute type.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Create or attach a triple buffer.
+/*!
+ * Opens the shared memory \p name and initializes the triple buffer if 
+ * it was not initialized yet. With \ref OSAL_TRIBUF_ATTR__FLAG__CREAT the 
+ * shared memory is created with permissions from \ref OSAL_TRIBUF_ATTR__MODE__MASK.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Pointer to triple buffer attributes. Can be NULL.
+ * \param[in]   size    Size of a sample in bytes. Ignored if already initialized.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           Shared memory does not exist.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter or shared memory is no triple buffer.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Permission denied.
+ */
+osal_retval_t osal_tribuf_create(osal_tribuf_t *tb, const osal_char_t *name, 
+        const osal_tribuf_attr_t *attr, osal_size_t size);
+
+//! \brief Attach to an existing triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           Shared memory does not exist.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter or shared memory is no triple buffer.
+ * \retval OSAL_ERR_PERMISSION_DENIED   Permission denied.
+ */
+osal_retval_t osal_tribuf_attach(osal_tribuf_t *tb, const osal_char_t *name);
+
+//! \brief Get sample size of a triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  size    Returns size of a sample in bytes.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_tribuf_get_size(osal_tribuf_t *tb, osal_size_t *size);
+
+//! \brief Get the producers back buffer.
+/*!
+ * The producer writes the next sample in place, the buffer changes with
+ * every call to \ref osal_tribuf_publish.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to back buffer.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_tribuf_get_write_buffer(osal_tribuf_t *tb, osal_void_t **ptr);
+
+//! \brief Publish the back buffer as latest sample.
+/*!
+ * Swaps the back buffer with the middle buffer and wakes a consumer 
+ * waiting in \ref osal_tribuf_wait. A sample which was not acquired yet
+ * is dropped. This call is wait-free.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                      On success.
+ */
+osal_retval_t osal_tribuf_publish(osal_tribuf_t *tb);
+
+//! \brief Acquire the latest published sample.
+/*!
+ * Swaps the front buffer with the middle buffer if a new sample was 
+ * published. The returned buffer stays valid and unchanged until the next 
+ * call. This call is wait-free.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to front buffer holding the latest sample.
+ *
+ * \retval OSAL_OK                      A new sample was acquired.
+ * \retval OSAL_ERR_NO_DATA             Nothing was published since the last call, 
+ *                                      \p ptr returns the previous sample.
+ */
+osal_retval_t osal_tribuf_acquire_latest(osal_tribuf_t *tb, const osal_void_t **ptr);
+
+//! \brief Wait for a new sample.
+/*!
+ * Blocks until a sample was published which was not acquired yet. Uses a 
+ * futex if available, polls otherwise.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \retval OSAL_OK                      A new sample is available.
+ * \retval OSAL_ERR_TIMEOUT             No sample was published until \p to.
+ * \retval OSAL_ERR_INVALID_PARAM       Clock of \p to is invalid.
+ */
+osal_retval_t osal_tribuf_wait(osal_tribuf_t *tb, const osal_timer_t *to);
+
+//! \brief Detach from a triple buffer.
+/*!
+ * Unmaps the shared memory, the shared memory name is not removed.
+ *
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_close(osal_tribuf_t *tb);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_TRIBUF__H */
+
@@ -0,0 +1,122 @@
+/**
+ * \file waitset.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL waitset header.
+ *
+ * OSAL waitset include header.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_WAITSET__H
+#define LIBOSAL_WAITSET__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/timer.h>
+
+#ifdef LIBOSAL_BUILD_POSIX
+#include <libosal/posix/waitset.h>
+#endif
+
+/** \defgroup waitset_group Waitset
+ *
+ * A waitset blocks on several pollable osal objects at once with a single 
+ * timeout. Objects are added by their pollable file descriptor, see 
+ * \ref osal_semaphore_get_fd, \ref osal_binary_semaphore_get_fd and 
+ * \ref osal_mq_get_fd. A waitset only reports readiness, the caller 
+ * consumes the object afterwards with the non-blocking call of the object 
+ * (e.g. \ref osal_semaphore_trywait) because another task may have been faster.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! \brief Initialize a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_IMPLEMENTED     Waitsets are not supported by OS.
+ * \retval OSAL_ERR_OPERATION_FAILED    Could not allocate waitset.
+ */
+osal_retval_t osal_waitset_init(osal_waitset_t *ws);
+
+//! \brief Add a pollable file descriptor to a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[in]   fd      Pollable file descriptor of an osal object.
+ * \param[in]   id      User defined id returned by \ref osal_waitset_wait if \p fd is ready.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid or already added \p fd.
+ * \retval OSAL_ERR_OPERATION_FAILED    Other error occured.
+ */
+osal_retval_t osal_waitset_add(osal_waitset_t *ws, osal_int32_t fd, osal_uint32_t id);
+
+//! \brief Remove a pollable file descriptor from a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[in]   fd      Pollable file descriptor previously added.
+ *
+ * \retval OSAL_OK                      On success.
+ * \retval OSAL_ERR_NOT_FOUND           \p fd is not part of waitset.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid \p fd.
+ */
+osal_retval_t osal_waitset_remove(osal_waitset_t *ws, osal_int32_t fd);
+
+//! \brief Wait for any object of a waitset to become ready.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[out]  ids     Returns ids of ready objects.
+ * \param[in]   max_ids Maximum number of ids to return.
+ * \param[out]  cnt     Returns number of ready objects stored in \p ids.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \retval OSAL_OK                      On success, at least one object is ready.
+ * \retval OSAL_ERR_TIMEOUT             No object became ready until \p to.
+ * \retval OSAL_ERR_INTERRUPTED         Call was interrupted by a signal during wait.
+ * \retval OSAL_ERR_INVALID_PARAM       Invalid input parameter.
+ */
+osal_retval_t osal_waitset_wait(osal_waitset_t *ws, osal_uint32_t *ids, osal_size_t max_ids, 
+        osal_size_t *cnt, const osal_timer_t *to);
+
+//! \brief Destroys a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_destroy(osal_waitset_t *ws);
+
+#ifdef __cplusplus
+};
+#endif
+
+/** @} */
+
+#endif /* LIBOSAL_WAITSET__H */
+
@@ -33,10 +33,11 @@
 #include <libosal/osal.h>
 #include <libosal/io.h>
 #include <libosal/shm.h>
-#include <libosal/mutex.h>
 #include <libosal/semaphore.h>
+#include <libosal/timer.h>
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #include <assert.h>
         
@@ -44,102 +45,1762 @@
 #include <string.h>
 #include <stdio.h>
 
-#define LIBOSAL_IO_SHM_MAGIC        0x00AFFE00
+#ifdef LIBOSAL_BUILD_POSIX
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+#include "posix/futex.h"
+#endif
+
+#define LIBOSAL_IO_SHM_MAGIC        0x00AFFE07
+#define LIBOSAL_IO_SHM_CACHE_LINE   64u
+#define LIBOSAL_IO_SHM_MAX_RINGS    (LIBOSAL_IO_SHM_MAX_TASK_RINGS + 1u)
+#define LIBOSAL_IO_SHM_POLL_NSEC    100000u //!< \brief Poll interval of blocking writers without futex.
+
+#define LIBOSAL_IO_SHM_REC_TEXT     0u      //!< \brief Record holds formatted text.
+#define LIBOSAL_IO_SHM_REC_BINARY   1u      //!< \brief Record holds format id and raw arguments.
+
+#define LIBOSAL_IO_SHM_STATE_PUBLISHED    1u  //!< \brief Record is published by its writer.
+#define LIBOSAL_IO_SHM_STATE_RELEASED     2u  //!< \brief Record is consumed and may be freed.
+#define LIBOSAL_IO_SHM_STATE_PAD          4u  //!< \brief Record pads the ring up to its end.
+
+#define LIBOSAL_IO_FMT_MAX_ARGS     16u     //!< \brief Maximum arguments of a binary message.
+#define LIBOSAL_IO_FMT_MAX_SPEC     32u     //!< \brief Maximum length of a conversion specification.
+#define LIBOSAL_IO_FMT_CACHE_SIZE   1024u   //!< \brief Number of format strings cached per process.
+#define LIBOSAL_IO_FMT_CACHE_PROBES 8u      //!< \brief Maximum probes on format cache lookup.
+#define LIBOSAL_IO_TAG_CACHE_SIZE   256u    //!< \brief Number of tags cached per process.
+
+#define LIBOSAL_IO_FMT_ARG_NONE         0u  //!< \brief No argument, e.g. '%%'.
+#define LIBOSAL_IO_FMT_ARG_INT          1u  //!< \brief int (also char, short and '*').
+#define LIBOSAL_IO_FMT_ARG_LONG         2u  //!< \brief long.
+#define LIBOSAL_IO_FMT_ARG_LLONG        3u  //!< \brief long long.
+#define LIBOSAL_IO_FMT_ARG_SIZE         4u  //!< \brief size_t.
+#define LIBOSAL_IO_FMT_ARG_INTMAX       5u  //!< \brief intmax_t.
+#define LIBOSAL_IO_FMT_ARG_PTRDIFF      6u  //!< \brief ptrdiff_t.
+#define LIBOSAL_IO_FMT_ARG_DOUBLE       7u  //!< \brief double.
+#define LIBOSAL_IO_FMT_ARG_PTR          8u  //!< \brief void pointer.
+#define LIBOSAL_IO_FMT_ARG_STR          9u  //!< \brief String, copied into the message.
+#define LIBOSAL_IO_FMT_ARG_UNSUPPORTED  10u //!< \brief Needs formatting by the writer.
+
+#define LIBOSAL_IO_FMT_PREC_NONE        (-1) //!< \brief No precision given.
+#define LIBOSAL_IO_FMT_PREC_STAR        (-2) //!< \brief Precision is the preceding '*' argument.
+
+#define LIBOSAL_IO_FMT_STATE_FREE       0u  //!< \brief Cache entry not registered in this generation.
+#define LIBOSAL_IO_FMT_STATE_BUSY       1u  //!< \brief Cache entry is being registered.
+#define LIBOSAL_IO_FMT_STATE_BINARY     2u  //!< \brief Format may be logged in binary.
+#define LIBOSAL_IO_FMT_STATE_TEXT       3u  //!< \brief Format has to be formatted by the writer.
+#define LIBOSAL_IO_FMT_STATE_MASK       3u
+#define LIBOSAL_IO_FMT_STATE_SHIFT      2u
+
+// tag cache entries share FREE, BUSY and the generation shift with format entries
+#define LIBOSAL_IO_TAG_STATE_REGISTERED 2u  //!< \brief Tag is registered.
+#define LIBOSAL_IO_TAG_STATE_FAILED     3u  //!< \brief Tag could not be registered.
+
+//! \brief Shared memory message record.
+/*!
+ * Records of variable length are stored back to back in a ring, each aligned
+ * to 8 bytes. A record never wraps, if it does not fit in front of the end of
+ * the ring the writer fills the rest with a pad record which only consists
+ * of the state word. It holds the ring position of the record and its state. 
+ * Freed records are zeroed, so stale data never looks like a published record.
+ */
+typedef struct osal_io_shm_rec {
+    osal_uint64_t       state;              //!< Ring position and LIBOSAL_IO_SHM_STATE_*.
+    osal_uint64_t       timestamp;          //!< Time of message in [ns].
+    osal_uint32_t       tid;                //!< Task id of writer.
+    osal_uint32_t       tag;                //!< Offset of tag in format table + 1, 0 if none.
+    osal_uint16_t       type;               //!< Record type, LIBOSAL_IO_SHM_REC_*.
+    osal_uint16_t       level;              //!< Log level, OSAL_IO_LOG_LEVEL__*.
+    osal_uint32_t       len;                //!< Record length in bytes.
+    osal_char_t         msg[0];             //!< Message text or binary record.
+} osal_io_shm_rec_t;
+
+//! \brief Binary message record.
+/*!
+ * Arguments are stored as raw 64-bit words in the order they were passed. 
+ * Strings are stored zero-terminated after the argument words, the
+ * corresponding word holds the string length.
+ */
+typedef struct osal_io_shm_bin {
+    osal_uint32_t       fmt_id;             //!< Offset of format string in format table.
+    osal_uint32_t       nargs;              //!< Number of argument words.
+    osal_uint64_t       args[0];            //!< Argument words.
+} osal_io_shm_bin_t;
+
+//! \brief Format table entry.
+typedef struct osal_io_shm_fmt {
+    osal_uint32_t       len;                //!< Length of format including terminating zero.
+    osal_char_t         fmt[0];             //!< Format string.
+} osal_io_shm_fmt_t;
+
+//! \brief Parsed conversion specification.
+typedef struct osal_io_fmt_spec {
+    const osal_char_t  *start;              //!< Pointer to '%'.
+    osal_size_t         len;                //!< Length of conversion specification.
+    osal_uint32_t       stars;              //!< Number of '*' width/precision arguments.
+    osal_uint32_t       kind;               //!< Argument type, LIBOSAL_IO_FMT_ARG_*.
+    osal_int32_t        prec;               //!< Precision or LIBOSAL_IO_FMT_PREC_*.
+} osal_io_fmt_spec_t;
+
+//! \brief Per process format cache entry.
+typedef struct osal_io_fmt_cache {
+    const osal_char_t  *fmt;                //!< Format string pointer used as key.
+    osal_uint32_t       state;              //!< Generation and LIBOSAL_IO_FMT_STATE_*.
+    osal_uint32_t       id;                 //!< Offset in shm format table.
+    osal_uint32_t       nargs;              //!< Number of arguments.
+    osal_uint8_t        kinds[LIBOSAL_IO_FMT_MAX_ARGS]; //!< Argument types.
+    osal_int32_t        precs[LIBOSAL_IO_FMT_MAX_ARGS]; //!< Precision of string arguments.
+} osal_io_fmt_cache_t;
+
+//! \brief Per process tag cache entry.
+typedef struct osal_io_tag_cache {
+    const osal_char_t  *tag;                //!< Tag pointer used as key.
+    osal_uint32_t       state;              //!< Generation and LIBOSAL_IO_TAG_STATE_*.
+    osal_uint32_t       id;                 //!< Offset in shm format table + 1.
+} osal_io_tag_cache_t;
+
+//! \brief Shared memory ring.
+/*!
+ * The ring is a bounded multi-producer byte queue. Writers reserve bytes 
+ * on \p write_pos, readers claim records on \p read_pos and hand them back 
+ * on \p free_pos when they are done. Records may be released out of order,
+ * \p free_pos only advances over consecutive released records. Writer and 
+ * reader counters are kept on their own cache line to avoid false sharing.
+ */
+typedef struct osal_io_shm_ring {
+    osal_uint64_t       write_pos;          //!< Next byte to be reserved by writers.
+    osal_uint64_t       messages;           //!< Number of published messages.
+    osal_uint64_t       bytes;              //!< Number of published bytes.
+    osal_uint64_t       dropped;            //!< Number of dropped messages.
+    osal_uint64_t       high_water_mark;    //!< Maximum number of used bytes.
+    osal_uint32_t       owner;              //!< Task id of writer owning the task ring, 0 if free.
+    osal_uint8_t        pad0[LIBOSAL_IO_SHM_CACHE_LINE - (5u * sizeof(osal_uint64_t)) - sizeof(osal_uint32_t)];
+    osal_uint64_t       read_pos;           //!< Next record to be consumed.
+    osal_uint64_t       free_pos;           //!< End of bytes free for writers.
+    osal_uint8_t        pad1[LIBOSAL_IO_SHM_CACHE_LINE - (2u * sizeof(osal_uint64_t))];
+} osal_io_shm_ring_t;
+
+//! \brief Shared memory header.
+/*!
+ * The header is followed by \p num_rings ring headers, the data of all 
+ * rings and the format table. Ring 0 is shared by all writers, the others
+ * are owned by a single writer task each.
+ *
+ * A reader which is about to sleep sets \p wake. Writers only signal the 
+ * reader if it is set, so there is at most one wakeup per batch of messages.
+ * Likewise writers blocking on a full ring set \p space_wake.
+ */
 typedef struct osal_io_shm {
 	osal_uint32_t       magic;
-    osal_size_t         max_messages;
+    osal_uint32_t       num_rings;          //!< Number of rings including shared ring.
+    osal_size_t         ring_size;          //!< Size of each ring in bytes.
     osal_size_t         max_message_size;
+    osal_size_t         fmt_table_size;     //!< Size of format table behind the rings.
+
+	osal_semaphore_t    sem;
+
+    osal_uint8_t        pad0[LIBOSAL_IO_SHM_CACHE_LINE];
+    osal_uint64_t       fmt_table_pos;      //!< Next free offset in format table.
+    osal_uint8_t        pad1[LIBOSAL_IO_SHM_CACHE_LINE - sizeof(osal_uint64_t)];
+    osal_uint32_t       wake;               //!< Futex word, 1 if reader is sleeping.
+    osal_uint8_t        pad2[LIBOSAL_IO_SHM_CACHE_LINE - sizeof(osal_uint32_t)];
+    osal_uint32_t       space_wake;         //!< Futex word, 1 if a writer waits for free space.
+    osal_uint8_t        pad3[LIBOSAL_IO_SHM_CACHE_LINE - sizeof(osal_uint32_t)];
+
+	char                msgs[0];
+} osal_io_shm_t;
+
+//! \brief Records claimed by a reader.
+/*!
+ * Claimed records are consecutive per ring, they are handed out ordered by
+ * timestamp over all rings.
+ */
+typedef struct osal_io_shm_claim {
+    osal_uint64_t       pos[LIBOSAL_IO_SHM_MAX_RINGS];  //!< First claimed position per ring.
+    osal_uint64_t       end[LIBOSAL_IO_SHM_MAX_RINGS];  //!< End of claimed records per ring.
+    osal_uint64_t       next[LIBOSAL_IO_SHM_MAX_RINGS]; //!< Next record to hand out per ring.
+    osal_size_t         cnt[LIBOSAL_IO_SHM_MAX_RINGS];  //!< Number of records left to hand out per ring.
+    osal_size_t         total;                          //!< Number of claimed records.
+} osal_io_shm_claim_t;
+
+static osal_shm_t osal_io_shm;
+static osal_io_shm_t *osal_io_shm_buffer = NULL;
+static osal_io_shm_attr_t osal_io_shm_attr = 0u;
+static osal_uint32_t osal_io_shm_generation = 0u;
+
+static osal_io_shm_claim_t osal_io_shm_acquired;
+static osal_char_t osal_io_shm_decoded[LIBOSAL_IO_SHM_MAX_ACQUIRE][LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+static __thread osal_io_shm_ring_t *osal_io_shm_task_ring = NULL;
+static __thread osal_uint32_t osal_io_shm_task_ring_generation = 0u;
+static __thread osal_uint32_t osal_io_task_id = 0u;
+
+#ifdef LIBOSAL_BUILD_POSIX
+static pthread_key_t osal_io_shm_task_ring_key;
+static pthread_once_t osal_io_shm_task_ring_once = PTHREAD_ONCE_INIT;
+#endif
+
+static osal_io_fmt_cache_t osal_io_fmt_cache[LIBOSAL_IO_FMT_CACHE_SIZE];
+static osal_io_tag_cache_t osal_io_tag_cache[LIBOSAL_IO_TAG_CACHE_SIZE];
+
+static osal_uint32_t osal_io_log_level = OSAL_IO_LOG_LEVEL__INFO;
+
+//! \brief Return ring header.
+static osal_io_shm_ring_t *osal_io_shm_ring(osal_io_shm_t *shm, osal_uint32_t idx) {
+    // cppcheck-suppress misra-c2012-11.3
+    return &((osal_io_shm_ring_t *)shm->msgs)[idx];
+}
+
+//! \brief Return record at ring position.
+static osal_io_shm_rec_t *osal_io_shm_rec(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, osal_uint64_t pos) {
+    osal_size_t idx = (osal_size_t)(ring - osal_io_shm_ring(shm, 0u));
+    osal_size_t off = (shm->num_rings * sizeof(osal_io_shm_ring_t)) +
+        (idx * shm->ring_size) + (osal_size_t)(pos % shm->ring_size);
+
+    // cppcheck-suppress misra-c2012-11.3
+    return (osal_io_shm_rec_t *)&shm->msgs[off];
+}
+
+//! \brief Return ring bytes needed by record with message of given length.
+static osal_size_t osal_io_shm_rec_size(osal_size_t len) {
+    return (sizeof(osal_io_shm_rec_t) + len + 1u + 7u) & ~(osal_size_t)7u;
+}
+
+//! \brief Return size of pad record from ring position to end of ring.
+static osal_size_t osal_io_shm_pad_size(osal_io_shm_t *shm, osal_uint64_t pos) {
+    return shm->ring_size - (osal_size_t)(pos % shm->ring_size);
+}
+
+//! \brief Return format table of shm ring.
+static osal_char_t *osal_io_shm_fmt_table(osal_io_shm_t *shm) {
+    return &shm->msgs[shm->num_rings * (sizeof(osal_io_shm_ring_t) + shm->ring_size)];
+}
+
+//! \brief Return string registered in format table.
+/*!
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   id      Offset of string in format table.
+ *
+ * \return String or NULL if \p id does not refer to a valid entry.
+ */
+static const osal_char_t *osal_io_shm_fmt_string(osal_io_shm_t *shm, osal_uint32_t id) {
+    const osal_char_t *ret = NULL;
+
+    if (((osal_uint64_t)id + sizeof(osal_io_shm_fmt_t)) < shm->fmt_table_size) {
+        // cppcheck-suppress misra-c2012-11.3
+        const osal_io_shm_fmt_t *entry = (const osal_io_shm_fmt_t *)&osal_io_shm_fmt_table(shm)[id];
+        if ((entry->len > 0u) && (((osal_uint64_t)id + sizeof(osal_io_shm_fmt_t) + entry->len) <= shm->fmt_table_size) &&
+                (entry->fmt[entry->len - 1u] == '\0')) {
+            ret = entry->fmt;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Return id of calling task.
+static osal_uint32_t osal_io_get_task_id(osal_void_t) {
+#if defined(LIBOSAL_BUILD_POSIX) && defined(SYS_gettid)
+    if (osal_io_task_id == 0u) {
+        osal_io_task_id = (osal_uint32_t)syscall(SYS_gettid);
+    }
+#endif
+
+    return osal_io_task_id;
+}
+
+//! \brief Find next conversion specification in format string.
+/*!
+ * \param[in]   fmt     Format string to search.
+ * \param[out]  spec    Parsed conversion specification.
+ *
+ * \return Pointer to '%' of next conversion or NULL if there is none.
+ */
+static const osal_char_t *osal_io_fmt_next(const osal_char_t *fmt, osal_io_fmt_spec_t *spec) {
+    const osal_char_t *start = strchr(fmt, '%');
+
+    if (start != NULL) {
+        const osal_char_t *c = &start[1];
+        osal_uint32_t kind = LIBOSAL_IO_FMT_ARG_INT;
+        osal_uint32_t mod_long_double = 0u;
+        osal_uint32_t mod_wide = 0u;
+
+        spec->start = start;
+        spec->stars = 0u;
+        spec->prec = LIBOSAL_IO_FMT_PREC_NONE;
+
+        while ((*c != '\0') && (strchr("-+ #0'", *c) != NULL)) { c++; }
+
+        if (*c == '*') { spec->stars++; c++; }
+        while ((*c >= '0') && (*c <= '9')) { c++; }
+
+        if (*c == '.') {
+            c++;
+            if (*c == '*') { 
+                spec->stars++; 
+                spec->prec = LIBOSAL_IO_FMT_PREC_STAR;
+                c++; 
+            } else {
+                // a lone '.' is a precision of zero
+                spec->prec = 0;
+                while ((*c >= '0') && (*c <= '9')) { 
+                    if (spec->prec < (INT32_MAX / 10)) {
+                        spec->prec = (spec->prec * 10) + (*c - '0');
+                    }
+                    c++; 
+                }
+            }
+        }
+
+        switch (*c) {
+            case 'h': c++; if (*c == 'h') { c++; } break;
+            case 'l': c++; mod_wide = 1u; kind = LIBOSAL_IO_FMT_ARG_LONG;
+                      if (*c == 'l') { c++; kind = LIBOSAL_IO_FMT_ARG_LLONG; } break;
+            case 'q': c++; kind = LIBOSAL_IO_FMT_ARG_LLONG; break;
+            case 'j': c++; kind = LIBOSAL_IO_FMT_ARG_INTMAX; break;
+            case 'z': c++; kind = LIBOSAL_IO_FMT_ARG_SIZE; break;
+            case 't': c++; kind = LIBOSAL_IO_FMT_ARG_PTRDIFF; break;
+            case 'L': c++; mod_long_double = 1u; break;
+            default: break;
+        }
+
+        switch (*c) {
+            case '%':
+                kind = c == &start[1] ? LIBOSAL_IO_FMT_ARG_NONE : LIBOSAL_IO_FMT_ARG_UNSUPPORTED;
+                break;
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                break;
+            case 'c':
+                kind = mod_wide != 0u ? LIBOSAL_IO_FMT_ARG_UNSUPPORTED : LIBOSAL_IO_FMT_ARG_INT;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                kind = mod_long_double != 0u ? LIBOSAL_IO_FMT_ARG_UNSUPPORTED : LIBOSAL_IO_FMT_ARG_DOUBLE;
+                break;
+            case 's':
+                kind = mod_wide != 0u ? LIBOSAL_IO_FMT_ARG_UNSUPPORTED : LIBOSAL_IO_FMT_ARG_STR;
+                break;
+            case 'p':
+                kind = LIBOSAL_IO_FMT_ARG_PTR;
+                break;
+            default:
+                // '%n', wide or unknown conversions
+                kind = LIBOSAL_IO_FMT_ARG_UNSUPPORTED;
+                break;
+        }
+
+        if (*c != '\0') { c++; }
+
+        spec->len = (osal_size_t)(c - start);
+        spec->kind = spec->len < LIBOSAL_IO_FMT_MAX_SPEC ? kind : LIBOSAL_IO_FMT_ARG_UNSUPPORTED;
+    }
+
+    return start;
+}
+
+//! \brief Format one conversion specification of a binary message.
+/*!
+ * \param[out]  buf     Output buffer.
+ * \param[in]   len     Length of \p buf.
+ * \param[in]   spec    Conversion specification.
+ * \param[in]   stars   Width and precision arguments.
+ * \param[in]   arg     Raw argument word.
+ * \param[in]   str     String argument if \p spec is a string conversion.
+ *
+ * \return Number of characters that would have been written like snprintf.
+ */
+static int osal_io_fmt_format(osal_char_t *buf, osal_size_t len, const osal_io_fmt_spec_t *spec, 
+        const int stars[2], osal_uint64_t arg, const osal_char_t *str) 
+{
+    osal_char_t fmt[LIBOSAL_IO_FMT_MAX_SPEC];
+    int ret = -1;
+    double dbl;
+
+    (void)memcpy(fmt, spec->start, spec->len);
+    fmt[spec->len] = '\0';
+
+#define OSAL_IO_FMT_SNPRINTF(value) \
+    ret = spec->stars == 0u ? snprintf(buf, len, fmt, (value)) : \
+          spec->stars == 1u ? snprintf(buf, len, fmt, stars[0], (value)) : \
+                              snprintf(buf, len, fmt, stars[0], stars[1], (value))
+
+    switch (spec->kind) {
+        case LIBOSAL_IO_FMT_ARG_INT:     OSAL_IO_FMT_SNPRINTF((int)arg); break;
+        case LIBOSAL_IO_FMT_ARG_LONG:    OSAL_IO_FMT_SNPRINTF((long)arg); break;
+        case LIBOSAL_IO_FMT_ARG_LLONG:   OSAL_IO_FMT_SNPRINTF((long long)arg); break;
+        case LIBOSAL_IO_FMT_ARG_SIZE:    OSAL_IO_FMT_SNPRINTF((size_t)arg); break;
+        case LIBOSAL_IO_FMT_ARG_INTMAX:  OSAL_IO_FMT_SNPRINTF((intmax_t)arg); break;
+        case LIBOSAL_IO_FMT_ARG_PTRDIFF: OSAL_IO_FMT_SNPRINTF((ptrdiff_t)arg); break;
+        case LIBOSAL_IO_FMT_ARG_PTR:     OSAL_IO_FMT_SNPRINTF((void *)(uintptr_t)arg); break;
+        case LIBOSAL_IO_FMT_ARG_STR:     OSAL_IO_FMT_SNPRINTF(str); break;
+        case LIBOSAL_IO_FMT_ARG_DOUBLE:
+            (void)memcpy(&dbl, &arg, sizeof(dbl));
+            OSAL_IO_FMT_SNPRINTF(dbl);
+            break;
+        default:
+            break;
+    }
+
+#undef OSAL_IO_FMT_SNPRINTF
+
+    return ret;
+}
+
+//! \brief Format binary message.
+/*!
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   rec     Record holding binary message.
+ * \param[out]  msg     Buffer to write formatted message to.
+ * \param[in]   len     Length of \p msg buffer.
+ */
+static osal_void_t osal_io_shm_decode(osal_io_shm_t *shm, const osal_io_shm_rec_t *rec, 
+        osal_char_t *msg, osal_size_t len) 
+{
+    // cppcheck-suppress misra-c2012-11.3
+    const osal_io_shm_bin_t *bin = (const osal_io_shm_bin_t *)rec->msg;
+    const osal_char_t *rec_end = &rec->msg[rec->len];
+    const osal_char_t *str = (const osal_char_t *)&bin->args[bin->nargs];
+    const osal_char_t *fmt = osal_io_shm_fmt_string(shm, bin->fmt_id);
+    osal_size_t out = 0u;
+
+    if ((fmt == NULL) || (bin->nargs > LIBOSAL_IO_FMT_MAX_ARGS)) {
+        (void)snprintf(msg, len, "osal_io_shm: invalid binary message (format id %u)\n", bin->fmt_id);
+    } else {
+        osal_io_fmt_spec_t spec;
+        osal_uint32_t arg = 0u;
+        const osal_char_t *pos = fmt;
+
+        while (out < (len - 1u)) {
+            const osal_char_t *next = osal_io_fmt_next(pos, &spec);
+            osal_size_t lit_len = next != NULL ? (osal_size_t)(next - pos) : strlen(pos);
+
+            if (lit_len > (len - 1u - out)) {
+                lit_len = len - 1u - out;
+            }
+
+            (void)memcpy(&msg[out], pos, lit_len);
+            out += lit_len;
+
+            if ((next == NULL) || (out >= (len - 1u))) {
+                break;
+            }
+
+            pos = &next[spec.len];
+
+            if (spec.kind == LIBOSAL_IO_FMT_ARG_NONE) {
+                msg[out] = '%';
+                out++;
+                continue;
+            }
+
+            if ((spec.kind == LIBOSAL_IO_FMT_ARG_UNSUPPORTED) || ((arg + spec.stars + 1u) > bin->nargs)) {
+                break;
+            }
+
+            int stars[2] = { 0, 0 };
+            for (osal_uint32_t i = 0u; i < spec.stars; ++i) {
+                stars[i] = (int)bin->args[arg];
+                arg++;
+            }
+
+            osal_uint64_t value = bin->args[arg];
+            const osal_char_t *value_str = NULL;
+            arg++;
+
+            if (spec.kind == LIBOSAL_IO_FMT_ARG_STR) {
+                if ((value >= (osal_uint64_t)(rec_end - str)) || (str[value] != '\0')) {
+                    break;
+                }
+
+                value_str = str;
+                str = &str[value + 1u];
+            }
+
+            int n = osal_io_fmt_format(&msg[out], len - out, &spec, stars, value, value_str);
+            if (n < 0) {
+                break;
+            }
+
+            out += ((osal_size_t)n < (len - 1u - out)) ? (osal_size_t)n : (len - 1u - out);
+        }
+    }
+
+    if (fmt != NULL) {
+        msg[out] = '\0';
+    }
+}
+
+//! \brief Copy message text from record.
+static osal_void_t osal_io_shm_copy(osal_io_shm_t *shm, const osal_io_shm_rec_t *rec, 
+        osal_char_t *msg, osal_size_t len) 
+{
+    if (rec->type == LIBOSAL_IO_SHM_REC_BINARY) {
+        osal_io_shm_decode(shm, rec, msg, len);
+    } else {
+        osal_size_t cpy_len = rec->len < (len - 1u) ? rec->len : (len - 1u);
+        (void)memcpy(msg, rec->msg, cpy_len);
+        msg[cpy_len] = '\0';
+    }
+}
+
+//! \brief Return published record at ring position.
+/*!
+ * \param[in]       shm     Pointer to shm.
+ * \param[in]       ring    Pointer to ring.
+ * \param[in,out]   pos     Ring position, advanced over a published pad record.
+ *
+ * \return Record or NULL if no record is published at \p pos.
+ */
+static osal_io_shm_rec_t *osal_io_shm_peek(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, osal_uint64_t *pos) {
+    osal_io_shm_rec_t *ret = NULL;
+    osal_io_shm_rec_t *rec = osal_io_shm_rec(shm, ring, *pos);
+    osal_uint64_t state = __atomic_load_n(&rec->state, __ATOMIC_ACQUIRE);
+
+    if (state == (*pos | LIBOSAL_IO_SHM_STATE_PUBLISHED | LIBOSAL_IO_SHM_STATE_PAD)) {
+        *pos += osal_io_shm_pad_size(shm, *pos);
+        rec = osal_io_shm_rec(shm, ring, *pos);
+        state = __atomic_load_n(&rec->state, __ATOMIC_ACQUIRE);
+    }
+
+    if (state == (*pos | LIBOSAL_IO_SHM_STATE_PUBLISHED)) {
+        ret = rec;
+    }
+
+    return ret;
+}
+
+//! \brief Zero ring bytes.
+static osal_void_t osal_io_shm_zero(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, 
+        osal_uint64_t pos, osal_uint64_t end) 
+{
+    while (pos != end) {
+        osal_size_t len = osal_io_shm_pad_size(shm, pos);
+        if (len > (end - pos)) {
+            len = (osal_size_t)(end - pos);
+        }
+
+        (void)memset(osal_io_shm_rec(shm, ring, pos), 0, len);
+        pos += len;
+    }
+}
+
+//! \brief Advance free position over released records.
+/*!
+ * Whoever wins the state of the released record at the free position zeroes
+ * and frees it, so concurrent callers never free a record twice.
+ *
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ */
+static osal_void_t osal_io_shm_collect(osal_io_shm_t *shm, osal_io_shm_ring_t *ring) {
+    for (;;) {
+        osal_uint64_t pos = __atomic_load_n(&ring->free_pos, __ATOMIC_SEQ_CST);
+        osal_io_shm_rec_t *rec = osal_io_shm_rec(shm, ring, pos);
+        osal_uint64_t state = __atomic_load_n(&rec->state, __ATOMIC_SEQ_CST);
+
+        if ((state & ~(osal_uint64_t)LIBOSAL_IO_SHM_STATE_PAD) != (pos | LIBOSAL_IO_SHM_STATE_RELEASED)) {
+            break;
+        }
+
+        if (__atomic_compare_exchange_n(&rec->state, &state, 0u, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            osal_uint64_t end = pos + ((state & LIBOSAL_IO_SHM_STATE_PAD) != 0u ? 
+                    osal_io_shm_pad_size(shm, pos) : osal_io_shm_rec_size(rec->len));
+
+            osal_io_shm_zero(shm, ring, pos, end);
+            __atomic_store_n(&ring->free_pos, end, __ATOMIC_SEQ_CST);
+        }
+    }
+}
+
+//! \brief Free consumed records to writers.
+/*!
+ * Records directly behind the free position are zeroed and freed at once,
+ * others are marked released and freed by whoever frees the records in
+ * front of them.
+ *
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   pos     First consumed ring position.
+ * \param[in]   end     End of consumed records.
+ */
+static osal_void_t osal_io_shm_free(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, 
+        osal_uint64_t pos, osal_uint64_t end) 
+{
+    if (__atomic_load_n(&ring->free_pos, __ATOMIC_SEQ_CST) == pos) {
+        // nobody else frees unreleased records, we own the free position
+        osal_io_shm_zero(shm, ring, pos, end);
+        __atomic_store_n(&ring->free_pos, end, __ATOMIC_SEQ_CST);
+    } else {
+        while (pos != end) {
+            osal_io_shm_rec_t *rec = osal_io_shm_rec(shm, ring, pos);
+            osal_uint64_t pad = rec->state & LIBOSAL_IO_SHM_STATE_PAD;
+            osal_uint64_t next = pos + (pad != 0u ? osal_io_shm_pad_size(shm, pos) : osal_io_shm_rec_size(rec->len));
+
+            __atomic_store_n(&rec->state, pos | LIBOSAL_IO_SHM_STATE_RELEASED | pad, __ATOMIC_SEQ_CST);
+            pos = next;
+        }
+    }
+
+    osal_io_shm_collect(shm, ring);
+
+    // wake writers blocking on a full ring, pairs with osal_io_shm_wait_space
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if ((__atomic_load_n(&shm->space_wake, __ATOMIC_RELAXED) != 0u) &&
+            (__atomic_exchange_n(&shm->space_wake, 0u, __ATOMIC_SEQ_CST) != 0u)) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        osal_futex_wake(&shm->space_wake, INT_MAX, 1);
+#endif
+    }
+}
+
+//! \brief Claim published messages of one ring.
+/*!
+ * Advances the read position over up to \p max_msgs published records but
+ * does not free them. Claimed records can not be dropped by writers, if
+ * the ring runs full meanwhile new messages are dropped instead.
+ *
+ * \param[in]   shm         Pointer to shm.
+ * \param[in]   ring        Pointer to ring.
+ * \param[in]   max_msgs    Maximum number of records to claim.
+ * \param[out]  pos         First claimed ring position.
+ * \param[out]  end         End of claimed records.
+ *
+ * \return Number of claimed records.
+ */
+static osal_size_t osal_io_shm_claim_ring(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, 
+        osal_size_t max_msgs, osal_uint64_t *pos, osal_uint64_t *end) 
+{
+    osal_size_t cnt;
+    *pos = __atomic_load_n(&ring->read_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        osal_uint64_t tmp = *pos;
+        osal_io_shm_rec_t *rec;
+
+        cnt = 0u;
+        *end = *pos;
+
+        while ((cnt < max_msgs) && ((rec = osal_io_shm_peek(shm, ring, &tmp)) != NULL)) {
+            tmp += osal_io_shm_rec_size(rec->len);
+            *end = tmp;
+            cnt++;
+        }
+
+        if ((cnt == 0u) || (__atomic_compare_exchange_n(&ring->read_pos, pos, *end,
+                        0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+            break;
+        }
+    }
+
+    return cnt;
+}
+
+//! \brief Claim oldest published messages of all rings.
+/*!
+ * Selects up to \p max_msgs oldest messages by timestamp over all rings
+ * and claims them. If a writer drops messages meanwhile, whatever is
+ * published at the read position of that ring is claimed instead.
+ *
+ * \param[in]   shm         Pointer to shm.
+ * \param[in]   max_msgs    Maximum number of records to claim.
+ * \param[out]  claim       Claimed records.
+ */
+static osal_void_t osal_io_shm_claim(osal_io_shm_t *shm, osal_size_t max_msgs, osal_io_shm_claim_t *claim) {
+    osal_size_t selected = 0u;
+
+    for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+        claim->pos[r] = __atomic_load_n(&osal_io_shm_ring(shm, r)->read_pos, __ATOMIC_RELAXED);
+        claim->end[r] = claim->pos[r];
+        claim->cnt[r] = 0u;
+    }
+
+    // merge published messages of all rings by timestamp
+    while (selected < max_msgs) {
+        osal_uint32_t best = shm->num_rings;
+        osal_uint64_t best_end = 0u;
+        osal_uint64_t best_ts = 0u;
+
+        for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+            osal_uint64_t pos = claim->end[r];
+            osal_io_shm_rec_t *rec = osal_io_shm_peek(shm, osal_io_shm_ring(shm, r), &pos);
+
+            if ((rec != NULL) && ((best == shm->num_rings) || (rec->timestamp < best_ts))) {
+                best = r;
+                best_ts = rec->timestamp;
+                best_end = pos + osal_io_shm_rec_size(rec->len);
+            }
+        }
+
+        if (best == shm->num_rings) {
+            break;
+        }
+
+        claim->end[best] = best_end;
+        claim->cnt[best]++;
+        selected++;
+    }
+
+    claim->total = 0u;
+
+    for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+        if (claim->cnt[r] > 0u) {
+            osal_io_shm_ring_t *ring = osal_io_shm_ring(shm, r);
+            osal_uint64_t head = claim->pos[r];
+
+            if (!__atomic_compare_exchange_n(&ring->read_pos, &head, claim->end[r],
+                        0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                claim->cnt[r] = osal_io_shm_claim_ring(shm, ring, claim->cnt[r], &claim->pos[r], &claim->end[r]);
+            }
+
+            claim->total += claim->cnt[r];
+        }
+
+        claim->next[r] = claim->pos[r];
+    }
+}
+
+//! \brief Return next claimed record in timestamp order.
+/*!
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   claim   Claimed records.
+ *
+ * \return Next record or NULL if all claimed records were returned.
+ */
+static osal_io_shm_rec_t *osal_io_shm_claim_next(osal_io_shm_t *shm, osal_io_shm_claim_t *claim) {
+    osal_io_shm_rec_t *ret = NULL;
+    osal_uint32_t best = shm->num_rings;
+    osal_uint64_t best_pos = 0u;
+
+    for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+        if (claim->cnt[r] > 0u) {
+            osal_uint64_t pos = claim->next[r];
+            osal_io_shm_rec_t *rec = osal_io_shm_peek(shm, osal_io_shm_ring(shm, r), &pos);
+
+            if ((rec != NULL) && ((ret == NULL) || (rec->timestamp < ret->timestamp))) {
+                ret = rec;
+                best = r;
+                best_pos = pos;
+            }
+        }
+    }
+
+    if (ret != NULL) {
+        claim->next[best] = best_pos + osal_io_shm_rec_size(ret->len);
+        claim->cnt[best]--;
+    }
+
+    return ret;
+}
+
+//! \brief Release claimed records to writers.
+static osal_void_t osal_io_shm_release(osal_io_shm_t *shm, osal_io_shm_claim_t *claim) {
+    for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+        if (claim->end[r] != claim->pos[r]) {
+            osal_io_shm_free(shm, osal_io_shm_ring(shm, r), claim->pos[r], claim->end[r]);
+            claim->pos[r] = claim->end[r];
+        }
+
+        claim->cnt[r] = 0u;
+    }
+
+    claim->total = 0u;
+}
+
+//! \brief Drop oldest message of ring.
+/*!
+ * Only drops if no older records are held by a reader, otherwise 
+ * dropping would not free any space for writers.
+ *
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ *
+ * \return OSAL_OK on success, OSAL_ERR_UNAVAILABLE if nothing could be dropped.
+ */
+static osal_retval_t osal_io_shm_evict(osal_io_shm_t *shm, osal_io_shm_ring_t *ring) {
+    osal_retval_t ret = OSAL_ERR_UNAVAILABLE;
+    osal_uint64_t pos;
+    osal_uint64_t end;
+
+    if ((__atomic_load_n(&ring->free_pos, __ATOMIC_RELAXED) == __atomic_load_n(&ring->read_pos, __ATOMIC_RELAXED)) &&
+            (osal_io_shm_claim_ring(shm, ring, 1u, &pos, &end) == 1u)) {
+        osal_io_shm_free(shm, ring, pos, end);
+        ret = OSAL_OK;
+    }
+
+    return ret;
+}
+
+//! \brief Check if oldest message of any ring is published.
+static int osal_io_shm_available(osal_io_shm_t *shm) {
+    int ret = 0;
+
+    for (osal_uint32_t r = 0u; (r < shm->num_rings) && (ret == 0); ++r) {
+        osal_io_shm_ring_t *ring = osal_io_shm_ring(shm, r);
+        osal_uint64_t pos = __atomic_load_n(&ring->read_pos, __ATOMIC_RELAXED);
+
+        ret = osal_io_shm_peek(shm, ring, &pos) != NULL ? 1 : 0;
+    }
+
+    return ret;
+}
+
+//! \brief Wait for writers to publish a message.
+/*!
+ * Declares the reader sleeping and blocks until a writer signals or the
+ * timeout expires. Returns immediately if a message was published meanwhile.
+ *
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   to      Absolute timeout.
+ *
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid, did not wait.
+ */
+static osal_retval_t osal_io_shm_wait(osal_io_shm_t *shm, const osal_timer_t *to) {
+    osal_retval_t ret = OSAL_OK;
+
+    __atomic_store_n(&shm->wake, 1u, __ATOMIC_SEQ_CST);
+
+    // re-check after announcing, a writer which published before may
+    // not have seen the flag.
+    if (osal_io_shm_available(shm) == 0) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        ret = osal_futex_wait(&shm->wake, 1u, 1, to);
+#else
+        ret = osal_semaphore_timedwait(&shm->sem, to);
+#endif
+    }
+
+    return ret;
+}
+
+//! \brief Wake reader if it is sleeping.
+/*!
+ * Only the first writer after the reader went to sleep does a syscall,
+ * all others only read the flag.
+ *
+ * \param[in]   shm     Pointer to shm ring.
+ */
+static osal_void_t osal_io_shm_signal(osal_io_shm_t *shm) {
+    // order publishing of message before reading the flag, pairs with
+    // re-check in osal_io_shm_wait
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if ((__atomic_load_n(&shm->wake, __ATOMIC_RELAXED) != 0u) &&
+            (__atomic_exchange_n(&shm->wake, 0u, __ATOMIC_SEQ_CST) != 0u)) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        osal_futex_wake(&shm->wake, INT_MAX, 1);
+#else
+        osal_semaphore_post(&shm->sem);
+#endif
+    }
+}
+
+//! \brief Wait for reader to free space.
+/*!
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   end     End of ring bytes to be reserved.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \retval OSAL_OK              Space may be free now.
+ * \retval OSAL_ERR_TIMEOUT     Timeout expired.
+ */
+static osal_retval_t osal_io_shm_wait_space(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, 
+        osal_uint64_t end, osal_timer_t *to) 
+{
+    osal_retval_t ret = OSAL_OK;
+
+    __atomic_store_n(&shm->space_wake, 1u, __ATOMIC_SEQ_CST);
+
+    // re-check after announcing, the reader may have freed meanwhile
+    if ((osal_int64_t)(end - __atomic_load_n(&ring->free_pos, __ATOMIC_SEQ_CST)) > (osal_int64_t)shm->ring_size) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        ret = osal_futex_wait(&shm->space_wake, 1u, 1, to);
+#else
+        osal_sleep(LIBOSAL_IO_SHM_POLL_NSEC);
+
+        if (to != NULL) {
+            ret = osal_timer_expired(to);
+        }
+#endif
+    }
+
+    return ret;
+}
+
+//! \brief Reserve record in ring.
+/*!
+ * Lock-free, may be called concurrently from any number of tasks or processes.
+ * If the ring is full the overflow policy set up for this process applies.
+ *
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   len     Length of message to be stored in record.
+ * \param[in]   level   Log level of message.
+ * \param[in]   tag     Tag id of message, 0 if none.
+ * \param[out]  pos     Reserved ring position, to be passed to \ref osal_io_shm_publish.
+ * \param[out]  rec     Reserved record.
+ *
+ * \retval OSAL_OK              On success.
+ * \retval OSAL_ERR_BUSY        Message had to be dropped.
+ * \retval OSAL_ERR_TIMEOUT     Ring stayed full until the blocking timeout expired.
+ */
+static osal_retval_t osal_io_shm_reserve(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, osal_size_t len,
+        osal_uint32_t level, osal_uint32_t tag, osal_uint64_t *pos, osal_io_shm_rec_t **rec) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_io_shm_attr_t policy = osal_io_shm_attr & OSAL_IO_SHM_ATTR__OVERFLOW__MASK;
+    osal_size_t size = osal_io_shm_rec_size(len);
+    osal_uint64_t pad = 0u;
+    osal_timer_t to;
+    osal_timer_t *p_to = NULL;
+    int to_init = 0;
+
+    *pos = __atomic_load_n(&ring->write_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        // records do not wrap, pad to end of ring if it does not fit
+        pad = (osal_io_shm_pad_size(shm, *pos) < size) ? osal_io_shm_pad_size(shm, *pos) : 0u;
+        osal_uint64_t end = *pos + pad + size;
+
+        if ((osal_int64_t)(end - __atomic_load_n(&ring->free_pos, __ATOMIC_ACQUIRE)) <= (osal_int64_t)shm->ring_size) {
+            if (__atomic_compare_exchange_n(&ring->write_pos, pos, end, 
+                        1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else {
+            if (policy == OSAL_IO_SHM_ATTR__OVERFLOW__BLOCK) {
+                if (to_init == 0) {
+                    osal_uint64_t timeout = (osal_io_shm_attr & OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__MASK) >> 
+                        OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__SHIFT;
+
+                    if (timeout != 0u) {
+                        osal_timer_init(&to, timeout * 1000000u);
+                        p_to = &to;
+                    }
+
+                    to_init = 1;
+                }
+
+                ret = osal_io_shm_wait_space(shm, ring, end, p_to);
+            } else if ((policy == OSAL_IO_SHM_ATTR__OVERFLOW__DROP_NEWEST) ||
+                    (osal_io_shm_evict(shm, ring) != OSAL_OK)) {
+                // drop this message. with drop oldest this happens if the 
+                // oldest message is still being written by a preempted
+                // writer or held by the reader.
+                ret = OSAL_ERR_BUSY;
+            } else {
+                (void)__atomic_fetch_add(&ring->dropped, 1u, __ATOMIC_RELAXED);
+            }
+
+            if (ret != OSAL_OK) {
+                (void)__atomic_fetch_add(&ring->dropped, 1u, __ATOMIC_RELAXED);
+                break;
+            }
+
+            *pos = __atomic_load_n(&ring->write_pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        if (pad != 0u) {
+            __atomic_store_n(&osal_io_shm_rec(shm, ring, *pos)->state, 
+                    *pos | LIBOSAL_IO_SHM_STATE_PUBLISHED | LIBOSAL_IO_SHM_STATE_PAD, __ATOMIC_RELEASE);
+            *pos += pad;
+        }
+
+        *rec = osal_io_shm_rec(shm, ring, *pos);
+        (*rec)->timestamp = osal_timer_gettime_nsec();
+        (*rec)->tid = osal_io_get_task_id();
+        (*rec)->tag = tag;
+        (*rec)->level = (osal_uint16_t)level;
+    }
+
+    return ret;
+}
+
+//! \brief Publish reserved record to readers.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   rec     Reserved record.
+ * \param[in]   pos     Reserved ring position.
+ */
+static osal_void_t osal_io_shm_publish(osal_io_shm_ring_t *ring, osal_io_shm_rec_t *rec, osal_uint64_t pos) {
+    osal_uint32_t len = rec->len;
+    __atomic_store_n(&rec->state, pos | LIBOSAL_IO_SHM_STATE_PUBLISHED, __ATOMIC_RELEASE);
+
+    (void)__atomic_fetch_add(&ring->messages, 1u, __ATOMIC_RELAXED);
+    (void)__atomic_fetch_add(&ring->bytes, len, __ATOMIC_RELAXED);
+
+    // records may have been freed meanwhile, ignore in that case
+    osal_uint64_t used = pos + osal_io_shm_rec_size(len) - __atomic_load_n(&ring->free_pos, __ATOMIC_RELAXED);
+    osal_uint64_t hwm = __atomic_load_n(&ring->high_water_mark, __ATOMIC_RELAXED);
+
+    while ((used > hwm) && ((osal_int64_t)used > 0) && !__atomic_compare_exchange_n(&ring->high_water_mark, 
+                &hwm, used, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+//! \brief Publish message to ring.
+/*!
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   level   Log level of message.
+ * \param[in]   tag     Tag id of message, 0 if none.
+ * \param[in]   msg     Message to publish.
+ * \param[in]   len     Length of \p msg without terminating zero.
+ *
+ * \return OSAL_OK on success, otherwise see \ref osal_io_shm_reserve.
+ */
+static osal_retval_t osal_io_shm_push(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, osal_uint32_t level, 
+        osal_uint32_t tag, const osal_char_t *msg, osal_size_t len) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t pos;
+    osal_io_shm_rec_t *rec;
+
+    if (len >= shm->max_message_size) {
+        len = shm->max_message_size - 1u;
+    }
+
+    ret = osal_io_shm_reserve(shm, ring, len, level, tag, &pos, &rec);
+    if (ret == OSAL_OK) {
+        (void)memcpy(rec->msg, msg, len);
+        rec->msg[len] = '\0';
+        rec->type = LIBOSAL_IO_SHM_REC_TEXT;
+        rec->len = (osal_uint32_t)len;
+
+        osal_io_shm_publish(ring, rec, pos);
+    }
+
+    return ret;
+}
+
+//! \brief Register format string in shm format table.
+/*!
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   fmt     Format string.
+ * \param[out]  id      Offset of format string in format table.
+ *
+ * \return OSAL_OK on success, OSAL_ERR_OUT_OF_MEMORY if format table is full.
+ */
+static osal_retval_t osal_io_shm_fmt_register(osal_io_shm_t *shm, const osal_char_t *fmt, osal_uint32_t *id) {
+    osal_retval_t ret = OSAL_OK;
+    osal_size_t len = strlen(fmt) + 1u;
+    osal_size_t entry_size = (sizeof(osal_io_shm_fmt_t) + len + 7u) & ~(osal_size_t)7u;
+    osal_uint64_t off = __atomic_fetch_add(&shm->fmt_table_pos, entry_size, __ATOMIC_RELAXED);
+
+    if ((off + entry_size) > shm->fmt_table_size) {
+        ret = OSAL_ERR_OUT_OF_MEMORY;
+    } else {
+        // cppcheck-suppress misra-c2012-11.3
+        osal_io_shm_fmt_t *entry = (osal_io_shm_fmt_t *)&osal_io_shm_fmt_table(shm)[off];
+        (void)memcpy(entry->fmt, fmt, len);
+        entry->len = (osal_uint32_t)len;
+        *id = (osal_uint32_t)off;
+    }
 
-	osal_mutex_t        mtx;
-	osal_semaphore_t    sem;
-	osal_bool_t         new_msg;
+    return ret;
+}
 
-    osal_uint32_t       act_printed;
-    osal_uint32_t       act_written;
-	char                msgs[0];
-} osal_io_shm_t;
+//! \brief Get format cache entry for binary logging.
+/*!
+ * On first use the format string is parsed and registered in the shm format
+ * table. Lock-free, if the entry is being registered concurrently by another 
+ * task the caller has to fall back to formatting itself. The format is
+ * compared with the registered one on every use, so a buffer reused for 
+ * another format is never recorded with the argument types of the old one.
+ *
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   fmt     Format string.
+ *
+ * \return Cache entry or NULL if the message has to be formatted by the writer.
+ */
+static const osal_io_fmt_cache_t *osal_io_fmt_lookup(osal_io_shm_t *shm, const osal_char_t *fmt) {
+    const osal_io_fmt_cache_t *ret = NULL;
+    osal_io_fmt_cache_t *entry = NULL;
+    osal_uint32_t gen = __atomic_load_n(&osal_io_shm_generation, __ATOMIC_ACQUIRE);
+    osal_uint64_t hash = ((osal_uint64_t)(uintptr_t)fmt >> 3u) * 0x9E3779B97F4A7C15u;
 
-static osal_shm_t osal_io_shm;
-static osal_io_shm_t *osal_io_shm_buffer = NULL;
+    for (osal_uint32_t i = 0u; i < LIBOSAL_IO_FMT_CACHE_PROBES; ++i) {
+        osal_io_fmt_cache_t *tmp = &osal_io_fmt_cache[(hash + i) % LIBOSAL_IO_FMT_CACHE_SIZE];
+        const osal_char_t *key = __atomic_load_n(&tmp->fmt, __ATOMIC_ACQUIRE);
+
+        if ((key == NULL) && (__atomic_compare_exchange_n(&tmp->fmt, &key, fmt, 
+                    0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))) {
+            key = fmt;
+        }
+
+        if (key == fmt) {
+            entry = tmp;
+            break;
+        }
+    }
+
+    if (entry != NULL) {
+        osal_uint32_t state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+
+        if ((state >> LIBOSAL_IO_FMT_STATE_SHIFT) != gen) {
+            // not registered in current shm, try to register now
+            osal_uint32_t busy = (gen << LIBOSAL_IO_FMT_STATE_SHIFT) | LIBOSAL_IO_FMT_STATE_BUSY;
+
+            if (__atomic_compare_exchange_n(&entry->state, &state, busy,
+                        0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                osal_io_fmt_spec_t spec;
+                const osal_char_t *pos = fmt;
+                osal_uint32_t result = LIBOSAL_IO_FMT_STATE_BINARY;
+
+                entry->nargs = 0u;
+
+                while ((result == LIBOSAL_IO_FMT_STATE_BINARY) && ((pos = osal_io_fmt_next(pos, &spec)) != NULL)) {
+                    if ((spec.kind == LIBOSAL_IO_FMT_ARG_UNSUPPORTED) || 
+                            ((entry->nargs + spec.stars + 1u) > LIBOSAL_IO_FMT_MAX_ARGS)) {
+                        result = LIBOSAL_IO_FMT_STATE_TEXT;
+                    } else if (spec.kind != LIBOSAL_IO_FMT_ARG_NONE) {
+                        for (osal_uint32_t i = 0u; i < spec.stars; ++i) {
+                            entry->kinds[entry->nargs] = LIBOSAL_IO_FMT_ARG_INT;
+                            entry->nargs++;
+                        }
+
+                        entry->kinds[entry->nargs] = (osal_uint8_t)spec.kind;
+                        entry->precs[entry->nargs] = spec.prec;
+                        entry->nargs++;
+                    }
+
+                    pos = &pos[spec.len];
+                }
+
+                if ((sizeof(osal_io_shm_bin_t) + (entry->nargs * sizeof(osal_uint64_t))) >= shm->max_message_size) {
+                    result = LIBOSAL_IO_FMT_STATE_TEXT;
+                }
+
+                if ((result == LIBOSAL_IO_FMT_STATE_BINARY) && 
+                        (osal_io_shm_fmt_register(shm, fmt, &entry->id) != OSAL_OK)) {
+                    result = LIBOSAL_IO_FMT_STATE_TEXT;
+                }
+
+                state = (gen << LIBOSAL_IO_FMT_STATE_SHIFT) | result;
+                __atomic_store_n(&entry->state, state, __ATOMIC_RELEASE);
+            }
+        }
+
+        if (state == ((gen << LIBOSAL_IO_FMT_STATE_SHIFT) | LIBOSAL_IO_FMT_STATE_BINARY)) {
+            // the pointer is only the key, a reused buffer may hold another format
+            // cppcheck-suppress misra-c2012-11.3
+            const osal_io_shm_fmt_t *reg = (const osal_io_shm_fmt_t *)&osal_io_shm_fmt_table(shm)[entry->id];
+
+            if (strcmp(reg->fmt, fmt) == 0) {
+                ret = entry;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Get format table id of tag.
+/*!
+ * Like format strings, tags are identified by their pointer and registered
+ * in the shm format table once per process.
+ *
+ * \param[in]   shm     Pointer to shm ring.
+ * \param[in]   tag     Tag string.
+ *
+ * \return Offset of tag in format table + 1, or 0 if it could not be registered.
+ */
+static osal_uint32_t osal_io_tag_lookup(osal_io_shm_t *shm, const osal_char_t *tag) {
+    osal_uint32_t ret = 0u;
+    osal_io_tag_cache_t *entry = NULL;
+    osal_uint32_t gen = __atomic_load_n(&osal_io_shm_generation, __ATOMIC_ACQUIRE);
+    osal_uint64_t hash = ((osal_uint64_t)(uintptr_t)tag >> 3u) * 0x9E3779B97F4A7C15u;
+
+    for (osal_uint32_t i = 0u; i < LIBOSAL_IO_FMT_CACHE_PROBES; ++i) {
+        osal_io_tag_cache_t *tmp = &osal_io_tag_cache[(hash + i) % LIBOSAL_IO_TAG_CACHE_SIZE];
+        const osal_char_t *key = __atomic_load_n(&tmp->tag, __ATOMIC_ACQUIRE);
+
+        if ((key == NULL) && (__atomic_compare_exchange_n(&tmp->tag, &key, tag, 
+                    0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))) {
+            key = tag;
+        }
+
+        if (key == tag) {
+            entry = tmp;
+            break;
+        }
+    }
+
+    if (entry != NULL) {
+        osal_uint32_t state = __atomic_load_n(&entry->state, __ATOMIC_ACQUIRE);
+
+        if ((state >> LIBOSAL_IO_FMT_STATE_SHIFT) != gen) {
+            osal_uint32_t busy = (gen << LIBOSAL_IO_FMT_STATE_SHIFT) | LIBOSAL_IO_FMT_STATE_BUSY;
+
+            if (__atomic_compare_exchange_n(&entry->state, &state, busy,
+                        0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                osal_uint32_t result = LIBOSAL_IO_TAG_STATE_FAILED;
+                osal_uint32_t id;
+
+                if (osal_io_shm_fmt_register(shm, tag, &id) == OSAL_OK) {
+                    entry->id = id + 1u;
+                    result = LIBOSAL_IO_TAG_STATE_REGISTERED;
+                }
+
+                state = (gen << LIBOSAL_IO_FMT_STATE_SHIFT) | result;
+                __atomic_store_n(&entry->state, state, __ATOMIC_RELEASE);
+            }
+        }
+
+        if (state == ((gen << LIBOSAL_IO_FMT_STATE_SHIFT) | LIBOSAL_IO_TAG_STATE_REGISTERED)) {
+            ret = entry->id;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Publish binary message to ring.
+/*!
+ * \param[in]   shm     Pointer to shm.
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   level   Log level of message.
+ * \param[in]   tag     Tag id of message, 0 if none.
+ * \param[in]   entry   Format cache entry.
+ * \param[in]   va      Arguments.
+ *
+ * \return OSAL_OK on success, otherwise see \ref osal_io_shm_reserve.
+ */
+static osal_retval_t osal_io_shm_push_binary(osal_io_shm_t *shm, osal_io_shm_ring_t *ring, osal_uint32_t level,
+        osal_uint32_t tag, const osal_io_fmt_cache_t *entry, va_list va) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t args[LIBOSAL_IO_FMT_MAX_ARGS];
+    const osal_char_t *strs[LIBOSAL_IO_FMT_MAX_ARGS];
+    osal_size_t len = sizeof(osal_io_shm_bin_t) + (entry->nargs * sizeof(osal_uint64_t));
+    double dbl;
+
+    for (osal_uint32_t i = 0u; i < entry->nargs; ++i) {
+        switch (entry->kinds[i]) {
+            case LIBOSAL_IO_FMT_ARG_INT:     args[i] = (osal_uint64_t)va_arg(va, int); break;
+            case LIBOSAL_IO_FMT_ARG_LONG:    args[i] = (osal_uint64_t)va_arg(va, long); break;
+            case LIBOSAL_IO_FMT_ARG_LLONG:   args[i] = (osal_uint64_t)va_arg(va, long long); break;
+            case LIBOSAL_IO_FMT_ARG_SIZE:    args[i] = (osal_uint64_t)va_arg(va, size_t); break;
+            case LIBOSAL_IO_FMT_ARG_INTMAX:  args[i] = (osal_uint64_t)va_arg(va, intmax_t); break;
+            case LIBOSAL_IO_FMT_ARG_PTRDIFF: args[i] = (osal_uint64_t)va_arg(va, ptrdiff_t); break;
+            case LIBOSAL_IO_FMT_ARG_PTR:     args[i] = (osal_uint64_t)(uintptr_t)va_arg(va, void *); break;
+            case LIBOSAL_IO_FMT_ARG_DOUBLE:
+                dbl = va_arg(va, double);
+                (void)memcpy(&args[i], &dbl, sizeof(dbl));
+                break;
+            case LIBOSAL_IO_FMT_ARG_STR:
+            default:
+                strs[i] = va_arg(va, const osal_char_t *);
+                if (strs[i] == NULL) {
+                    strs[i] = "(null)";
+                }
+
+                // strings are truncated to what is left of the message size
+                if (len < (shm->max_message_size - 1u)) {
+                    osal_size_t max_len = shm->max_message_size - 2u - len;
+
+                    // never read beyond the precision, the string need not be terminated
+                    osal_int64_t prec = entry->precs[i];
+                    if ((prec == LIBOSAL_IO_FMT_PREC_STAR) && (i > 0u)) {
+                        // negative precision arguments are taken as if omitted
+                        prec = (osal_int64_t)(int)args[i - 1u];
+                    }
+
+                    if ((prec >= 0) && ((osal_size_t)prec < max_len)) {
+                        max_len = (osal_size_t)prec;
+                    }
+
+                    args[i] = strnlen(strs[i], max_len);
+                    len += args[i] + 1u;
+                } else {
+                    // no room for string, reader stops before this argument
+                    args[i] = shm->max_message_size;
+                }
+                break;
+        }
+    }
+
+    osal_uint64_t pos;
+    osal_io_shm_rec_t *rec;
+
+    ret = osal_io_shm_reserve(shm, ring, len, level, tag, &pos, &rec);
+    if (ret == OSAL_OK) {
+        // cppcheck-suppress misra-c2012-11.3
+        osal_io_shm_bin_t *bin = (osal_io_shm_bin_t *)rec->msg;
+        osal_size_t off = sizeof(osal_io_shm_bin_t) + (entry->nargs * sizeof(osal_uint64_t));
+
+        bin->fmt_id = entry->id;
+        bin->nargs = entry->nargs;
+
+        for (osal_uint32_t i = 0u; i < entry->nargs; ++i) {
+            if ((entry->kinds[i] == LIBOSAL_IO_FMT_ARG_STR) && (args[i] < shm->max_message_size)) {
+                (void)memcpy(&rec->msg[off], strs[i], args[i]);
+                rec->msg[off + args[i]] = '\0';
+                off += args[i] + 1u;
+            }
+
+            bin->args[i] = args[i];
+        }
+
+        rec->msg[len] = '\0';
+        rec->type = LIBOSAL_IO_SHM_REC_BINARY;
+        rec->len = (osal_uint32_t)len;
+
+        osal_io_shm_publish(ring, rec, pos);
+    }
+
+    return ret;
+}
 
 // Get next message printed to shm.
 osal_retval_t osal_io_shm_get_message(osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE],
         const osal_timer_t *to)
 {
+    assert(msg != NULL);
+
+    osal_size_t cnt;
+    // cppcheck-suppress misra-c2012-11.3
+    return osal_io_shm_get_messages((osal_char_t (*)[LIBOSAL_IO_SHM_MAX_MSG_SIZE])msg, 1u, &cnt, to);
+}
+
+// Get all available messages printed to shm.
+osal_retval_t osal_io_shm_get_messages(osal_char_t msgs[][LIBOSAL_IO_SHM_MAX_MSG_SIZE],
+        const osal_size_t max_msgs, osal_size_t *cnt, const osal_timer_t *to)
+{
+    assert(msgs != NULL);
+    assert(cnt != NULL);
+
     osal_retval_t ret = OSAL_ERR_UNAVAILABLE;
+    osal_io_shm_t *shm = osal_io_shm_buffer;
+    *cnt = 0u;
 
-    if (osal_io_shm_buffer->act_printed == osal_io_shm_buffer->act_written) {
-        if (to != NULL) {
-            (void)osal_semaphore_timedwait(&osal_io_shm_buffer->sem, to);
+    if (shm != NULL) {
+        osal_io_shm_claim_t claim;
+        osal_io_shm_rec_t *rec;
+
+        osal_io_shm_claim(shm, max_msgs, &claim);
+
+        if ((claim.total == 0u) && (max_msgs > 0u) && (to != NULL)) {
+            if (osal_io_shm_wait(shm, to) == OSAL_ERR_INVALID_PARAM) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            }
+
+            osal_io_shm_claim(shm, max_msgs, &claim);
+        }
+
+        while ((rec = osal_io_shm_claim_next(shm, &claim)) != NULL) {
+            osal_io_shm_copy(shm, rec, msgs[*cnt], LIBOSAL_IO_SHM_MAX_MSG_SIZE);
+            (*cnt)++;
+        }
+
+        osal_io_shm_release(shm, &claim);
+
+        if (*cnt > 0u) {
+            ret = OSAL_OK;
         }
     }
 
-    if (osal_io_shm_buffer->act_printed != osal_io_shm_buffer->act_written) {
-        osal_io_shm_buffer->act_printed = (osal_io_shm_buffer->act_printed + 1) % osal_io_shm_buffer->max_messages;
-        osal_char_t *tmp = osal_io_shm_buffer->msgs + (osal_io_shm_buffer->act_printed * osal_io_shm_buffer->max_message_size);
-        strncpy(msg, tmp, osal_io_shm_buffer->max_message_size);
-        ret = OSAL_OK;
+    return ret;
+}
+
+// Get all available messages printed to shm without copying.
+osal_retval_t osal_io_shm_acquire_messages(osal_io_shm_msg_t *msgs, const osal_size_t max_msgs, 
+        osal_size_t *cnt, const osal_timer_t *to)
+{
+    assert(msgs != NULL);
+    assert(cnt != NULL);
+
+    osal_retval_t ret = OSAL_ERR_UNAVAILABLE;
+    osal_io_shm_t *shm = osal_io_shm_buffer;
+    osal_io_shm_claim_t *claim = &osal_io_shm_acquired;
+    osal_size_t max = max_msgs < LIBOSAL_IO_SHM_MAX_ACQUIRE ? max_msgs : LIBOSAL_IO_SHM_MAX_ACQUIRE;
+    osal_io_shm_rec_t *rec;
+    *cnt = 0u;
+
+    if (claim->total != 0u) {
+        ret = OSAL_ERR_BUSY;
+    } else if (shm != NULL) {
+        osal_io_shm_claim(shm, max, claim);
+
+        if ((claim->total == 0u) && (max > 0u) && (to != NULL)) {
+            if (osal_io_shm_wait(shm, to) == OSAL_ERR_INVALID_PARAM) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            }
+
+            osal_io_shm_claim(shm, max, claim);
+        }
+
+        while ((rec = osal_io_shm_claim_next(shm, claim)) != NULL) {
+            msgs[*cnt].timestamp = rec->timestamp;
+            msgs[*cnt].tid = rec->tid;
+            msgs[*cnt].level = rec->level;
+            msgs[*cnt].tag = rec->tag != 0u ? osal_io_shm_fmt_string(shm, rec->tag - 1u) : NULL;
+
+            if (rec->type == LIBOSAL_IO_SHM_REC_BINARY) {
+                // binary records are smaller than their text, format aside
+                osal_io_shm_decode(shm, rec, osal_io_shm_decoded[*cnt], LIBOSAL_IO_SHM_MAX_MSG_SIZE);
+                msgs[*cnt].msg = osal_io_shm_decoded[*cnt];
+                msgs[*cnt].len = strlen(osal_io_shm_decoded[*cnt]);
+            } else {
+                msgs[*cnt].msg = rec->msg;
+                msgs[*cnt].len = rec->len;
+            }
+
+            (*cnt)++;
+        }
+
+        if (*cnt > 0u) {
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+// Release messages returned by osal_io_shm_acquire_messages.
+osal_retval_t osal_io_shm_commit_messages(osal_void_t) {
+    osal_retval_t ret = OSAL_OK;
+    osal_io_shm_t *shm = osal_io_shm_buffer;
+
+    if ((shm == NULL) || (osal_io_shm_acquired.total == 0u)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        osal_io_shm_release(shm, &osal_io_shm_acquired);
+    }
+
+    return ret;
+}
+
+// Get statistics of shm.
+osal_retval_t osal_io_shm_get_stats(osal_io_shm_stats_t *stats) {
+    assert(stats != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_io_shm_t *shm = osal_io_shm_buffer;
+
+    if (shm == NULL) {
+        ret = OSAL_ERR_UNAVAILABLE;
+    } else {
+        (void)memset(stats, 0, sizeof(*stats));
+        stats->num_rings = shm->num_rings;
+        stats->size = shm->ring_size;
+
+        for (osal_uint32_t r = 0u; r < shm->num_rings; ++r) {
+            osal_io_shm_ring_t *ring = osal_io_shm_ring(shm, r);
+            osal_uint64_t hwm = __atomic_load_n(&ring->high_water_mark, __ATOMIC_RELAXED);
+
+            stats->messages += __atomic_load_n(&ring->messages, __ATOMIC_RELAXED);
+            stats->bytes += __atomic_load_n(&ring->bytes, __ATOMIC_RELAXED);
+            stats->dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+
+            if (hwm > stats->high_water_mark) {
+                stats->high_water_mark = hwm;
+            }
+        }
     }
 
     return ret;
 }
 
 osal_retval_t osal_io_shm_setup(const osal_char_t *shm_name, const osal_size_t max_msgs, const osal_size_t max_msg_size) 
+{
+    return osal_io_shm_setup_attr(shm_name, max_msgs, max_msg_size, NULL);
+}
+
+osal_retval_t osal_io_shm_setup_attr(const osal_char_t *shm_name, const osal_size_t max_msgs, 
+        const osal_size_t max_msg_size, const osal_io_shm_attr_t *attr) 
 {
     assert(shm_name != NULL);
+    assert(max_msgs > 0u);
+    assert(max_msg_size > 0u);
 
     osal_shm_attr_t shm_attr_msr = OSAL_SHM_ATTR__FLAG__RDWR | OSAL_SHM_ATTR__FLAG__MAP;
     shm_attr_msr |= 0666 << OSAL_SHM_ATTR__MODE__SHIFT;
-    osal_size_t expected_shm_size = sizeof(osal_io_shm) + (max_msg_size * max_msgs);
+    // same budget as max_msgs messages of maximum size, but shared by records
+    // of variable length. at least two of them, so a wrapping record fits.
+    osal_size_t ring_size = ((sizeof(osal_io_shm_rec_t) + max_msg_size + 7u) & ~(osal_size_t)7u) * 
+        (max_msgs > 1u ? max_msgs : 2u);
+    osal_uint32_t num_rings = 1u;
 
-    osal_retval_t local_retval = osal_shm_open(&osal_io_shm, shm_name, &shm_attr_msr, expected_shm_size);
-        
-    if (local_retval != OSAL_OK) {
-        osal_printf("shared memory %s does not exists, try creating a new one\n", shm_name);
+    if (attr != NULL) {
+        num_rings += (*attr & OSAL_IO_SHM_ATTR__TASK_RINGS__MASK) >> OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT;
+    }
+
+    osal_size_t expected_shm_size = sizeof(osal_io_shm_t) + 
+        (num_rings * (sizeof(osal_io_shm_ring_t) + ring_size)) + LIBOSAL_IO_SHM_FMT_TABLE_SIZE;
+
+    osal_retval_t local_retval = OSAL_ERR_INVALID_PARAM;
+
+    // messages printed during setup go to the previous shm, never block on it
+    osal_io_shm_attr_t prev_attr = osal_io_shm_attr;
+    osal_io_shm_attr &= ~OSAL_IO_SHM_ATTR__OVERFLOW__MASK;
 
-        shm_attr_msr |= OSAL_SHM_ATTR__FLAG__CREAT;
+    if (num_rings <= LIBOSAL_IO_SHM_MAX_RINGS) {
         local_retval = osal_shm_open(&osal_io_shm, shm_name, &shm_attr_msr, expected_shm_size);
-    }
+        
+        if (local_retval != OSAL_OK) {
+            osal_printf("shared memory %s does not exists, try creating a new one\n", shm_name);
+
+            shm_attr_msr |= OSAL_SHM_ATTR__FLAG__CREAT;
+            local_retval = osal_shm_open(&osal_io_shm, shm_name, &shm_attr_msr, expected_shm_size);
+        }
 
-    if (local_retval != OSAL_OK) {
-        osal_printf("osal_shm_open(%p, %s, %p) returned error: %d\n", 
-                &osal_io_shm, shm_name, &shm_attr_msr, local_retval);
-    } else {
-        osal_void_t *tmp = NULL;
-        osal_shm_map_attr_t map_attr;
-        map_attr = OSAL_SHM_MAP_ATTR__PROT_WRITE | OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__SHARED;
-        local_retval = osal_shm_map(&osal_io_shm, &map_attr, (osal_void_t **)&tmp);
         if (local_retval != OSAL_OK) {
-            osal_printf("osal_shm_map(%p, %p) returned error: %d\n", &osal_io_shm, &tmp, local_retval);
+            osal_printf("osal_shm_open(%p, %s, %p) returned error: %d\n", 
+                    &osal_io_shm, shm_name, &shm_attr_msr, local_retval);
         } else {
-            osal_printf("osal_io_shm: opened and mapped successfully!\n");
-            osal_io_shm_buffer = (osal_io_shm_t *)tmp;
-    
-            if (osal_io_shm_buffer->magic == LIBOSAL_IO_SHM_MAGIC) {
-                osal_printf("osal_io_shm: found magic, skipping initialization.\n");
-                osal_printf("osal_io_shm: maximum number of messages -> %" PRIu64 "\n", osal_io_shm_buffer->max_messages); 
-                osal_printf("osal_io_shm: maximum length of messages -> %" PRIu64 "\n", osal_io_shm_buffer->max_message_size); 
+            osal_void_t *tmp = NULL;
+            osal_shm_map_attr_t map_attr;
+            map_attr = OSAL_SHM_MAP_ATTR__PROT_WRITE | OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__SHARED;
+            local_retval = osal_shm_map(&osal_io_shm, &map_attr, (osal_void_t **)&tmp);
+            if (local_retval != OSAL_OK) {
+                osal_printf("osal_shm_map(%p, %p) returned error: %d\n", &osal_io_shm, &tmp, local_retval);
             } else {
-                osal_io_shm_buffer->max_messages = max_msgs;
-                osal_io_shm_buffer->max_message_size = max_msg_size;
+                osal_printf("osal_io_shm: opened and mapped successfully!\n");
+                osal_io_shm_t *shm = (osal_io_shm_t *)tmp;
+    
+                if (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) == LIBOSAL_IO_SHM_MAGIC) {
+                    osal_printf("osal_io_shm: found magic, skipping initialization.\n");
+                    osal_printf("osal_io_shm: ring size -> %" PRIu64 " bytes\n", shm->ring_size); 
+                    osal_printf("osal_io_shm: maximum length of messages -> %" PRIu64 "\n", shm->max_message_size); 
+                    osal_printf("osal_io_shm: number of task rings -> %u\n", shm->num_rings - 1u); 
+
+                    // the layout is fixed by the creator of the shm
+                    if ((num_rings > 1u) && (num_rings != shm->num_rings)) {
+                        osal_printf("osal_io_shm: warning: requested %u task rings, existing shared memory has %u\n",
+                                num_rings - 1u, shm->num_rings - 1u);
+                    }
+                } else if (osal_io_shm.size < expected_shm_size) {
+                    osal_printf("osal_io_shm: existing shared memory too small (%" PRIu64 " < %" PRIu64 ")\n",
+                            osal_io_shm.size, expected_shm_size);
+                    local_retval = OSAL_ERR_INVALID_PARAM;
+                } else {
+                    shm->num_rings = num_rings;
+                    shm->ring_size = ring_size;
+                    shm->max_message_size = max_msg_size;
+                    shm->fmt_table_size = LIBOSAL_IO_SHM_FMT_TABLE_SIZE;
+
+                    for (osal_uint32_t r = 0u; r < num_rings; ++r) {
+                        osal_io_shm_ring_t *ring = osal_io_shm_ring(shm, r);
+
+                        (void)memset(osal_io_shm_rec(shm, ring, 0u), 0, ring_size);
+
+                        ring->write_pos = 0u;
+                        ring->read_pos = 0u;
+                        ring->free_pos = 0u;
+                        ring->owner = 0u;
+                        ring->messages = 0u;
+                        ring->bytes = 0u;
+                        ring->dropped = 0u;
+                        ring->high_water_mark = 0u;
+                    }
+
+                    shm->fmt_table_pos = 0u;
+                    shm->wake = 0u;
+                    shm->space_wake = 0u;
+
+                    osal_semaphore_attr_t tmp_semaphore_attr = OSAL_SEMAPHORE_ATTR__PROCESS_SHARED;
+                    osal_semaphore_init(&shm->sem, &tmp_semaphore_attr, 0);
+
+                    __atomic_store_n(&shm->magic, LIBOSAL_IO_SHM_MAGIC, __ATOMIC_RELEASE);
+                }
+
+                if (local_retval == OSAL_OK) {
+                    // format ids and task rings of a previous shm are not valid anymore
+                    (void)__atomic_add_fetch(&osal_io_shm_generation, 1u, __ATOMIC_RELEASE);
+                    osal_io_shm_acquired.total = 0u;
+                    osal_io_shm_attr = attr != NULL ? *attr : 0u;
+                    osal_io_shm_buffer = shm;
+                }
+            }
+        }
+    }
+
+    if (local_retval != OSAL_OK) {
+        osal_io_shm_attr = prev_attr;
+    }
+
+    return local_retval;
+}
+
+//! \brief Return id of calling task as owner of a task ring.
+static osal_uint32_t osal_io_shm_owner_id(osal_void_t) {
+    osal_uint32_t tid = osal_io_get_task_id();
+
+    // without task ids rings can not be told apart, but still be claimed
+    return tid != 0u ? tid : 1u;
+}
+
+#ifdef LIBOSAL_BUILD_POSIX
+//! \brief Release task ring of an exiting task.
+/*!
+ * \param[in]   arg     Task ring owned by the exiting task.
+ */
+static void osal_io_shm_task_ring_release(void *arg) {
+    // cppcheck-suppress misra-c2012-11.5
+    osal_io_shm_ring_t *ring = (osal_io_shm_ring_t *)arg;
+
+    osal_uint32_t owner = osal_io_shm_owner_id();
+
+    // a ring of a previous shm setup is gone already
+    if (osal_io_shm_task_ring_generation == __atomic_load_n(&osal_io_shm_generation, __ATOMIC_ACQUIRE)) {
+        (void)__atomic_compare_exchange_n(&ring->owner, &owner, 0u, 
+                0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+}
+
+//! \brief Forget task id and task ring of the parent in a forked child.
+static void osal_io_shm_task_ring_atfork(void) {
+    osal_io_task_id = 0u;
+    osal_io_shm_task_ring_generation = 0u;
+}
+
+//! \brief Create key releasing task rings on task exit.
+static void osal_io_shm_task_ring_key_create(void) {
+    (void)pthread_key_create(&osal_io_shm_task_ring_key, osal_io_shm_task_ring_release);
+    (void)pthread_atfork(NULL, NULL, osal_io_shm_task_ring_atfork);
+}
+#endif
+
+//! \brief Check if owner of a task ring has died.
+/*!
+ * A writer which crashed or left with _exit never released its ring.
+ *
+ * \param[in]   tid     Task id of owner.
+ *
+ * \return 1 if \p tid does not exist any more, 0 otherwise.
+ */
+static int osal_io_shm_owner_dead(osal_uint32_t tid) {
+    int ret = 0;
+
+#ifdef LIBOSAL_BUILD_POSIX
+    ret = ((kill((pid_t)tid, 0) == -1) && (errno == ESRCH)) ? 1 : 0;
+#else
+    (void)tid;
+#endif
+
+    return ret;
+}
+
+//! \brief Return ring to be used by calling task.
+/*!
+ * On first use a task tries to take ownership of a free task ring, if
+ * there is none left it takes over a ring whose owner has died or uses 
+ * the shared ring. Task rings are released again when their task exits.
+ *
+ * \param[in]   shm     Pointer to shm.
+ *
+ * \return Ring of calling task.
+ */
+static osal_io_shm_ring_t *osal_io_shm_writer_ring(osal_io_shm_t *shm) {
+    osal_uint32_t gen = __atomic_load_n(&osal_io_shm_generation, __ATOMIC_ACQUIRE);
+
+    if (osal_io_shm_task_ring_generation != gen) {
+        osal_io_shm_ring_t *ring = osal_io_shm_ring(shm, 0u);
+        osal_uint32_t tid = osal_io_shm_owner_id();
+
+#ifdef LIBOSAL_BUILD_POSIX
+        (void)pthread_once(&osal_io_shm_task_ring_once, osal_io_shm_task_ring_key_create);
+#endif
+
+        // free rings first, checking owners for dead ones needs a syscall each
+        for (osal_uint32_t pass = 0u; (pass < 2u) && (ring == osal_io_shm_ring(shm, 0u)); ++pass) {
+            for (osal_uint32_t r = 1u; r < shm->num_rings; ++r) {
+                osal_io_shm_ring_t *tmp = osal_io_shm_ring(shm, r);
+                osal_uint32_t owner = __atomic_load_n(&tmp->owner, __ATOMIC_RELAXED);
+
+                // a ring still owned by the calling task stems from a previous setup of the same shm
+                if ((owner == 0u) || ((owner == tid) && (osal_io_get_task_id() != 0u)) ||
+                        ((pass == 1u) && (owner != tid) && (osal_io_shm_owner_dead(owner) != 0))) {
+                    if (__atomic_compare_exchange_n(&tmp->owner, &owner, tid, 
+                                0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                        ring = tmp;
+                        break;
+                    }
+                }
+            }
+        }
+
+        osal_io_shm_task_ring = ring;
+        osal_io_shm_task_ring_generation = gen;
+
+#ifdef LIBOSAL_BUILD_POSIX
+        (void)pthread_setspecific(osal_io_shm_task_ring_key, 
+                (ring != osal_io_shm_ring(shm, 0u)) ? ring : NULL);
+#endif
+    }
+
+    return osal_io_shm_task_ring;
+}
+
+//! \brief Format and print data with log level and tag.
+/*!
+ * \param[in]   level   Log level.
+ * \param[in]   tag     Tag, may be NULL.
+ * \param[in]   fmt     Print format.
+ * \param[in]   va      Arguments.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_io_vlog(osal_uint32_t level, const osal_char_t *tag, const osal_char_t *fmt, va_list va) {
+    osal_retval_t ret = OSAL_OK;
+    osal_io_shm_t *shm = osal_io_shm_buffer;
+    const osal_io_fmt_cache_t *entry = NULL;
+    osal_uint32_t tag_id = 0u;
+    // disabled levels are neither formatted nor published
+    osal_bool_t enabled = (level <= osal_io_get_log_level()) ? 1u : 0u;
+
+    if ((shm != NULL) && (enabled != 0u)) {
+        if (tag != NULL) {
+            tag_id = osal_io_tag_lookup(shm, tag);
+        }
+
+        if ((osal_io_shm_attr & OSAL_IO_SHM_ATTR__BINARY) != 0u) {
+            entry = osal_io_fmt_lookup(shm, fmt);
+        }
+    }
 
-                osal_io_shm_buffer->act_printed = 0;
-                osal_io_shm_buffer->act_written = 0;
+    if (enabled == 0u) {
+        // discarded
+    } else if (entry != NULL) {
+        ret = osal_io_shm_push_binary(shm, osal_io_shm_writer_ring(shm), level, tag_id, entry, va);
+        osal_io_shm_signal(shm);
+    } else {
+        char buf[512];
+        int len = 0;
 
-                osal_mutex_attr_t tmp_mutex_attr = OSAL_MUTEX_ATTR__ROBUST | OSAL_MUTEX_ATTR__PROCESS_SHARED;
-                osal_mutex_init(&osal_io_shm_buffer->mtx, &tmp_mutex_attr);
+        if ((shm == NULL) && (tag != NULL)) {
+            len = snprintf(buf, sizeof(buf), "%s: ", tag);
+            if ((len < 0) || ((osal_size_t)len >= sizeof(buf))) {
+                len = 0;
+            }
+        }
 
-                osal_semaphore_attr_t tmp_semaphore_attr = OSAL_SEMAPHORE_ATTR__PROCESS_SHARED;
-                osal_semaphore_init(&osal_io_shm_buffer->sem, &tmp_semaphore_attr, 0);
+        int fmt_len = vsnprintf(&buf[len], sizeof(buf) - (osal_size_t)len, fmt, va);
+        if (fmt_len > 0) {
+            len += fmt_len;
+        }
 
-                osal_io_shm_buffer->magic = LIBOSAL_IO_SHM_MAGIC;
-                osal_io_shm_buffer->new_msg = 0;
+        if (shm != NULL) {
+            if ((osal_size_t)len >= sizeof(buf)) {
+                len = sizeof(buf) - 1u;
             }
+
+            ret = osal_io_shm_push(shm, osal_io_shm_writer_ring(shm), level, tag_id, buf, (osal_size_t)len);
+            osal_io_shm_signal(shm);
+        } else {
+            (void)osal_puts(buf);
         }
     }
 
-    return OSAL_OK;
+    return ret;
 }
 
 //! \brief Format and print data.
@@ -151,35 +1812,41 @@ osal_retval_t osal_io_shm_setup(const osal_char_t *shm_name, const osal_size_t m
 osal_retval_t osal_printf(const osal_char_t *fmt, ...) {
     assert(fmt != NULL);
 
-    char buf[512];
-
     // cppcheck-suppress misra-c2012-17.1
     va_list va;
-    osal_retval_t ret = OSAL_OK;
 
     // cppcheck-suppress misra-c2012-17.1
     va_start(va, fmt);
-
-    (void)vsnprintf(buf, 512, fmt, va);
-    
+    osal_retval_t ret = osal_io_vlog(OSAL_IO_LOG_LEVEL__INFO, NULL, fmt, va);
     // cppcheck-suppress misra-c2012-17.1
     va_end(va);
 
-    if (osal_io_shm_buffer != NULL) {
-        osal_uint32_t next_write = (osal_io_shm_buffer->act_written + 1) % osal_io_shm_buffer->max_messages;
-        char *tmp = osal_io_shm_buffer->msgs + (next_write * osal_io_shm_buffer->max_message_size);
+    return ret;
+}
+
+// Format and print data with log level and tag.
+osal_retval_t osal_log_printf(osal_uint32_t level, const osal_char_t *tag, const osal_char_t *fmt, ...) {
+    assert(fmt != NULL);
 
-        if (next_write == osal_io_shm_buffer->act_printed) {
-            osal_io_shm_buffer->act_printed = (osal_io_shm_buffer->act_printed + 1) % osal_io_shm_buffer->max_messages;
-        }
+    // cppcheck-suppress misra-c2012-17.1
+    va_list va;
 
-        strncpy(tmp, buf, osal_io_shm_buffer->max_message_size);
-        osal_io_shm_buffer->act_written = next_write;
-        osal_semaphore_post(&osal_io_shm_buffer->sem);
-    } else {
-        (void)osal_puts(buf);
-    }
+    // cppcheck-suppress misra-c2012-17.1
+    va_start(va, fmt);
+    osal_retval_t ret = osal_io_vlog(level, tag, fmt, va);
+    // cppcheck-suppress misra-c2012-17.1
+    va_end(va);
 
     return ret;
 }
 
+// Set log level.
+osal_void_t osal_io_set_log_level(osal_uint32_t level) {
+    __atomic_store_n(&osal_io_log_level, level, __ATOMIC_RELAXED);
+}
+
+// Get log level.
+osal_uint32_t osal_io_get_log_level(osal_void_t) {
+    return __atomic_load_n(&osal_io_log_level, __ATOMIC_RELAXED);
+}
+
@@ -29,6 +29,10 @@
 
 #include <libosal/osal.h>
 
+#ifdef LIBOSAL_BUILD_POSIX
+#include "posix/tsc.h"
+#endif
+
 #ifdef LIBOSAL_BUILD_WIN32
 #define ATTR_CONSTRUCTOR_WEAK
 #else
@@ -37,6 +41,9 @@
 
 //! Initialize OSAL internals.
 void ATTR_CONSTRUCTOR_WEAK osal_init(void) {
+#ifdef LIBOSAL_BUILD_POSIX
+    osal_timer_tsc_init();
+#endif
 }
 
 //! Destroy OSAL internals.
@@ -51,6 +51,7 @@ osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
 
     timer->sec = local_time / (osal_uint64_t)1E9;
     timer->nsec = local_time % (osal_uint64_t)1E9;
+    osal_timer_set_clock(timer, osal_timer_get_clock_source());
 
     return ret;
 }
@@ -81,6 +82,7 @@ void osal_timer_init(osal_timer_t *timer, osal_uint64_t timeout) {
     osal_timer_t b;
     a.sec = local_time / (osal_uint64_t)1E9;
     a.nsec = local_time % (osal_uint64_t)1E9;
+    osal_timer_set_clock(&a, osal_timer_get_clock_source());
 
     b.sec = (timeout / NSEC_PER_SEC);
     b.nsec = (timeout % NSEC_PER_SEC);
@@ -88,11 +90,18 @@ void osal_timer_init(osal_timer_t *timer, osal_uint64_t timeout) {
     osal_timer_add(&a, &b, timer);
 }
 
+// initialize timer on given clock with timeout, Pikeos has only one clock
+osal_retval_t osal_timer_init_clock(osal_timer_t *timer, int clock_id, osal_uint64_t timeout) {
+    (void)clock_id;
+    osal_timer_init(timer, timeout);
+    return OSAL_OK;
+}
+
 // checks if timer is expired
 osal_retval_t osal_timer_expired(osal_timer_t *timer) {
     assert(timer != NULL);
 
-    osal_timer_t act = { 0, 0 };
+    osal_timer_t act = { 0, 0, 0 };
     osal_retval_t ret = OSAL_OK;
     ret = osal_timer_gettime(&act);    
 
@@ -28,11 +28,73 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#define _GNU_SOURCE             /* ppoll */
+
 #include <libosal/osal.h>
 #include <assert.h>
 #include <errno.h>
 #include <time.h>
 
+#include "clock.h"
+
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+#include <sys/eventfd.h>
+#include "eventfd.h"
+#endif
+
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+#include "futex.h"
+
+/* Futex word states. A waiter which had to sleep always leaves
+ * LIBOSAL_BINARY_SEMAPHORE__CONTENDED behind, so that the next post
+ * wakes any other sleeping waiter. Post and wait without contention
+ * only cost a single atomic operation. */
+#define LIBOSAL_BINARY_SEMAPHORE__EMPTY         0u      //!< \brief Not posted, no waiters.
+#define LIBOSAL_BINARY_SEMAPHORE__POSTED        1u      //!< \brief Posted.
+#define LIBOSAL_BINARY_SEMAPHORE__CONTENDED     2u      //!< \brief Not posted, waiters may sleep.
+
+//! \brief Consume posted state without blocking.
+/*!
+ * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
+ *
+ * \return 1 if state was posted, 0 otherwise.
+ */
+static inline int osal_binary_semaphore_futex_trywait(osal_binary_semaphore_t *sem) {
+    osal_uint32_t expected = LIBOSAL_BINARY_SEMAPHORE__POSTED;
+
+    return __atomic_compare_exchange_n(&sem->value, &expected, LIBOSAL_BINARY_SEMAPHORE__EMPTY, 
+            0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ? 1 : 0;
+}
+
+//! \brief Wait on futex word for posted state.
+/*!
+ * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \return OK, OSAL_ERR_TIMEOUT or OSAL_ERR_INVALID_PARAM.
+ */
+static osal_retval_t osal_binary_semaphore_futex_wait(osal_binary_semaphore_t *sem, const osal_timer_t *to) {
+    osal_retval_t ret = OSAL_OK;
+
+    if (osal_binary_semaphore_futex_trywait(sem) == 0) {
+        for (;;) {
+            // announce sleeper, consumes a post that raced in between
+            if (__atomic_exchange_n(&sem->value, LIBOSAL_BINARY_SEMAPHORE__CONTENDED, 
+                        __ATOMIC_ACQUIRE) == LIBOSAL_BINARY_SEMAPHORE__POSTED) {
+                break;
+            }
+
+            ret = osal_futex_wait(&sem->value, LIBOSAL_BINARY_SEMAPHORE__CONTENDED, sem->shared, to);
+            if (ret != OSAL_OK) {
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+#endif
+
 #define timespec_add(tvp, sec, nsec) { \
     (tvp)->tv_nsec += (nsec); \
     (tvp)->tv_sec += (sec); \
@@ -52,17 +114,59 @@
 osal_retval_t osal_binary_semaphore_init(osal_binary_semaphore_t *sem, const osal_binary_semaphore_attr_t *attr) {
     assert(sem != NULL);
 
-    (void)attr;
+    osal_retval_t ret = OSAL_OK;
+    osal_binary_semaphore_attr_t local_attr = 0;
+
+    if (attr != NULL) {
+        local_attr = *attr;
+    }
 
     sem->value = 0;
+    sem->efd = -1;
+    sem->shared = 0;
 
-    pthread_condattr_t cond_attr;
-    pthread_condattr_init(&cond_attr);
-    pthread_condattr_setclock(&cond_attr, osal_timer_get_clock_source());
+    if ((local_attr & OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED) == OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED) {
+        sem->shared = 1;
+    }
 
-    pthread_mutex_init(&sem->posix_mtx, NULL);
-    pthread_cond_init(&sem->posix_cond, &cond_attr);
-    return OSAL_OK;
+    if ((local_attr & OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE) == OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE) {
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+        if (sem->shared == 1) {
+            // an eventfd can not be shared through shared memory
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            // no semaphore mode, a read resets the counter which gives binary semantics
+            sem->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (sem->efd < 0) {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
+        }
+#else
+        ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+    } else {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H != 1
+        pthread_mutexattr_t mtx_attr;
+        pthread_condattr_t cond_attr;
+
+        pthread_mutexattr_init(&mtx_attr);
+        pthread_condattr_init(&cond_attr);
+        pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+
+        if (sem->shared == 1) {
+            pthread_mutexattr_setpshared(&mtx_attr, PTHREAD_PROCESS_SHARED);
+            pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+        }
+
+        pthread_mutex_init(&sem->posix_mtx, &mtx_attr);
+        pthread_cond_init(&sem->posix_cond, &cond_attr);
+
+        pthread_mutexattr_destroy(&mtx_attr);
+        pthread_condattr_destroy(&cond_attr);
+#endif
+    }
+
+    return ret;
 }
 
 //! \brief Post a binary_semaphore.
@@ -74,15 +178,32 @@ osal_retval_t osal_binary_semaphore_init(osal_binary_semaphore_t *sem, const osa
 osal_retval_t osal_binary_semaphore_post(osal_binary_semaphore_t *sem) {
     assert(sem != NULL);
 
-    pthread_mutex_lock(&sem->posix_mtx);
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_post(sem->efd);
+    } else
+#endif
+    {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        if (__atomic_exchange_n(&sem->value, LIBOSAL_BINARY_SEMAPHORE__POSTED, 
+                    __ATOMIC_RELEASE) == LIBOSAL_BINARY_SEMAPHORE__CONTENDED) {
+            osal_futex_wake(&sem->value, 1, sem->shared);
+        }
+#else
+        pthread_mutex_lock(&sem->posix_mtx);
+
+        if (sem->value == 0) {
+            sem->value = 1;
+            pthread_cond_signal(&sem->posix_cond);
+        }
 
-    if (sem->value == 0) {
-        sem->value = 1;
-        pthread_cond_signal(&sem->posix_cond);
+        pthread_mutex_unlock(&sem->posix_mtx);
+#endif
     }
 
-    pthread_mutex_unlock(&sem->posix_mtx);
-    return OSAL_OK;
+    return ret;
 }
 
 //! \brief Wait for a binary_semaphore.
@@ -94,16 +215,30 @@ osal_retval_t osal_binary_semaphore_post(osal_binary_semaphore_t *sem) {
 osal_retval_t osal_binary_semaphore_wait(osal_binary_semaphore_t *sem) {
     assert(sem != NULL);
 
-    pthread_mutex_lock(&sem->posix_mtx);
+    osal_retval_t ret = OSAL_OK;
 
-    while (!sem->value) {
-        pthread_cond_wait(&sem->posix_cond, &sem->posix_mtx);
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_wait(sem->efd, 1, NULL);
+    } else
+#endif
+    {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        ret = osal_binary_semaphore_futex_wait(sem, NULL);
+#else
+        pthread_mutex_lock(&sem->posix_mtx);
+
+        while (!sem->value) {
+            pthread_cond_wait(&sem->posix_cond, &sem->posix_mtx);
+        }
+
+        sem->value = 0;
+
+        pthread_mutex_unlock(&sem->posix_mtx);
+#endif
     }
 
-    sem->value = 0;
-    
-    pthread_mutex_unlock(&sem->posix_mtx);
-    return OSAL_OK;
+    return ret;
 }
 
 //! \brief Wait for a binary_semaphore.
@@ -117,15 +252,28 @@ osal_retval_t osal_binary_semaphore_trywait(osal_binary_semaphore_t *sem) {
 
     osal_retval_t ret = OSAL_OK;
 
-    pthread_mutex_lock(&sem->posix_mtx);
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_wait(sem->efd, 0, NULL);
+    } else
+#endif
+    {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        if (osal_binary_semaphore_futex_trywait(sem) == 0) {
+            ret = OSAL_ERR_BUSY;
+        }
+#else
+        pthread_mutex_lock(&sem->posix_mtx);
 
-    if (sem->value == 0) {
-        ret = OSAL_ERR_BUSY;
-    } else {
-        sem->value = 0;
-    }
+        if (sem->value == 0) {
+            ret = OSAL_ERR_BUSY;
+        } else {
+            sem->value = 0;
+        }
 
-    pthread_mutex_unlock(&sem->posix_mtx);
+        pthread_mutex_unlock(&sem->posix_mtx);
+#endif
+    }
     
     return ret;
 }
@@ -142,13 +290,23 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
 
     osal_retval_t ret = OSAL_OK;
 
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_wait(sem->efd, to != NULL ? 1 : 0, to);
+        if (ret == OSAL_ERR_BUSY) {
+            ret = OSAL_ERR_TIMEOUT;
+        }
+    } else
+#endif
     if (to != NULL) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        ret = osal_binary_semaphore_futex_wait(sem, to);
+#else
         struct timespec ts;
-        ts.tv_sec = to->sec;
-        ts.tv_nsec = to->nsec;
+        ret = osal_timer_to_timespec(to, CLOCK_MONOTONIC, &ts);
 
         pthread_mutex_lock(&sem->posix_mtx);
-        while (!sem->value) {
+        while ((ret == OSAL_OK) && !sem->value) {
             int local_ret = pthread_cond_timedwait(&sem->posix_cond, &sem->posix_mtx, &ts);
             if (local_ret == ETIMEDOUT) {
                 ret = OSAL_ERR_TIMEOUT;
@@ -161,8 +319,9 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
         }
 
         pthread_mutex_unlock(&sem->posix_mtx);
+#endif
     } else {
-        if (sem->value == 0) {
+        if (__atomic_load_n(&sem->value, __ATOMIC_ACQUIRE) != 1) {
             ret = OSAL_ERR_TIMEOUT;
         }
     }
@@ -179,9 +338,41 @@ osal_retval_t osal_binary_semaphore_timedwait(osal_binary_semaphore_t *sem, cons
 osal_retval_t osal_binary_semaphore_destroy(osal_binary_semaphore_t *sem) {
     assert(sem != NULL);
 
-    pthread_mutex_destroy(&sem->posix_mtx);
-    pthread_cond_destroy(&sem->posix_cond);
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        (void)close(sem->efd);
+        sem->efd = -1;
+    } else
+#endif
+    {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H != 1
+        pthread_mutex_destroy(&sem->posix_mtx);
+        pthread_cond_destroy(&sem->posix_cond);
+#endif
+    }
 
     return OSAL_OK;
 }
 
+//! \brief Get pollable file descriptor of a binary_semaphore.
+/*!
+ * \param[in]   sem     Pointer to osal binary_semaphore structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_binary_semaphore_get_fd(osal_binary_semaphore_t *sem, osal_int32_t *fd) {
+    assert(sem != NULL);
+    assert(fd != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (sem->efd < 0) {
+        ret = OSAL_ERR_NOT_IMPLEMENTED;
+    } else {
+        *fd = sem->efd;
+    }
+
+    return ret;
+}
+
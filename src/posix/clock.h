@@ -0,0 +1,98 @@
+/**
+ * \file posix/clock.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL timeout clock helpers, internal use only.
+ *
+ * Conversion of absolute osal timeouts between clocks.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_CLOCK__H
+#define LIBOSAL_POSIX_CLOCK__H
+
+#include <libosal/types.h>
+#include <libosal/timer.h>
+
+#include <time.h>
+
+//! \brief Returns time left until absolute timeout.
+/*!
+ * \param[in]   to      Absolute timeout on its own clock.
+ * \param[out]  left    Returns time left in [ns], negative if expired.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid, \p left is 0.
+ */
+static inline osal_retval_t osal_timer_left_nsec(const osal_timer_t *to, osal_int64_t *left) {
+    osal_retval_t ret = OSAL_OK;
+    struct timespec now;
+
+    if (clock_gettime(osal_timer_clock(to), &now) != 0) {
+        *left = 0;
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        *left = ((osal_int64_t)to->sec - (osal_int64_t)now.tv_sec) * NSEC_PER_SEC + 
+            ((osal_int64_t)to->nsec - (osal_int64_t)now.tv_nsec);
+    }
+
+    return ret;
+}
+
+//! \brief Convert absolute osal timeout to timespec on clock \p clk.
+/*!
+ * A timeout on another clock is converted with the time left until it
+ * expires, so a step of either clock while waiting is not followed.
+ *
+ * \param[in]   to      Absolute timeout on its own clock.
+ * \param[in]   clk     Clock the returned timespec refers to.
+ * \param[out]  ts      Returns absolute timeout on \p clk, expired on error.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid.
+ */
+static inline osal_retval_t osal_timer_to_timespec(const osal_timer_t *to, clockid_t clk, struct timespec *ts) {
+    osal_retval_t ret = OSAL_OK;
+
+    if (osal_timer_clock(to) == clk) {
+        ts->tv_sec = (time_t)to->sec;
+        ts->tv_nsec = (long)to->nsec;
+    } else {
+        osal_int64_t left = 0;
+        struct timespec now = { 0, 0 };
+
+        ret = osal_timer_left_nsec(to, &left);
+        if (ret == OSAL_OK) {
+            (void)clock_gettime(clk, &now);
+        }
+
+        left = (left < 0) ? 0 : left;
+        left += ((osal_int64_t)now.tv_sec * NSEC_PER_SEC) + now.tv_nsec;
+        ts->tv_sec = (time_t)(left / NSEC_PER_SEC);
+        ts->tv_nsec = (long)(left % NSEC_PER_SEC);
+    }
+
+    return ret;
+}
+
+#endif /* LIBOSAL_POSIX_CLOCK__H */
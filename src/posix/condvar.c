@@ -33,6 +33,8 @@
 #include <errno.h>
 #include <time.h>
 
+#include "clock.h"
+
 #define timespec_add(tvp, sec, nsec) { \
     (tvp)->tv_nsec += (nsec); \
     (tvp)->tv_sec += (sec); \
@@ -52,18 +54,21 @@
 osal_retval_t osal_condvar_init(osal_condvar_t *cv, const osal_condvar_attr_t *attr) {
     assert(cv != NULL);
 
-    (void)attr;
-
     osal_retval_t ret = OSAL_OK;
     int local_ret;
 
+    cv->clock_id = CLOCK_MONOTONIC;
+    if ((attr != NULL) && ((*attr & OSAL_CONDVAR_ATTR__CLOCK_REALTIME) != 0u)) {
+        cv->clock_id = CLOCK_REALTIME;
+    }
+
     pthread_condattr_t cond_attr;
     local_ret = pthread_condattr_init(&cond_attr);
     if (local_ret != 0) {
         // should only return ENOMEM
         ret = OSAL_ERR_OUT_OF_MEMORY;
     } else {
-        local_ret = pthread_condattr_setclock(&cond_attr, osal_timer_get_clock_source());
+        local_ret = pthread_condattr_setclock(&cond_attr, cv->clock_id);
         if (local_ret != 0) {
             // should only return EINVAL
             ret = OSAL_ERR_INVALID_PARAM;
@@ -160,20 +165,21 @@ osal_retval_t osal_condvar_timedwait(osal_condvar_t *cv, osal_mutex_t *mtx, cons
     int local_ret;
 
     struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
-
-    do {
-        local_ret = pthread_cond_timedwait(&cv->posix_cond, &mtx->posix_mtx, &ts);
-        if (local_ret == ETIMEDOUT) {
-            ret = OSAL_ERR_TIMEOUT;
-            break;
-        } else if (local_ret == EINVAL) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else if (local_ret == EPERM) {
-            ret = OSAL_ERR_PERMISSION_DENIED;
-        }
-    } while (local_ret != 0);
+    ret = osal_timer_to_timespec(to, cv->clock_id, &ts);
+
+    if (ret == OSAL_OK) {
+        do {
+            local_ret = pthread_cond_timedwait(&cv->posix_cond, &mtx->posix_mtx, &ts);
+            if (local_ret == ETIMEDOUT) {
+                ret = OSAL_ERR_TIMEOUT;
+                break;
+            } else if (local_ret == EINVAL) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else if (local_ret == EPERM) {
+                ret = OSAL_ERR_PERMISSION_DENIED;
+            }
+        } while (local_ret != 0);
+    }
 
     return ret;
 }
@@ -0,0 +1,69 @@
+/**
+ * \file posix/cpu.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL cpu helpers, internal use only.
+ *
+ * Helpers for busy-waiting loops.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_CPU__H
+#define LIBOSAL_POSIX_CPU__H
+
+#include <libosal/types.h>
+
+//! \brief Hint to the cpu that the caller is busy-waiting.
+/*!
+ * Lowers power consumption and frees pipeline resources for a sibling 
+ * hyperthread, which may be the one we are waiting for.
+ */
+static inline osal_void_t osal_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+//! \brief Busy-wait with exponential backoff.
+/*!
+ * \param[in,out]   backoff     Current number of relax cycles, doubled up to \p max.
+ * \param[in]       max         Maximum number of relax cycles.
+ */
+static inline osal_void_t osal_cpu_backoff(osal_uint32_t *backoff, osal_uint32_t max) {
+    osal_uint32_t i;
+
+    for (i = 0u; i < *backoff; ++i) {
+        osal_cpu_relax();
+    }
+
+    if (*backoff < max) {
+        *backoff <<= 1u;
+    }
+}
+
+#endif /* LIBOSAL_POSIX_CPU__H */
+
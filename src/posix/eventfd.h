@@ -0,0 +1,143 @@
+/**
+ * \file posix/eventfd.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL eventfd helpers, internal use only.
+ *
+ * Eventfd backed waits for pollable osal objects.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_EVENTFD__H
+#define LIBOSAL_POSIX_EVENTFD__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/osal.h>
+#include <libosal/timer.h>
+
+#include "clock.h"
+
+#include <stdint.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+//! \brief Convert absolute timeout to relative ppoll timeout.
+/*!
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ * \param[out]  ts      Returns time left until \p to, 0 if it has expired.
+ * \param[out]  pts     Returns \p ts, NULL to wait forever.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid, \p ts is 0 then.
+ */
+static inline osal_retval_t osal_poll_timeout(const osal_timer_t *to, struct timespec *ts, 
+        const struct timespec **pts) {
+    osal_retval_t ret = OSAL_OK;
+    *pts = NULL;
+
+    if (to != NULL) {
+        osal_int64_t left = 0;
+        ret = osal_timer_left_nsec(to, &left);
+
+        left = (left < 0) ? 0 : left;
+        ts->tv_sec = (time_t)(left / NSEC_PER_SEC);
+        ts->tv_nsec = (long)(left % NSEC_PER_SEC);
+        *pts = ts;
+    }
+
+    return ret;
+}
+
+//! \brief Post eventfd.
+/*!
+ * \param[in]   fd      Eventfd.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static inline osal_retval_t osal_eventfd_post(int fd) {
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t val = 1u;
+
+    if (write(fd, &val, sizeof(val)) != (ssize_t)sizeof(val)) {
+        // EAGAIN if the counter would overflow
+        ret = (errno == EAGAIN) ? OSAL_ERR_OPERATION_FAILED : OSAL_ERR_INVALID_PARAM;
+    }
+
+    return ret;
+}
+
+//! \brief Wait on non-blocking eventfd.
+/*!
+ * Decrements a semaphore mode eventfd by one or resets a normal eventfd.
+ *
+ * \param[in]   fd      Eventfd opened with EFD_NONBLOCK.
+ * \param[in]   block   Wait for eventfd to become readable.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \retval OSAL_OK              On success.
+ * \retval OSAL_ERR_BUSY        Eventfd was not readable and \p block was 0.
+ * \retval OSAL_ERR_TIMEOUT     Eventfd was not readable until \p to.
+ * \retval OSAL_ERR_INVALID_PARAM   Eventfd or clock of \p to is invalid.
+ */
+static inline osal_retval_t osal_eventfd_wait(int fd, int block, const osal_timer_t *to) {
+    osal_retval_t ret = OSAL_ERR_BUSY;
+
+    for (;;) {
+        osal_uint64_t val;
+
+        if (read(fd, &val, sizeof(val)) == (ssize_t)sizeof(val)) {
+            ret = OSAL_OK;
+            break;
+        } else if (errno == EINTR) {
+            // retry read
+        } else if (errno != EAGAIN) {
+            ret = OSAL_ERR_INVALID_PARAM;
+            break;
+        } else if (block == 0) {
+            break;
+        } else {
+            // someone else may consume the event between poll and read, so loop
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            struct timespec ts;
+            const struct timespec *pts;
+
+            if (osal_poll_timeout(to, &ts, &pts) != OSAL_OK) {
+                ret = OSAL_ERR_INVALID_PARAM;
+                break;
+            }
+
+            if ((ppoll(&pfd, 1, pts, NULL) == 0) && (pts != NULL)) {
+                ret = OSAL_ERR_TIMEOUT;
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+#endif /* LIBOSAL_POSIX_EVENTFD__H */
+
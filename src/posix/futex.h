@@ -0,0 +1,114 @@
+/**
+ * \file posix/futex.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL futex helpers, internal use only.
+ *
+ * Thin wrappers around the Linux futex syscall.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_FUTEX__H
+#define LIBOSAL_POSIX_FUTEX__H
+
+#include <libosal/config.h>
+#include <libosal/types.h>
+#include <libosal/osal.h>
+#include <libosal/timer.h>
+
+#include "clock.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+//! \brief Wait on futex word.
+/*!
+ * Sleeps as long as \p uaddr contains \p val. Spurious wakeups are possible,
+ * the caller has to re-check its condition.
+ *
+ * \param[in]   uaddr   Pointer to futex word.
+ * \param[in]   val     Expected value of futex word.
+ * \param[in]   shared  Futex word may be shared between processes.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \retval OSAL_OK                  Woken up or \p uaddr did not contain \p val.
+ * \retval OSAL_ERR_TIMEOUT         Timeout expired.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid, did not wait.
+ */
+static inline osal_retval_t osal_futex_wait(osal_uint32_t *uaddr, osal_uint32_t val, 
+        int shared, const osal_timer_t *to) 
+{
+    osal_retval_t ret = OSAL_OK;
+    int op = FUTEX_WAIT_BITSET;
+    struct timespec ts;
+    struct timespec *p_ts = NULL;
+
+    if (shared == 0) {
+        op |= FUTEX_PRIVATE_FLAG;
+    }
+
+    if (to != NULL) {
+        p_ts = &ts;
+
+        // FUTEX_WAIT_BITSET timeouts are absolute on CLOCK_MONOTONIC by default
+        if (osal_timer_clock(to) == CLOCK_REALTIME) {
+            op |= FUTEX_CLOCK_REALTIME;
+            ret = osal_timer_to_timespec(to, CLOCK_REALTIME, &ts);
+        } else {
+            ret = osal_timer_to_timespec(to, CLOCK_MONOTONIC, &ts);
+        }
+    }
+
+    if (ret != OSAL_OK) {
+        // invalid timeout, do not wait at all
+    } else if (syscall(SYS_futex, uaddr, op, val, p_ts, NULL, FUTEX_BITSET_MATCH_ANY) == -1) {
+        if (errno == ETIMEDOUT) {
+            ret = OSAL_ERR_TIMEOUT;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Wake tasks waiting on futex word.
+/*!
+ * \param[in]   uaddr   Pointer to futex word.
+ * \param[in]   cnt     Maximum number of tasks to wake, INT_MAX wakes all.
+ * \param[in]   shared  Futex word may be shared between processes.
+ */
+static inline osal_void_t osal_futex_wake(osal_uint32_t *uaddr, int cnt, int shared) {
+    int op = FUTEX_WAKE;
+
+    if (shared == 0) {
+        op |= FUTEX_PRIVATE_FLAG;
+    }
+
+    (void)syscall(SYS_futex, uaddr, op, cnt, NULL, NULL, 0);
+}
+
+#endif /* LIBOSAL_POSIX_FUTEX__H */
+
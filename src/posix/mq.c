@@ -39,6 +39,604 @@
 #include <mqueue.h>
 #include <errno.h>
 
+#include "clock.h"
+
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+#include "futex.h"
+#endif
+
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define LIBOSAL_MQ_RING_MAGIC       0x00AFFE10u     //!< \brief Ring is initialized.
+#define LIBOSAL_MQ_RING_MAGIC_INIT  0x00AFFEFFu     //!< \brief Ring is being initialized.
+#define LIBOSAL_MQ_RING_CACHE_LINE  64u             //!< \brief Cache line size.
+#define LIBOSAL_MQ_RING_INIT_POLL   100000u         //!< \brief Poll interval waiting for initialization in [ns].
+#define LIBOSAL_MQ_RING_INIT_POLLS  10000u          //!< \brief Maximum polls waiting for initialization.
+#define LIBOSAL_MQ_RING_POLL_NSEC   100000u         //!< \brief Poll interval on full or empty ring without futex.
+
+//! \brief Slot of ring message queue.
+typedef struct osal_mq_ring_slot {
+    osal_uint64_t       seq;                //!< Twice the position the slot is ready for, + 1 if committed.
+    osal_uint32_t       len;                //!< Message length.
+    osal_uint32_t       prio;               //!< Message priority.
+    osal_char_t         msg[0];
+} osal_mq_ring_slot_t;
+
+//! \brief Ring message queue in shared memory.
+/*!
+ * Bounded multi-producer multi-consumer queue. Each slot carries a sequence
+ * number which tells whether it is ready to be written or read at a ring 
+ * position, so producers and consumers only contend on \p head and \p tail
+ * respectively. Both live on their own cache line. The sequence counts in
+ * steps of two per position, otherwise a slot committed at a position could
+ * not be told from a slot free at the next lap in a ring of one slot.
+ *
+ * A task blocking on a full or empty ring registers in \p space_waiters or
+ * \p data_waiters before sleeping on the futex \p space_wake or \p data_wake.
+ * The peer only issues a futex wake if there are waiters, and wakes one 
+ * waiter per message or slot. A waiter which was woken by a slot behind
+ * one which is not done yet goes back to sleep, so a waiter which claimed
+ * a slot after sleeping passes the wakeup on if the next slot is ready.
+ */
+typedef struct osal_mq_ring {
+    osal_uint32_t       magic;              //!< Ring is initialized.
+    osal_uint32_t       pad0;
+    osal_uint64_t       max_messages;       //!< Number of slots.
+    osal_uint64_t       max_message_size;   //!< Maximum message size.
+    osal_uint64_t       slot_size;          //!< Size of a slot in bytes.
+    osal_uint8_t        pad1[LIBOSAL_MQ_RING_CACHE_LINE - (4u * sizeof(osal_uint64_t))];
+    osal_uint64_t       head;               //!< Next position to be written by producers.
+    osal_uint32_t       space_wake;         //!< Futex to wake producers waiting for space.
+    osal_uint32_t       space_waiters;      //!< Number of producers waiting for space.
+    osal_uint8_t        pad2[LIBOSAL_MQ_RING_CACHE_LINE - (2u * sizeof(osal_uint64_t))];
+    osal_uint64_t       tail;               //!< Next position to be read by consumers.
+    osal_uint32_t       data_wake;          //!< Futex to wake consumers waiting for messages.
+    osal_uint32_t       data_waiters;       //!< Number of consumers waiting for messages.
+    osal_uint8_t        pad3[LIBOSAL_MQ_RING_CACHE_LINE - (2u * sizeof(osal_uint64_t))];
+    osal_uint8_t        slots[0];
+} osal_mq_ring_t;
+
+//! \brief Return slot of ring position.
+static osal_mq_ring_slot_t *osal_mq_ring_slot(osal_mq_ring_t *ring, osal_uint64_t pos) {
+    // cppcheck-suppress misra-c2012-11.3
+    return (osal_mq_ring_slot_t *)&ring->slots[(pos % ring->max_messages) * ring->slot_size];
+}
+
+//! \brief Wait on ring futex.
+/*!
+ * \param[in]   wake    Futex word.
+ * \param[in]   val     Value of \p wake read before re-checking the ring.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \retval OSAL_OK                  Woken up, ring has to be re-checked.
+ * \retval OSAL_ERR_TIMEOUT         Timeout expired.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid.
+ */
+static osal_retval_t osal_mq_ring_wait(osal_uint32_t *wake, osal_uint32_t val, const osal_timer_t *to) {
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+    ret = osal_futex_wait(wake, val, 1, to);
+#else
+    (void)wake;
+    (void)val;
+    osal_sleep(LIBOSAL_MQ_RING_POLL_NSEC);
+
+    if (to != NULL) {
+        osal_timer_t tmp = *to;
+        ret = osal_timer_expired(&tmp);
+    }
+#endif
+
+    return ret;
+}
+
+//! \brief Wake tasks waiting on ring futex.
+/*!
+ * \param[in]   wake        Futex word.
+ * \param[in]   waiters     Number of waiting tasks.
+ * \param[in]   cnt         Maximum number of tasks to wake.
+ */
+static osal_void_t osal_mq_ring_wake(osal_uint32_t *wake, osal_uint32_t *waiters, osal_size_t cnt) {
+    // pairs with the waiter registering before re-checking the ring
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(waiters, __ATOMIC_RELAXED) != 0u) {
+        (void)__atomic_fetch_add(wake, 1u, __ATOMIC_RELEASE);
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        osal_futex_wake(wake, (cnt < (osal_size_t)INT_MAX) ? (int)cnt : INT_MAX, 1);
+#else
+        (void)cnt;
+#endif
+    }
+}
+
+//! \brief Try to claim next slot of ring.
+/*!
+ * Producers claim slots which are free at \p head, consumers claim slots
+ * which were committed at \p tail.
+ *
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   cursor  Pointer to \p head or \p tail of ring.
+ * \param[in]   offset  Sequence offset of claimable slots, 0 for producers, 1 for consumers.
+ * \param[out]  slot    Claimed slot.
+ *
+ * \retval OSAL_OK          On success.
+ * \retval OSAL_ERR_BUSY    Ring is full or empty.
+ */
+static osal_retval_t osal_mq_ring_tryclaim(osal_mq_ring_t *ring, osal_uint64_t *cursor, 
+        osal_uint64_t offset, osal_mq_ring_slot_t **slot) 
+{
+    osal_retval_t ret = OSAL_ERR_BUSY;
+    osal_uint64_t pos = __atomic_load_n(cursor, __ATOMIC_RELAXED);
+
+    for (;;) {
+        osal_mq_ring_slot_t *tmp = osal_mq_ring_slot(ring, pos);
+        osal_uint64_t seq = __atomic_load_n(&tmp->seq, __ATOMIC_ACQUIRE);
+        osal_int64_t diff = (osal_int64_t)(seq - ((2u * pos) + offset));
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(cursor, &pos, pos + 1u, 
+                        0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *slot = tmp;
+                ret = OSAL_OK;
+                break;
+            }
+        } else if (diff < 0) {
+            // slot not yet released by a consumer or committed by a producer
+            break;
+        } else {
+            pos = __atomic_load_n(cursor, __ATOMIC_RELAXED);
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Check whether next slot of ring can be claimed.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   cursor  Pointer to \p head or \p tail of ring.
+ * \param[in]   offset  Sequence offset of claimable slots, see \ref osal_mq_ring_tryclaim.
+ *
+ * \return 1 if next slot can be claimed, 0 otherwise.
+ */
+static int osal_mq_ring_claimable(osal_mq_ring_t *ring, osal_uint64_t *cursor, osal_uint64_t offset) {
+    // pairs with the fence of the peer before it checks for waiters
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    osal_uint64_t pos = __atomic_load_n(cursor, __ATOMIC_RELAXED);
+    osal_uint64_t seq = __atomic_load_n(&osal_mq_ring_slot(ring, pos)->seq, __ATOMIC_ACQUIRE);
+
+    return (seq == ((2u * pos) + offset)) ? 1 : 0;
+}
+
+//! \brief Claim next slot of ring, wait if ring is full or empty.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   cursor  Pointer to \p head or \p tail of ring.
+ * \param[in]   offset  Sequence offset of claimable slots, see \ref osal_mq_ring_tryclaim.
+ * \param[in]   wake    Futex to wait on.
+ * \param[in]   waiters Waiter count of \p wake.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ * \param[out]  slot    Claimed slot.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_TIMEOUT         Ring was full or empty until timeout.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid.
+ */
+static osal_retval_t osal_mq_ring_claim(osal_mq_ring_t *ring, osal_uint64_t *cursor, osal_uint64_t offset,
+        osal_uint32_t *wake, osal_uint32_t *waiters, const osal_timer_t *to, osal_mq_ring_slot_t **slot)
+{
+    osal_retval_t ret = osal_mq_ring_tryclaim(ring, cursor, offset, slot);
+    int waited = 0;
+
+    while (ret == OSAL_ERR_BUSY) {
+        osal_uint32_t val = __atomic_load_n(wake, __ATOMIC_ACQUIRE);
+        (void)__atomic_fetch_add(waiters, 1u, __ATOMIC_SEQ_CST);
+
+        // re-check after registering, the peer may not have seen us
+        ret = osal_mq_ring_tryclaim(ring, cursor, offset, slot);
+        if (ret == OSAL_ERR_BUSY) {
+            waited = 1;
+            osal_retval_t wait_ret = osal_mq_ring_wait(wake, val, to);
+
+            if (wait_ret == OSAL_ERR_TIMEOUT) {
+                ret = osal_mq_ring_tryclaim(ring, cursor, offset, slot);
+                if (ret == OSAL_ERR_BUSY) {
+                    ret = OSAL_ERR_TIMEOUT;
+                }
+            } else if (wait_ret != OSAL_OK) {
+                ret = wait_ret;
+            }
+        }
+
+        (void)__atomic_fetch_sub(waiters, 1u, __ATOMIC_RELAXED);
+    }
+
+    // the wakeup for the next slot may have gone to a waiter which found
+    // our slot not done yet and went back to sleep
+    if ((ret == OSAL_OK) && (waited == 1) && (osal_mq_ring_claimable(ring, cursor, offset) == 1)) {
+        osal_mq_ring_wake(wake, waiters, 1u);
+    }
+
+    return ret;
+}
+
+//! \brief Reserve slot for sending.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   len     Message length.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ * \param[out]  slot    Reserved slot.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Message too long.
+ * \retval OSAL_ERR_TIMEOUT         Ring was full until timeout.
+ */
+static osal_retval_t osal_mq_ring_reserve(osal_mq_ring_t *ring, osal_size_t len, 
+        const osal_timer_t *to, osal_mq_ring_slot_t **slot)
+{
+    osal_retval_t ret = OSAL_ERR_INVALID_PARAM;
+
+    if (len <= ring->max_message_size) {
+        ret = osal_mq_ring_claim(ring, &ring->head, 0u, &ring->space_wake, &ring->space_waiters, to, slot);
+        if (ret == OSAL_OK) {
+            (*slot)->len = (osal_uint32_t)len;
+            (*slot)->prio = 0u;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Make reserved slot visible to consumers without waking them.
+/*!
+ * \param[in]   slot    Slot returned by \ref osal_mq_ring_reserve.
+ */
+static osal_void_t osal_mq_ring_publish(osal_mq_ring_slot_t *slot) {
+    // sequence of a reserved slot still is twice its position
+    osal_uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&slot->seq, seq + 1u, __ATOMIC_RELEASE);
+}
+
+//! \brief Commit reserved slot to consumers.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   slot    Slot returned by \ref osal_mq_ring_reserve.
+ */
+static osal_void_t osal_mq_ring_commit(osal_mq_ring_t *ring, osal_mq_ring_slot_t *slot) {
+    osal_mq_ring_publish(slot);
+    osal_mq_ring_wake(&ring->data_wake, &ring->data_waiters, 1u);
+}
+
+//! \brief Claim next committed slot for receiving.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ * \param[out]  slot    Claimed slot.
+ *
+ * \retval OSAL_OK              On success.
+ * \retval OSAL_ERR_TIMEOUT     Ring was empty until timeout.
+ */
+static osal_retval_t osal_mq_ring_peek(osal_mq_ring_t *ring, const osal_timer_t *to, osal_mq_ring_slot_t **slot) {
+    return osal_mq_ring_claim(ring, &ring->tail, 1u, &ring->data_wake, &ring->data_waiters, to, slot);
+}
+
+//! \brief Make received slot free for producers without waking them.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   slot    Slot returned by \ref osal_mq_ring_peek.
+ */
+static osal_void_t osal_mq_ring_free(osal_mq_ring_t *ring, osal_mq_ring_slot_t *slot) {
+    // sequence of a committed slot is twice its position + 1
+    osal_uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) - 1u;
+
+    __atomic_store_n(&slot->seq, seq + (2u * ring->max_messages), __ATOMIC_RELEASE);
+}
+
+//! \brief Release received slot to producers.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   slot    Slot returned by \ref osal_mq_ring_peek.
+ */
+static osal_void_t osal_mq_ring_release(osal_mq_ring_t *ring, osal_mq_ring_slot_t *slot) {
+    osal_mq_ring_free(ring, slot);
+    osal_mq_ring_wake(&ring->space_wake, &ring->space_waiters, 1u);
+}
+
+//! \brief Send message to ring, wait for space.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   msg     Message.
+ * \param[in]   msg_len Message length.
+ * \param[in]   prio    Message priority.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \return See \ref osal_mq_ring_reserve.
+ */
+static osal_retval_t osal_mq_ring_send(osal_mq_ring_t *ring, const osal_char_t *msg, 
+        osal_size_t msg_len, osal_uint32_t prio, const osal_timer_t *to) 
+{
+    osal_mq_ring_slot_t *slot = NULL;
+    osal_retval_t ret = osal_mq_ring_reserve(ring, msg_len, to, &slot);
+
+    if (ret == OSAL_OK) {
+        (void)memcpy(slot->msg, msg, msg_len);
+        slot->prio = prio;
+        osal_mq_ring_commit(ring, slot);
+    }
+
+    return ret;
+}
+
+//! \brief Receive message from ring, wait for message.
+/*!
+ * \param[in]   ring    Pointer to ring.
+ * \param[out]  msg     Message buffer.
+ * \param[in]   msg_len Size of message buffer.
+ * \param[out]  prio    Message priority, may be NULL.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Buffer smaller than maximum message size.
+ * \retval OSAL_ERR_TIMEOUT         Ring was empty until timeout.
+ */
+static osal_retval_t osal_mq_ring_receive(osal_mq_ring_t *ring, osal_char_t *msg, 
+        osal_size_t msg_len, osal_uint32_t *prio, const osal_timer_t *to) 
+{
+    osal_retval_t ret = OSAL_ERR_INVALID_PARAM;
+    osal_mq_ring_slot_t *slot = NULL;
+
+    if (msg_len >= ring->max_message_size) {
+        ret = osal_mq_ring_peek(ring, to, &slot);
+    }
+
+    if (ret == OSAL_OK) {
+        (void)memcpy(msg, slot->msg, slot->len);
+        if (prio != NULL) {
+            *prio = slot->prio;
+        }
+        osal_mq_ring_release(ring, slot);
+    }
+
+    return ret;
+}
+
+//! \brief Send batch of messages to ring.
+/*!
+ * Consumers are woken once after the batch, or before waiting for space
+ * on a full ring, one per message sent since the last wakeup.
+ *
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   msgs    Messages.
+ * \param[in]   cnt     Number of messages.
+ * \param[out]  sent    Number of messages sent.
+ * \param[in]   to      Absolute timeout, NULL waits forever.
+ *
+ * \return See \ref osal_mq_ring_reserve.
+ */
+static osal_retval_t osal_mq_ring_send_batch(osal_mq_ring_t *ring, const osal_mq_msg_t *msgs, 
+        osal_size_t cnt, osal_size_t *sent, const osal_timer_t *to) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_size_t unsignaled = 0u;
+
+    while ((ret == OSAL_OK) && (*sent < cnt)) {
+        const osal_mq_msg_t *msg = &msgs[*sent];
+        osal_mq_ring_slot_t *slot = NULL;
+
+        if (msg->len > ring->max_message_size) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            ret = osal_mq_ring_tryclaim(ring, &ring->head, 0u, &slot);
+            if (ret == OSAL_ERR_BUSY) {
+                // consumers have to see what we sent before we wait for them
+                if (unsignaled != 0u) {
+                    osal_mq_ring_wake(&ring->data_wake, &ring->data_waiters, unsignaled);
+                    unsignaled = 0u;
+                }
+
+                ret = osal_mq_ring_reserve(ring, msg->len, to, &slot);
+            }
+        }
+
+        if (ret == OSAL_OK) {
+            (void)memcpy(slot->msg, msg->msg, msg->len);
+            slot->len = (osal_uint32_t)msg->len;
+            slot->prio = msg->prio;
+            osal_mq_ring_publish(slot);
+            unsignaled++;
+            (*sent)++;
+        }
+    }
+
+    if (unsignaled != 0u) {
+        osal_mq_ring_wake(&ring->data_wake, &ring->data_waiters, unsignaled);
+    }
+
+    return ret;
+}
+
+//! \brief Receive batch of messages from ring.
+/*!
+ * Waits for the first message only and returns what is available then.
+ * Producers are woken once after the batch, one per message received.
+ *
+ * \param[in]   ring        Pointer to ring.
+ * \param[in,out] msgs      Message buffers.
+ * \param[in]   cnt         Number of message buffers.
+ * \param[out]  received    Number of messages received.
+ * \param[in]   to          Absolute timeout, NULL waits forever.
+ *
+ * \retval OSAL_OK                  At least one message received.
+ * \retval OSAL_ERR_INVALID_PARAM   Buffer smaller than maximum message size.
+ * \retval OSAL_ERR_TIMEOUT         Ring was empty until timeout.
+ */
+static osal_retval_t osal_mq_ring_receive_batch(osal_mq_ring_t *ring, osal_mq_msg_t *msgs, 
+        osal_size_t cnt, osal_size_t *received, const osal_timer_t *to) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_mq_ring_slot_t *slot = NULL;
+
+    while ((ret == OSAL_OK) && (*received < cnt)) {
+        osal_mq_msg_t *msg = &msgs[*received];
+
+        if (msg->len < ring->max_message_size) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else if (*received == 0u) {
+            ret = osal_mq_ring_peek(ring, to, &slot);
+        } else {
+            ret = osal_mq_ring_tryclaim(ring, &ring->tail, 1u, &slot);
+        }
+
+        if (ret == OSAL_OK) {
+            (void)memcpy(msg->msg, slot->msg, slot->len);
+            msg->len = slot->len;
+            msg->prio = slot->prio;
+            osal_mq_ring_free(ring, slot);
+            (*received)++;
+        }
+    }
+
+    if (*received != 0u) {
+        osal_mq_ring_wake(&ring->space_wake, &ring->space_waiters, *received);
+        ret = OSAL_OK;
+    }
+
+    return ret;
+}
+
+//! \brief Return slot of message pointer.
+/*!
+ * The sequence of the slot has to show that it is claimed but not yet
+ * committed or released, so passing a message twice or a message of
+ * another queue does not corrupt the ring. A slot can only be claimed at
+ * one of the last \p max_messages positions before \p pos, that position
+ * is the only one the sequence is compared with.
+ *
+ * \param[in]   ring    Pointer to ring.
+ * \param[in]   ptr     Message pointer returned by \ref osal_mq_reserve or \ref osal_mq_peek.
+ * \param[in]   pos     Ring position the slot was claimed from, \p head or \p tail.
+ * \param[in]   state   Sequence offset of a claimed slot, 0 reserved, 1 peeked.
+ *
+ * \return Slot or NULL if \p ptr does not point to a claimed message of \p ring.
+ */
+static osal_mq_ring_slot_t *osal_mq_ring_slot_of(osal_mq_ring_t *ring, const osal_void_t *ptr,
+        const osal_uint64_t *pos, osal_uint64_t state) 
+{
+    osal_mq_ring_slot_t *slot = NULL;
+    const osal_uint8_t *first = &ring->slots[offsetof(osal_mq_ring_slot_t, msg)];
+    const osal_uint8_t *msg = (const osal_uint8_t *)ptr;
+
+    if ((msg >= first) && (msg < &first[ring->max_messages * ring->slot_size]) &&
+            ((osal_size_t)(msg - first) % ring->slot_size) == 0u) {
+        // cppcheck-suppress misra-c2012-11.3
+        osal_mq_ring_slot_t *tmp = (osal_mq_ring_slot_t *)&ring->slots[(osal_size_t)(msg - first)];
+        osal_uint64_t idx = (osal_uint64_t)(msg - first) / ring->slot_size;
+        osal_uint64_t last = __atomic_load_n(pos, __ATOMIC_RELAXED) - 1u;
+        osal_uint64_t seq = __atomic_load_n(&tmp->seq, __ATOMIC_ACQUIRE);
+
+        // latest position of the slot before pos, nothing claimed if pos is 0
+        if ((last + 1u) > idx) {
+            osal_uint64_t claimed = last - ((last - idx) % ring->max_messages);
+
+            if (seq == ((2u * claimed) + state)) {
+                slot = tmp;
+            }
+        }
+    }
+
+    return slot;
+}
+
+//! \brief Open ring message queue in shared memory.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure.
+ * \param[in]   name    Name of shared memory.
+ * \param[in]   attr    Mq attributes.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_mq_ring_open(osal_mq_t *mq, const osal_char_t *name, const osal_mq_attr_t *attr) {
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t slot_size = (sizeof(osal_mq_ring_slot_t) + attr->max_message_size + 7u) & ~(osal_uint64_t)7u;
+    osal_shm_attr_t shm_attr = OSAL_SHM_ATTR__FLAG__RDWR | ((osal_uint32_t)attr->mode << OSAL_SHM_ATTR__MODE__SHIFT);
+    osal_shm_map_attr_t map_attr = OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__PROT_WRITE | OSAL_SHM_MAP_ATTR__SHARED;
+    osal_mq_ring_t *ring = NULL;
+
+    if ((attr->oflags & OSAL_MQ_ATTR__OFLAG__CREAT) != 0u) {
+        shm_attr |= OSAL_SHM_ATTR__FLAG__CREAT;
+    }
+    if ((attr->oflags & OSAL_MQ_ATTR__OFLAG__EXCL) != 0u) {
+        shm_attr |= OSAL_SHM_ATTR__FLAG__EXCL;
+    }
+
+    if (((attr->oflags & OSAL_MQ_ATTR__OFLAG__CREAT) != 0u) && 
+            ((attr->max_messages == 0u) || (attr->max_message_size == 0u) || (attr->max_message_size > UINT32_MAX))) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        ret = osal_shm_open(&mq->shm, name, &shm_attr, sizeof(osal_mq_ring_t) + (attr->max_messages * slot_size));
+    }
+
+    if (ret == OSAL_OK) {
+        if (mq->shm.size < sizeof(osal_mq_ring_t)) {
+            ret = OSAL_ERR_NOT_FOUND;
+        } else {
+            ret = osal_shm_map(&mq->shm, &map_attr, (osal_void_t **)&ring);
+        }
+
+        if (ret != OSAL_OK) {
+            (void)osal_shm_close(&mq->shm);
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        osal_uint32_t magic = 0u;
+        osal_uint32_t polls = 0u;
+
+        if (((attr->oflags & OSAL_MQ_ATTR__OFLAG__CREAT) != 0u) &&
+                __atomic_compare_exchange_n(&ring->magic, &magic, LIBOSAL_MQ_RING_MAGIC_INIT,
+                    0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            ring->max_messages = attr->max_messages;
+            ring->max_message_size = attr->max_message_size;
+            ring->slot_size = slot_size;
+            ring->head = 0u;
+            ring->tail = 0u;
+
+            for (osal_uint64_t i = 0u; i < ring->max_messages; ++i) {
+                osal_mq_ring_slot(ring, i)->seq = 2u * i;
+            }
+
+            magic = LIBOSAL_MQ_RING_MAGIC;
+            __atomic_store_n(&ring->magic, magic, __ATOMIC_RELEASE);
+        }
+
+        // wait for creator to finish initialization
+        magic = __atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE);
+        while ((magic != LIBOSAL_MQ_RING_MAGIC) && (polls++ < LIBOSAL_MQ_RING_INIT_POLLS)) {
+            osal_sleep(LIBOSAL_MQ_RING_INIT_POLL);
+            magic = __atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE);
+        }
+
+        if ((magic != LIBOSAL_MQ_RING_MAGIC) || (ring->max_messages == 0u) ||
+                ((sizeof(osal_mq_ring_t) + (ring->max_messages * ring->slot_size)) > mq->shm.size)) {
+            (void)munmap(ring, mq->shm.size);
+            (void)osal_shm_close(&mq->shm);
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            mq->backend = LIBOSAL_MQ_BACKEND_SHM_RING;
+            mq->ring = ring;
+        }
+    }
+
+    return ret;
+}
+
 
 //! \brief Initialize a mq.
 /*!
@@ -81,8 +679,16 @@ osal_retval_t osal_mq_open(osal_mq_t *mq, const osal_char_t *name,  const osal_m
         local_attr.mq_msgsize = attr->max_message_size;
     }
 
-    mq->mq_desc = mq_open(name, oflags, mode, &local_attr);
-	if (mq->mq_desc == (mqd_t)-1) {
+    mq->backend = LIBOSAL_MQ_BACKEND_POSIX;
+    mq->ring = NULL;
+
+    if ((attr != NULL) && ((attr->oflags & OSAL_MQ_ATTR__OFLAG__SHM_RING) != 0u)) {
+        ret = osal_mq_ring_open(mq, name, attr);
+    } else {
+        mq->mq_desc = mq_open(name, oflags, mode, &local_attr);
+    }
+
+	if ((ret == OSAL_OK) && (mq->backend == LIBOSAL_MQ_BACKEND_POSIX) && (mq->mq_desc == (mqd_t)-1)) {
         switch (errno) {
             case EACCES:        // The queue exists, but the caller does not have permission to open it in the specified mode.
                                 // name contained more than one slash.
@@ -143,8 +749,10 @@ osal_retval_t osal_mq_send(osal_mq_t *mq, const osal_char_t *msg, const osal_siz
     assert(msg != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int local_ret = mq_send(mq->mq_desc, msg, msg_len, prio);
-    if (local_ret == -1) {
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_send(mq->ring, msg, msg_len, prio, NULL);
+    } else if (mq_send(mq->mq_desc, msg, msg_len, prio) == -1) {
         switch (errno) {
             case EAGAIN:    // The queue was full, and the O_NONBLOCK flag was set for the message queue description 
                             // referred to by mqdes.
@@ -191,11 +799,19 @@ osal_retval_t osal_mq_timedsend(osal_mq_t *mq, const osal_char_t *msg, const osa
     assert(msg != NULL);
     assert(to != NULL);
 
-    osal_retval_t ret = OSAL_ERR_INTERRUPTED;
+    osal_retval_t ret;
 
+    // mq_timed* only accept CLOCK_REALTIME
     struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
+    ret = osal_timer_to_timespec(to, CLOCK_REALTIME, &ts);
+
+    if (ret != OSAL_OK) {
+        // invalid timeout, do not wait at all
+    } else if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_send(mq->ring, msg, msg_len, prio, to);
+    } else {
+        ret = OSAL_ERR_INTERRUPTED;
+    }
 
     while (ret == OSAL_ERR_INTERRUPTED) {
         int local_ret = mq_timedsend(mq->mq_desc, msg, msg_len, prio, &ts);
@@ -249,8 +865,10 @@ osal_retval_t osal_mq_receive(osal_mq_t *mq, osal_char_t *msg, const osal_size_t
     assert(msg != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int local_ret = mq_receive(mq->mq_desc, msg, msg_len, prio);
-    if (local_ret == -1) {
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_receive(mq->ring, msg, msg_len, prio, NULL);
+    } else if (mq_receive(mq->mq_desc, msg, msg_len, prio) == -1) {
         switch (errno) {
             case EAGAIN:    // The queue was full, and the O_NONBLOCK flag was set for the message queue description 
                             // referred to by mqdes.
@@ -296,11 +914,19 @@ osal_retval_t osal_mq_timedreceive(osal_mq_t *mq, osal_char_t *msg, const osal_s
     assert(msg != NULL);
     assert(to != NULL);
 
-    osal_retval_t ret = OSAL_ERR_INTERRUPTED;
+    osal_retval_t ret;
 
+    // mq_timed* only accept CLOCK_REALTIME
     struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
+    ret = osal_timer_to_timespec(to, CLOCK_REALTIME, &ts);
+
+    if (ret != OSAL_OK) {
+        // invalid timeout, do not wait at all
+    } else if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_receive(mq->ring, msg, msg_len, prio, to);
+    } else {
+        ret = OSAL_ERR_INTERRUPTED;
+    }
 
     while (ret == OSAL_ERR_INTERRUPTED) {
         int local_ret = mq_timedreceive(mq->mq_desc, msg, msg_len, prio, &ts);
@@ -349,8 +975,13 @@ osal_retval_t osal_mq_close(osal_mq_t *mq) {
     assert(mq != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int local_ret = mq_close(mq->mq_desc);
-    if (local_ret == -1) {
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        (void)munmap(mq->ring, mq->shm.size);
+        ret = osal_shm_close(&mq->shm);
+        mq->backend = LIBOSAL_MQ_BACKEND_POSIX;
+        mq->ring = NULL;
+    } else if (mq_close(mq->mq_desc) == -1) {
         // only EBADF could be set
         ret = OSAL_ERR_INVALID_PARAM;
     }
@@ -358,3 +989,245 @@ osal_retval_t osal_mq_close(osal_mq_t *mq) {
     return ret;
 }
 
+//! \brief Reserve a message in the message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   len     Length of message.
+ * \param[out]  ptr     Returns pointer to message storage.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_reserve(osal_mq_t *mq, const osal_size_t len, osal_void_t **ptr) {
+    assert(mq != NULL);
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        osal_mq_ring_slot_t *slot = NULL;
+
+        ret = osal_mq_ring_reserve(mq->ring, len, NULL, &slot);
+        if (ret == OSAL_OK) {
+            *ptr = slot->msg;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Commit a reserved message to the message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_mq_reserve.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_commit(osal_mq_t *mq, osal_void_t *ptr) {
+    assert(mq != NULL);
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        osal_mq_ring_slot_t *slot = osal_mq_ring_slot_of(mq->ring, ptr, &mq->ring->head, 0u);
+
+        if (slot == NULL) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            osal_mq_ring_commit(mq->ring, slot);
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Get next message in the message queue without copying it.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to message.
+ * \param[out]  len     Returns length of message.
+ * \param[out]  prio    Returns priority of message, may be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_peek(osal_mq_t *mq, const osal_void_t **ptr, osal_size_t *len, osal_uint32_t *prio) {
+    assert(mq != NULL);
+    assert(ptr != NULL);
+    assert(len != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        osal_mq_ring_slot_t *slot = NULL;
+
+        ret = osal_mq_ring_peek(mq->ring, NULL, &slot);
+        if (ret == OSAL_OK) {
+            *ptr = slot->msg;
+            *len = slot->len;
+            if (prio != NULL) {
+                *prio = slot->prio;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Release a message returned by \ref osal_mq_peek.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   ptr     Pointer returned by \ref osal_mq_peek.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_release(osal_mq_t *mq, const osal_void_t *ptr) {
+    assert(mq != NULL);
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        osal_mq_ring_slot_t *slot = osal_mq_ring_slot_of(mq->ring, ptr, &mq->ring->tail, 1u);
+
+        if (slot == NULL) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            osal_mq_ring_release(mq->ring, slot);
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Get pollable file descriptor of message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_get_fd(osal_mq_t *mq, osal_int32_t *fd) {
+    assert(mq != NULL);
+    assert(fd != NULL);
+
+    osal_retval_t ret = OSAL_ERR_NOT_IMPLEMENTED;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_POSIX) {
+        // linux implements mqd_t as file descriptor
+        *fd = (osal_int32_t)mq->mq_desc;
+        ret = OSAL_OK;
+    }
+
+    return ret;
+}
+
+//! \brief Send a batch of messages through message queue.
+/*!
+ * \param[in]   mq      Pointer to osal mq structure. Content is OS dependent.
+ * \param[in]   msgs    Messages to send.
+ * \param[in]   cnt     Number of messages.
+ * \param[out]  sent    Returns number of messages sent.
+ * \param[in]   to      Timeout waiting if message queue is full, NULL waits forever.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_send_batch(osal_mq_t *mq, const osal_mq_msg_t *msgs, const osal_size_t cnt,
+        osal_size_t *sent, const osal_timer_t *to) 
+{
+    assert(mq != NULL);
+    assert(msgs != NULL);
+    assert(sent != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    *sent = 0u;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_send_batch(mq->ring, msgs, cnt, sent, to);
+    } else {
+        while ((ret == OSAL_OK) && (*sent < cnt)) {
+            const osal_mq_msg_t *msg = &msgs[*sent];
+
+            if (to != NULL) {
+                ret = osal_mq_timedsend(mq, msg->msg, msg->len, msg->prio, to);
+            } else {
+                ret = osal_mq_send(mq, msg->msg, msg->len, msg->prio);
+            }
+
+            if (ret == OSAL_OK) {
+                (*sent)++;
+            }
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Receive a batch of messages through message queue.
+/*!
+ * \param[in]   mq          Pointer to osal mq structure. Content is OS dependent.
+ * \param[in,out] msgs      Message buffers.
+ * \param[in]   cnt         Number of message buffers.
+ * \param[out]  received    Returns number of messages received.
+ * \param[in]   to          Timeout waiting if message queue is empty, NULL waits forever.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_mq_receive_batch(osal_mq_t *mq, osal_mq_msg_t *msgs, const osal_size_t cnt,
+        osal_size_t *received, const osal_timer_t *to) 
+{
+    assert(mq != NULL);
+    assert(msgs != NULL);
+    assert(received != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    *received = 0u;
+
+    if (mq->backend == LIBOSAL_MQ_BACKEND_SHM_RING) {
+        ret = osal_mq_ring_receive_batch(mq->ring, msgs, cnt, received, to);
+    } else {
+        while ((ret == OSAL_OK) && (*received < cnt)) {
+            osal_mq_msg_t *msg = &msgs[*received];
+            ssize_t len;
+            struct timespec ts;
+
+            // only wait for the first message, an expired timeout polls for the others
+            if (*received != 0u) {
+                ts.tv_sec = 0;
+                ts.tv_nsec = 0;
+            } else if (to != NULL) {
+                ret = osal_timer_to_timespec(to, CLOCK_REALTIME, &ts);
+                if (ret != OSAL_OK) {
+                    break;
+                }
+            }
+
+            if ((*received == 0u) && (to == NULL)) {
+                len = mq_receive(mq->mq_desc, msg->msg, msg->len, &msg->prio);
+            } else {
+                len = mq_timedreceive(mq->mq_desc, msg->msg, msg->len, &msg->prio, &ts);
+            }
+
+            if (len >= 0) {
+                msg->len = (osal_size_t)len;
+                (*received)++;
+            } else if (errno == EINTR) {
+                // retry
+            } else if (errno == ETIMEDOUT) {
+                ret = OSAL_ERR_TIMEOUT;
+            } else if ((errno == EBADF) || (errno == EINVAL) || (errno == EMSGSIZE)) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
+        }
+
+        if (*received != 0u) {
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
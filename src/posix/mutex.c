@@ -33,6 +33,12 @@
 #include <errno.h>
 #include <pthread.h>
 #include <assert.h>
+#include <unistd.h>
+
+#include "cpu.h"
+
+//! Maximum number of relax cycles between two lock attempts of an adaptive mutex.
+#define LIBOSAL_MUTEX_ADAPTIVE_BACKOFF_MAX  4u
 
 //! \brief Initialize a mutex.
 /*!
@@ -51,9 +57,23 @@ osal_retval_t osal_mutex_init(osal_mutex_t *mtx, const osal_mutex_attr_t *attr)
     pthread_mutexattr_t posix_attr;
     pthread_mutexattr_t *pposix_attr = NULL;
 
+    mtx->spin_count = 0u;
+
     if (attr != NULL) {
         pthread_mutexattr_init(&posix_attr);
 
+        if (((*attr) & OSAL_MUTEX_ATTR__ADAPTIVE) == OSAL_MUTEX_ATTR__ADAPTIVE) {
+            unsigned int spin_shift = (((*attr) & OSAL_MUTEX_ATTR__ADAPTIVE_SPIN__MASK) >> OSAL_MUTEX_ATTR__ADAPTIVE_SPIN__SHIFT);
+            if (spin_shift == 0u) {
+                spin_shift = OSAL_MUTEX_ADAPTIVE_SPIN__DEFAULT;
+            }
+
+            // the owner can't make progress while we spin on a single cpu
+            if (sysconf(_SC_NPROCESSORS_ONLN) > 1) {
+                mtx->spin_count = 1u << spin_shift;
+            }
+        }
+
         if (((*attr) & OSAL_MUTEX_ATTR__TYPE__MASK) == OSAL_MUTEX_ATTR__TYPE__NORMAL) {
             pthread_mutexattr_settype(&posix_attr, PTHREAD_MUTEX_NORMAL);
         } else if (((*attr) & OSAL_MUTEX_ATTR__TYPE__MASK) == OSAL_MUTEX_ATTR__TYPE__ERRORCHECK) {
@@ -119,9 +139,22 @@ osal_retval_t osal_mutex_lock(osal_mutex_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret;
-    int posix_ret;
+    int posix_ret = EBUSY;
+    unsigned int spin;
+    osal_uint32_t backoff = 1u;
+
+    // adaptive spin phase, trylock also handles robust and priority inheritance mutexes
+    for (spin = 0u; (spin < mtx->spin_count) && (posix_ret == EBUSY); ++spin) {
+        posix_ret = pthread_mutex_trylock(&mtx->posix_mtx);
+        if (posix_ret == EBUSY) {
+            osal_cpu_backoff(&backoff, LIBOSAL_MUTEX_ADAPTIVE_BACKOFF_MAX);
+        }
+    }
+
+    if (posix_ret == EBUSY) {
+        posix_ret = pthread_mutex_lock(&mtx->posix_mtx);
+    }
 
-    posix_ret = pthread_mutex_lock(&mtx->posix_mtx);
     if (posix_ret != 0) {
         if (posix_ret == EAGAIN) {
             ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
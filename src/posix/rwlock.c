@@ -0,0 +1,280 @@
+/**
+ * \file posix/rwlock.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL rwlock posix source.
+ *
+ * OSAL rwlock posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#define _GNU_SOURCE             /* pthread_rwlockattr_setkind_np, pthread_rwlock_clock*lock */
+
+#include <libosal/osal.h>
+#include <libosal/rwlock.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <assert.h>
+#include <time.h>
+
+#include "clock.h"
+
+//! \brief Map posix return value of lock functions.
+/*!
+ * \param[in]   posix_ret   Return value of pthread_rwlock_*lock.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_rwlock_retval(int posix_ret) {
+    osal_retval_t ret;
+
+    if (posix_ret == 0) {
+        ret = OSAL_OK;
+    } else if (posix_ret == EBUSY) {
+        ret = OSAL_ERR_BUSY;
+    } else if (posix_ret == ETIMEDOUT) {
+        ret = OSAL_ERR_TIMEOUT;
+    } else if (posix_ret == EAGAIN) {
+        ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+    } else if (posix_ret == EDEADLK) {
+        ret = OSAL_ERR_DEAD_LOCK;
+    } else if (posix_ret == EPERM) {
+        ret = OSAL_ERR_PERMISSION_DENIED;
+    } else if (posix_ret == EINVAL) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        ret = OSAL_ERR_UNAVAILABLE;
+    }
+
+    return ret;
+}
+
+//! \brief Convert absolute osal timeout to timespec.
+/*!
+ * pthread_rwlock_timed*lock only accepts CLOCK_REALTIME and 
+ * pthread_rwlock_clock*lock additionally CLOCK_MONOTONIC. Timeouts on other
+ * clocks are converted.
+ *
+ * \param[in]   to      Absolute timeout on its own clock.
+ * \param[out]  ts      Returns absolute timeout.
+ * \param[out]  clk     Returns clock of \p ts.
+ *
+ * \retval OSAL_OK                  On success.
+ * \retval OSAL_ERR_INVALID_PARAM   Clock of \p to is invalid.
+ */
+static osal_retval_t osal_rwlock_timeout(const osal_timer_t *to, struct timespec *ts, clockid_t *clk) {
+#if LIBOSAL_HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK == 1
+    *clk = (osal_timer_clock(to) == CLOCK_REALTIME) ? CLOCK_REALTIME : CLOCK_MONOTONIC;
+#else
+    *clk = CLOCK_REALTIME;
+#endif
+
+    return osal_timer_to_timespec(to, *clk, ts);
+}
+
+//! \brief Initialize a rwlock.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to initial rwlock attributes. Can be NULL then
+ *                      the defaults of the underlying rwlock will be used.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_init(osal_rwlock_t *rw, const osal_rwlock_attr_t *attr) {
+    assert(rw != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    int posix_ret;
+
+    pthread_rwlockattr_t posix_attr;
+    pthread_rwlockattr_t *pposix_attr = NULL;
+
+    if (attr != NULL) {
+        pthread_rwlockattr_init(&posix_attr);
+
+        if (((*attr) & OSAL_RWLOCK_ATTR__PROCESS_SHARED) == OSAL_RWLOCK_ATTR__PROCESS_SHARED) {
+            pthread_rwlockattr_setpshared(&posix_attr, PTHREAD_PROCESS_SHARED);
+        }
+
+        if (((*attr) & OSAL_RWLOCK_ATTR__PREFER_WRITER) == OSAL_RWLOCK_ATTR__PREFER_WRITER) {
+#if LIBOSAL_HAVE_PTHREAD_RWLOCKATTR_SETKIND_NP == 1
+            // the recursive variant of writer preference is treated like reader preference by glibc
+            pthread_rwlockattr_setkind_np(&posix_attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#else
+            ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+        }
+
+        pposix_attr = &posix_attr;
+    }
+
+    if (ret == OSAL_OK) {
+        posix_ret = pthread_rwlock_init(&rw->posix_rwlock, pposix_attr);
+
+        if (posix_ret != 0) {
+            if (posix_ret == EAGAIN) {
+                ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+            } else if (posix_ret == ENOMEM) {
+                ret = OSAL_ERR_OUT_OF_MEMORY;
+            } else if (posix_ret == EPERM) {
+                ret = OSAL_ERR_PERMISSION_DENIED;
+            } else if (posix_ret == EINVAL) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else {
+                ret = OSAL_ERR_UNAVAILABLE;
+            }
+        }
+    }
+
+    if (pposix_attr != NULL) {
+        pthread_rwlockattr_destroy(pposix_attr);
+    }
+
+    return ret;
+}
+
+//! \brief Lock a rwlock for reading.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_rdlock(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_rdlock(&rw->posix_rwlock));
+}
+
+//! \brief Try to lock a rwlock for reading but don't block.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_tryrdlock(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_tryrdlock(&rw->posix_rwlock));
+}
+
+//! \brief Lock a rwlock for reading with timeout.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_timedrdlock(osal_rwlock_t *rw, const osal_timer_t *to) {
+    assert(rw != NULL);
+    assert(to != NULL);
+
+    struct timespec ts;
+    clockid_t clk;
+    osal_retval_t ret = osal_rwlock_timeout(to, &ts, &clk);
+
+    if (ret == OSAL_OK) {
+#if LIBOSAL_HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK == 1
+        ret = osal_rwlock_retval(pthread_rwlock_clockrdlock(&rw->posix_rwlock, clk, &ts));
+#else
+        ret = osal_rwlock_retval(pthread_rwlock_timedrdlock(&rw->posix_rwlock, &ts));
+#endif
+    }
+
+    return ret;
+}
+
+//! \brief Lock a rwlock for writing.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_wrlock(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_wrlock(&rw->posix_rwlock));
+}
+
+//! \brief Try to lock a rwlock for writing but don't block.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_trywrlock(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_trywrlock(&rw->posix_rwlock));
+}
+
+//! \brief Lock a rwlock for writing with timeout.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_timedwrlock(osal_rwlock_t *rw, const osal_timer_t *to) {
+    assert(rw != NULL);
+    assert(to != NULL);
+
+    struct timespec ts;
+    clockid_t clk;
+    osal_retval_t ret = osal_rwlock_timeout(to, &ts, &clk);
+
+    if (ret == OSAL_OK) {
+#if LIBOSAL_HAVE_PTHREAD_RWLOCK_CLOCKRDLOCK == 1
+        ret = osal_rwlock_retval(pthread_rwlock_clockwrlock(&rw->posix_rwlock, clk, &ts));
+#else
+        ret = osal_rwlock_retval(pthread_rwlock_timedwrlock(&rw->posix_rwlock, &ts));
+#endif
+    }
+
+    return ret;
+}
+
+//! \brief Unlock a rwlock.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_unlock(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_unlock(&rw->posix_rwlock));
+}
+
+//! \brief Destroys a rwlock.
+/*!
+ * \param[in]   rw      Pointer to osal rwlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_rwlock_destroy(osal_rwlock_t *rw) {
+    assert(rw != NULL);
+
+    return osal_rwlock_retval(pthread_rwlock_destroy(&rw->posix_rwlock));
+}
+
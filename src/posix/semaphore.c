@@ -28,10 +28,19 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#define _GNU_SOURCE             /* sem_clockwait, ppoll */
+
 #include <libosal/osal.h>
 #include <assert.h>
 #include <errno.h>
 
+#include "clock.h"
+
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+#include <sys/eventfd.h>
+#include "eventfd.h"
+#endif
+
 //! \brief Initialize a semaphore.
 /*!
  * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
@@ -47,21 +56,43 @@ osal_retval_t osal_semaphore_init(osal_semaphore_t *sem, const osal_semaphore_at
     osal_retval_t ret = OSAL_OK;
 
     int pshared = 0;
+    int pollable = 0;
     int posix_initval = initval;
     int local_ret;
     if (attr != NULL) {
         if (((*attr) & OSAL_SEMAPHORE_ATTR__PROCESS_SHARED) == OSAL_SEMAPHORE_ATTR__PROCESS_SHARED) {
             pshared = 1;
         }
+        if (((*attr) & OSAL_SEMAPHORE_ATTR__POLLABLE) == OSAL_SEMAPHORE_ATTR__POLLABLE) {
+            pollable = 1;
+        }
     }
 
-    local_ret = sem_init(&sem->posix_sem, pshared, posix_initval);
-    if (local_ret != 0) {
-        if (local_ret == ENOSYS) {
-            ret = OSAL_ERR_NOT_IMPLEMENTED;
-        } else { // if (local_ret == EINVAL)
+    sem->efd = -1;
+
+    if (pollable == 1) {
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+        // an eventfd can not be shared through shared memory
+        if ((initval < 0) || (pshared == 1)) {
             ret = OSAL_ERR_INVALID_PARAM;
-        } 
+        } else {
+            sem->efd = eventfd((unsigned int)initval, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC);
+            if (sem->efd < 0) {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
+        }
+#else
+        ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+    } else {
+        local_ret = sem_init(&sem->posix_sem, pshared, posix_initval);
+        if (local_ret != 0) {
+            if (local_ret == ENOSYS) {
+                ret = OSAL_ERR_NOT_IMPLEMENTED;
+            } else { // if (local_ret == EINVAL)
+                ret = OSAL_ERR_INVALID_PARAM;
+            } 
+        }
     }
 
     return ret;
@@ -78,13 +109,20 @@ osal_retval_t osal_semaphore_post(osal_semaphore_t *sem) {
 
     osal_retval_t ret = OSAL_OK;
 
-    int local_ret = sem_post(&sem->posix_sem);
-    if (local_ret != 0) {
-        local_ret = errno;
-        if (local_ret == EINVAL) {
-            ret = OSAL_ERR_INVALID_PARAM;
-        } else { // if (local_ret == EOVERFLOW) 
-            ret = OSAL_ERR_OPERATION_FAILED;
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_post(sem->efd);
+    } else
+#endif
+    {
+        int local_ret = sem_post(&sem->posix_sem);
+        if (local_ret != 0) {
+            local_ret = errno;
+            if (local_ret == EINVAL) {
+                ret = OSAL_ERR_INVALID_PARAM;
+            } else { // if (local_ret == EOVERFLOW) 
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
         }
     }
 
@@ -103,13 +141,20 @@ osal_retval_t osal_semaphore_wait(osal_semaphore_t *sem) {
     osal_retval_t ret = OSAL_OK;
     int local_ret;
 
-    local_ret = sem_wait(&sem->posix_sem);
-    if (local_ret != 0) {
-        local_ret = errno;
-        if (local_ret == EINTR) {
-            ret = OSAL_ERR_INTERRUPTED;
-        } else { // if (local_ret == EINVAL) 
-            ret = OSAL_ERR_INVALID_PARAM;
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_wait(sem->efd, 1, NULL);
+    } else
+#endif
+    {
+        local_ret = sem_wait(&sem->posix_sem);
+        if (local_ret != 0) {
+            local_ret = errno;
+            if (local_ret == EINTR) {
+                ret = OSAL_ERR_INTERRUPTED;
+            } else { // if (local_ret == EINVAL) 
+                ret = OSAL_ERR_INVALID_PARAM;
+            }
         }
     }
 
@@ -126,16 +171,26 @@ osal_retval_t osal_semaphore_trywait(osal_semaphore_t *sem) {
     assert(sem != NULL);
     osal_retval_t ret = OSAL_OK;
 
-    int local_ret = sem_trywait(&sem->posix_sem);
-    if (local_ret != 0) {
-        local_ret = errno; /* Note: this is a special case for the semaphore
-			    functions, the rest of pthreads behaves
-			    differently */
-        if (local_ret == EAGAIN) {
-            ret = OSAL_ERR_BUSY;
-        } else {
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        ret = osal_eventfd_wait(sem->efd, 0, NULL);
+        if ((ret != OSAL_OK) && (ret != OSAL_ERR_BUSY)) {
             ret = OSAL_ERR_OPERATION_FAILED;
         }
+    } else
+#endif
+    {
+        int local_ret = sem_trywait(&sem->posix_sem);
+        if (local_ret != 0) {
+            local_ret = errno; /* Note: this is a special case for the semaphore
+                                  functions, the rest of pthreads behaves
+                                  differently */
+            if (local_ret == EAGAIN) {
+                ret = OSAL_ERR_BUSY;
+            } else {
+                ret = OSAL_ERR_OPERATION_FAILED;
+            }
+        }
     }
 
     return ret;
@@ -152,14 +207,30 @@ osal_retval_t osal_semaphore_timedwait(osal_semaphore_t *sem, const osal_timer_t
     assert(sem != NULL);
     assert(to != NULL);
 
-    osal_retval_t ret = OSAL_OK;
+    osal_retval_t ret;
 
+    // sem_timedwait only accepts CLOCK_REALTIME and sem_clockwait 
+    // additionally CLOCK_MONOTONIC, timeouts on other clocks are converted
     struct timespec ts;
-    ts.tv_sec = to->sec;
-    ts.tv_nsec = to->nsec;
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+    clockid_t clk = (osal_timer_clock(to) == CLOCK_REALTIME) ? CLOCK_REALTIME : CLOCK_MONOTONIC;
+#else
+    clockid_t clk = CLOCK_REALTIME;
+#endif
+    ret = osal_timer_to_timespec(to, clk, &ts);
 
-    while (ret == OSAL_OK) {
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if ((ret == OSAL_OK) && (sem->efd >= 0)) {
+        ret = osal_eventfd_wait(sem->efd, 1, to);
+    }
+#endif
+
+    while ((ret == OSAL_OK) && (sem->efd < 0)) {
+#if LIBOSAL_HAVE_SEM_CLOCKWAIT == 1
+        int local_ret = sem_clockwait(&sem->posix_sem, clk, &ts);
+#else
         int local_ret = sem_timedwait(&sem->posix_sem, &ts);
+#endif
         int local_errno = errno;
 
         if (local_ret == 0) {
@@ -190,7 +261,16 @@ osal_retval_t osal_semaphore_destroy(osal_semaphore_t *sem) {
     osal_retval_t ret = OSAL_OK;
     int local_ret;
 
-    local_ret = sem_destroy(&sem->posix_sem);
+#if LIBOSAL_HAVE_SYS_EVENTFD_H == 1
+    if (sem->efd >= 0) {
+        local_ret = close(sem->efd);
+        sem->efd = -1;
+    } else
+#endif
+    {
+        local_ret = sem_destroy(&sem->posix_sem);
+    }
+
     if (local_ret != 0) {
         // should only return EINVAL !
         ret = OSAL_ERR_INVALID_PARAM;
@@ -199,4 +279,26 @@ osal_retval_t osal_semaphore_destroy(osal_semaphore_t *sem) {
     return ret;
 }
 
+//! \brief Get pollable file descriptor of a semaphore.
+/*!
+ * \param[in]   sem     Pointer to osal semaphore structure. Content is OS dependent.
+ * \param[out]  fd      Returns pollable file descriptor.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_semaphore_get_fd(osal_semaphore_t *sem, osal_int32_t *fd) {
+    assert(sem != NULL);
+    assert(fd != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (sem->efd < 0) {
+        ret = OSAL_ERR_NOT_IMPLEMENTED;
+    } else {
+        *fd = sem->efd;
+    }
+
+    return ret;
+}
+
 
@@ -0,0 +1,210 @@
+/**
+ * \file posix/seqlock.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL seqlock posix source.
+ *
+ * OSAL seqlock posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/osal.h>
+#include <libosal/seqlock.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include "cpu.h"
+
+//! \brief Initialize a seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to initial seqlock attributes. Can be NULL.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_init(osal_seqlock_t *sl, const osal_seqlock_attr_t *attr) {
+    assert(sl != NULL);
+
+    // atomics on the sequence count work in process shared memory as well
+    (void)attr;
+
+    __atomic_store_n(&sl->seq, 0u, __ATOMIC_RELEASE);
+
+    return OSAL_OK;
+}
+
+//! \brief Begin a write section.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_write_begin(osal_seqlock_t *sl) {
+    assert(sl != NULL);
+
+    __atomic_store_n(&sl->seq, __atomic_load_n(&sl->seq, __ATOMIC_RELAXED) + 1u, __ATOMIC_RELAXED);
+    // odd count has to be visible before any data store
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return OSAL_OK;
+}
+
+//! \brief End a write section.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_write_end(osal_seqlock_t *sl) {
+    assert(sl != NULL);
+
+    __atomic_store_n(&sl->seq, __atomic_load_n(&sl->seq, __ATOMIC_RELAXED) + 1u, __ATOMIC_RELEASE);
+
+    return OSAL_OK;
+}
+
+//! \brief Begin a read section.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \return Sequence count at start of read section.
+ */
+osal_uint32_t osal_seqlock_read_begin(const osal_seqlock_t *sl) {
+    assert(sl != NULL);
+
+    osal_uint32_t seq = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE);
+
+    while ((seq & 1u) != 0u) {
+        osal_cpu_relax();
+        seq = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE);
+    }
+
+    return seq;
+}
+
+//! \brief Check if a read section has to be retried.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[in]   seq     Sequence count returned by \ref osal_seqlock_read_begin.
+ *
+ * \return 1 if the data was modified during the read section, 0 otherwise.
+ */
+osal_bool_t osal_seqlock_read_retry(const osal_seqlock_t *sl, osal_uint32_t seq) {
+    assert(sl != NULL);
+
+    // data loads have to complete before the count is checked again
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return (__atomic_load_n(&sl->seq, __ATOMIC_RELAXED) != seq) ? 1u : 0u;
+}
+
+//! \brief Write data protected by seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Protected data, e.g. in shared memory.
+ * \param[in]   src     New data.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_write(osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len) {
+    assert(sl != NULL);
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    (void)osal_seqlock_write_begin(sl);
+    (void)memcpy(dst, src, len);
+    (void)osal_seqlock_write_end(sl);
+
+    return OSAL_OK;
+}
+
+//! \brief Read consistent snapshot of data protected by seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Snapshot buffer.
+ * \param[in]   src     Protected data, e.g. in shared memory.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_read(const osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len) {
+    assert(sl != NULL);
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    osal_uint32_t seq;
+
+    do {
+        seq = osal_seqlock_read_begin(sl);
+        (void)memcpy(dst, src, len);
+    } while (osal_seqlock_read_retry(sl, seq) != 0u);
+
+    return OSAL_OK;
+}
+
+//! \brief Try to read consistent snapshot of data protected by seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ * \param[out]  dst     Snapshot buffer, content is undefined on error.
+ * \param[in]   src     Protected data, e.g. in shared memory.
+ * \param[in]   len     Number of bytes to copy.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_tryread(const osal_seqlock_t *sl, osal_void_t *dst, const osal_void_t *src, osal_size_t len) {
+    assert(sl != NULL);
+    assert(dst != NULL);
+    assert(src != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint32_t seq = __atomic_load_n(&sl->seq, __ATOMIC_ACQUIRE);
+
+    if ((seq & 1u) != 0u) {
+        ret = OSAL_ERR_BUSY;
+    } else {
+        (void)memcpy(dst, src, len);
+
+        if (osal_seqlock_read_retry(sl, seq) != 0u) {
+            ret = OSAL_ERR_BUSY;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Destroys a seqlock.
+/*!
+ * \param[in]   sl      Pointer to osal seqlock structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_seqlock_destroy(osal_seqlock_t *sl) {
+    assert(sl != NULL);
+
+    (void)sl;
+
+    return OSAL_OK;
+}
+
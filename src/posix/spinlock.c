@@ -33,62 +33,292 @@
 #include <errno.h>
 #include <pthread.h>
 #include <assert.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 
-//! \brief Initialize a spinlock.
+#include "cpu.h"
+
+#define LIBOSAL_SPINLOCK_BACKOFF_MAX    64u         //!< \brief Maximum relax cycles between lock attempts.
+#define LIBOSAL_SPINLOCK_ROBUST_CHECK   1024u       //!< \brief Lock attempts between checks for a dead owner.
+#define LIBOSAL_SPINLOCK_CACHE_LINE     64u         //!< \brief Cache line size.
+#define LIBOSAL_SPINLOCK_MCS_NODES      8u          //!< \brief MCS spinlocks a task can hold or wait for at once.
+
+//! \brief Spinlock is implemented on the owner word instead of pthread.
+#define LIBOSAL_SPINLOCK_OWNER_WORD     (OSAL_SPINLOCK_ATTR__ROBUST | OSAL_SPINLOCK_ATTR__PROCESS_SHARED)
+
+//! \brief Queue node of a task holding or waiting for an MCS spinlock.
 /*!
- * \param[in]   mtx     Pointer to osal spinlock structure. Content is OS dependent.
- * \param[in]   attr    Pointer to initial spinlock attributes. Can be NULL then
- *                      the defaults of the underlying spinlock will be used.
+ * Each waiter spins on \p locked of its own node, which is cleared by 
+ * its predecessor on unlock. Nodes are padded and aligned to a cache 
+ * line so waiters do not disturb each other.
+ */
+struct osal_spinlock_mcs_node {
+    struct osal_spinlock_mcs_node *next;    //!< Successor in queue.
+    osal_uint32_t       locked;             //!< Waiter spins while set.
+    osal_uint32_t       used;               //!< Node is in use by owning task.
+    osal_uint8_t        pad[LIBOSAL_SPINLOCK_CACHE_LINE - sizeof(osal_void_t *) - (2u * sizeof(osal_uint32_t))];
+} __attribute__((aligned(LIBOSAL_SPINLOCK_CACHE_LINE)));
+
+static __thread struct osal_spinlock_mcs_node osal_spinlock_mcs_nodes[LIBOSAL_SPINLOCK_MCS_NODES]
+    __attribute__((aligned(LIBOSAL_SPINLOCK_CACHE_LINE)));
+
+static pthread_once_t osal_spinlock_tid_once = PTHREAD_ONCE_INIT;
+static __thread osal_uint32_t osal_spinlock_tid_cache = 0u;
+
+//! \brief Forget cached task id in child after fork.
+static osal_void_t osal_spinlock_tid_reset(osal_void_t) {
+    osal_spinlock_tid_cache = 0u;
+}
+
+//! \brief Register fork handler resetting the task id cache.
+static osal_void_t osal_spinlock_tid_atfork(osal_void_t) {
+    (void)pthread_atfork(NULL, NULL, osal_spinlock_tid_reset);
+}
+
+//! \brief Return system wide id of calling task.
+static osal_uint32_t osal_spinlock_tid(osal_void_t) {
+    if (osal_spinlock_tid_cache == 0u) {
+        (void)pthread_once(&osal_spinlock_tid_once, osal_spinlock_tid_atfork);
+#if defined(SYS_gettid)
+        osal_spinlock_tid_cache = (osal_uint32_t)syscall(SYS_gettid);
+#else
+        osal_spinlock_tid_cache = (osal_uint32_t)getpid();
+#endif
+    }
+
+    return osal_spinlock_tid_cache;
+}
+
+//! \brief Check if spinlock owner has died.
+/*!
+ * \param[in]   tid     Task id of owner.
+ *
+ * \return 1 if \p tid does not exist any more, 0 otherwise.
+ */
+static int osal_spinlock_owner_dead(osal_uint32_t tid) {
+    return ((kill((pid_t)tid, 0) == -1) && (errno == ESRCH)) ? 1 : 0;
+}
+
+//! \brief Lock a spinlock on its owner word.
+/*!
+ * Spins with exponential backoff until the owner word could be switched
+ * from 0 to the calling task id. A robust spinlock periodically checks 
+ * whether the owner still exists and takes over the lock from a dead one.
+ *
+ * \param[in]   mtx     Pointer to osal spinlock structure.
  *
  * \return OK or ERROR_CODE.
  */
-osal_retval_t osal_spinlock_init(osal_spinlock_t *mtx, const osal_spinlock_attr_t *attr) {
-    assert(mtx != NULL);
+static osal_retval_t osal_spinlock_owner_lock(osal_spinlock_t *mtx) {
+    osal_retval_t ret = OSAL_ERR_BUSY;
+    osal_uint32_t tid = osal_spinlock_tid();
+    osal_uint32_t backoff = 1u;
+    osal_uint32_t polls = 0u;
+    osal_uint32_t owner = __atomic_load_n(&mtx->owner, __ATOMIC_RELAXED);
 
-    osal_retval_t ret = OSAL_OK;
-    int posix_ret;
+    if (owner == tid) {
+        ret = OSAL_ERR_DEAD_LOCK;
+    }
 
-    (void)attr;
-/*
-    pthread_spinlockattr_t posix_attr;
-    pthread_spinlockattr_t *pposix_attr = NULL;
-
-    if (attr != NULL) {
-        pthread_spinlockattr_init(&posix_attr);
-
-        if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__NORMAL) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_NORMAL);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__ERRORCHECK) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_ERRORCHECK);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__RECURSIVE) {
-            pthread_spinlockattr_settype(&posix_attr, PTHREAD_SPINLOCK_RECURSIVE);
+    while (ret == OSAL_ERR_BUSY) {
+        if (owner == 0u) {
+            if (__atomic_compare_exchange_n(&mtx->owner, &owner, tid, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                ret = OSAL_OK;
+            }
+        } else if (((mtx->attr & OSAL_SPINLOCK_ATTR__ROBUST) != 0u) && 
+                ((++polls % LIBOSAL_SPINLOCK_ROBUST_CHECK) == 0u) && (osal_spinlock_owner_dead(owner) != 0)) {
+            // only one waiter wins the take over, others see the new owner
+            if (__atomic_compare_exchange_n(&mtx->owner, &owner, tid, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                ret = OSAL_ERR_OWNER_DEAD;
+            }
+        } else {
+            osal_cpu_backoff(&backoff, LIBOSAL_SPINLOCK_BACKOFF_MAX);
+            owner = __atomic_load_n(&mtx->owner, __ATOMIC_RELAXED);
         }
+    }
 
-        if (((*attr) & OSAL_SPINLOCK_ATTR__ROBUST) == OSAL_SPINLOCK_ATTR__ROBUST) {
-            pthread_spinlockattr_setrobust(&posix_attr, PTHREAD_SPINLOCK_ROBUST);
+    return ret;
+}
+
+//! \brief Busy-wait for a queued spinlock.
+/*!
+ * Backs off exponentially and yields the cpu once the maximum backoff is 
+ * reached. With fair hand-off the next owner may be preempted, plain 
+ * spinning would then burn the time slice it needs.
+ *
+ * \param[in,out]   backoff     Current number of relax cycles.
+ */
+static osal_void_t osal_spinlock_wait(osal_uint32_t *backoff) {
+    if (*backoff < LIBOSAL_SPINLOCK_BACKOFF_MAX) {
+        osal_cpu_backoff(backoff, LIBOSAL_SPINLOCK_BACKOFF_MAX);
+    } else {
+        (void)sched_yield();
+    }
+}
+
+//! \brief Lock a ticket spinlock.
+/*!
+ * Draws the next ticket and waits until it is served, so the spinlock 
+ * is handed over in FIFO order.
+ *
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ */
+static osal_void_t osal_spinlock_ticket_lock(osal_spinlock_t *mtx) {
+    osal_uint32_t ticket = __atomic_fetch_add(&mtx->ticket_next, 1u, __ATOMIC_RELAXED);
+    osal_uint32_t backoff = 1u;
+
+    while (__atomic_load_n(&mtx->ticket_owner, __ATOMIC_ACQUIRE) != ticket) {
+        osal_spinlock_wait(&backoff);
+    }
+}
+
+//! \brief Unlock a ticket spinlock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_spinlock_ticket_unlock(osal_spinlock_t *mtx) {
+    osal_retval_t ret = OSAL_OK;
+    osal_uint32_t owner = __atomic_load_n(&mtx->ticket_owner, __ATOMIC_RELAXED);
+
+    if (owner == __atomic_load_n(&mtx->ticket_next, __ATOMIC_RELAXED)) {
+        ret = OSAL_ERR_PERMISSION_DENIED;
+    } else {
+        __atomic_store_n(&mtx->ticket_owner, owner + 1u, __ATOMIC_RELEASE);
+    }
+
+    return ret;
+}
+
+//! \brief Check if queue node belongs to calling task.
+static int osal_spinlock_mcs_node_own(const struct osal_spinlock_mcs_node *node) {
+    return ((node >= &osal_spinlock_mcs_nodes[0]) && 
+            (node < &osal_spinlock_mcs_nodes[LIBOSAL_SPINLOCK_MCS_NODES])) ? 1 : 0;
+}
+
+//! \brief Lock an MCS spinlock.
+/*!
+ * Appends a queue node of the calling task to the waiter queue and spins 
+ * on that node until the predecessor hands over the spinlock.
+ *
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_spinlock_mcs_lock(osal_spinlock_t *mtx) {
+    osal_retval_t ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
+    struct osal_spinlock_mcs_node *node = NULL;
+    osal_uint32_t i;
+
+    for (i = 0u; (i < LIBOSAL_SPINLOCK_MCS_NODES) && (node == NULL); ++i) {
+        if (osal_spinlock_mcs_nodes[i].used == 0u) {
+            node = &osal_spinlock_mcs_nodes[i];
         }
+    }
+
+    if (osal_spinlock_mcs_node_own(__atomic_load_n(&mtx->mcs_holder, __ATOMIC_RELAXED)) != 0) {
+        ret = OSAL_ERR_DEAD_LOCK;
+    } else if (node != NULL) {
+        struct osal_spinlock_mcs_node *pred;
+        osal_uint32_t backoff = 1u;
 
-        if (((*attr) & OSAL_SPINLOCK_ATTR__PROCESS_SHARED) == OSAL_SPINLOCK_ATTR__PROCESS_SHARED) {
-            pthread_spinlockattr_setpshared(&posix_attr, PTHREAD_PROCESS_SHARED);
+        node->used = 1u;
+        node->next = NULL;
+        node->locked = 1u;
+
+        pred = __atomic_exchange_n(&mtx->mcs_tail, node, __ATOMIC_ACQ_REL);
+        if (pred != NULL) {
+            __atomic_store_n(&pred->next, node, __ATOMIC_RELEASE);
+
+            while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE) != 0u) {
+                osal_spinlock_wait(&backoff);
+            }
         }
-        
-        if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__NONE) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_NONE);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__INHERIT) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_INHERIT);
-        } else if (((*attr) & OSAL_SPINLOCK_ATTR__PROTOCOL__MASK) == OSAL_SPINLOCK_ATTR__PROTOCOL__PROTECT) {
-            pthread_spinlockattr_setprotocol(&posix_attr, PTHREAD_PRIO_PROTECT);
+
+        __atomic_store_n(&mtx->mcs_holder, node, __ATOMIC_RELAXED);
+        ret = OSAL_OK;
+    }
+
+    return ret;
+}
+
+//! \brief Unlock an MCS spinlock.
+/*!
+ * Hands the spinlock over to the successor of the owners queue node. If
+ * there is none yet, the queue is emptied or, if a waiter is just 
+ * enqueueing, the successor is awaited.
+ *
+ * \param[in]   mtx     Pointer to osal spinlock structure.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_spinlock_mcs_unlock(osal_spinlock_t *mtx) {
+    osal_retval_t ret = OSAL_OK;
+    struct osal_spinlock_mcs_node *node = __atomic_load_n(&mtx->mcs_holder, __ATOMIC_RELAXED);
+
+    if (osal_spinlock_mcs_node_own(node) == 0) {
+        ret = OSAL_ERR_PERMISSION_DENIED;
+    } else {
+        struct osal_spinlock_mcs_node *next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+        struct osal_spinlock_mcs_node *tail = node;
+
+        __atomic_store_n(&mtx->mcs_holder, NULL, __ATOMIC_RELAXED);
+
+        if ((next == NULL) && !__atomic_compare_exchange_n(&mtx->mcs_tail, &tail, NULL, 
+                    0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            while ((next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) == NULL) {
+                osal_cpu_relax();
+            }
         }
 
-        if (((*attr) & OSAL_SPINLOCK_ATTR__PRIOCEILING__MASK) != 0u) {
-            int prioceiling = (((*attr) & OSAL_SPINLOCK_ATTR__PRIOCEILING__MASK) >> OSAL_SPINLOCK_ATTR__PRIOCEILING__SHIFT);
-            pthread_spinlockattr_setprioceiling(&posix_attr, prioceiling);
+        if (next != NULL) {
+            __atomic_store_n(&next->locked, 0u, __ATOMIC_RELEASE);
         }
 
-        pposix_attr = &posix_attr;
-    }*/
+        node->used = 0u;
+    }
 
-    posix_ret = pthread_spin_init(&mtx->posix_sl, 0);//pposix_attr);
+    return ret;
+}
+
+//! \brief Initialize a spinlock.
+/*!
+ * \param[in]   mtx     Pointer to osal spinlock structure. Content is OS dependent.
+ * \param[in]   attr    Pointer to initial spinlock attributes. Can be NULL then
+ *                      the defaults of the underlying spinlock will be used.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_spinlock_init(osal_spinlock_t *mtx, const osal_spinlock_attr_t *attr) {
+    assert(mtx != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    int posix_ret = 0;
+
+    mtx->attr = (attr != NULL) ? *attr : 0u;
+    mtx->ticket_next = 0u;
+    mtx->ticket_owner = 0u;
+    mtx->mcs_tail = NULL;
+    mtx->mcs_holder = NULL;
+    __atomic_store_n(&mtx->owner, 0u, __ATOMIC_RELEASE);
+
+    if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__TICKET) {
+        // tickets work in shared memory but do not tell who holds them
+        if ((mtx->attr & OSAL_SPINLOCK_ATTR__ROBUST) != 0u) {
+            posix_ret = EINVAL;
+        }
+    } else if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__MCS) {
+        // queue nodes are task local memory
+        if ((mtx->attr & LIBOSAL_SPINLOCK_OWNER_WORD) != 0u) {
+            posix_ret = EINVAL;
+        }
+    } else if ((mtx->attr & LIBOSAL_SPINLOCK_OWNER_WORD) == 0u) {
+        // pthread spinlocks neither know their owner nor are they robust
+        posix_ret = pthread_spin_init(&mtx->posix_sl, PTHREAD_PROCESS_PRIVATE);
+    }
 
     if (posix_ret != 0) {
         if (posix_ret == EAGAIN) {
@@ -119,9 +349,20 @@ osal_retval_t osal_spinlock_lock(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret;
-    int posix_ret;
+    int posix_ret = 0;
+
+    if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__TICKET) {
+        osal_spinlock_ticket_lock(mtx);
+        ret = OSAL_OK;
+    } else if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__MCS) {
+        ret = osal_spinlock_mcs_lock(mtx);
+    } else if ((mtx->attr & LIBOSAL_SPINLOCK_OWNER_WORD) != 0u) {
+        ret = osal_spinlock_owner_lock(mtx);
+    } else {
+        posix_ret = pthread_spin_lock(&mtx->posix_sl);
+        ret = OSAL_OK;
+    }
 
-    posix_ret = pthread_spin_lock(&mtx->posix_sl);
     if (posix_ret != 0) {
         if (posix_ret == EAGAIN) {
             ret = OSAL_ERR_SYSTEM_LIMIT_REACHED;
@@ -138,8 +379,6 @@ osal_retval_t osal_spinlock_lock(osal_spinlock_t *mtx) {
         } else {
             ret = OSAL_ERR_UNAVAILABLE;
         }
-    } else {
-        ret = OSAL_OK;
     }
 
     return ret;
@@ -154,18 +393,29 @@ osal_retval_t osal_spinlock_lock(osal_spinlock_t *mtx) {
 osal_retval_t osal_spinlock_unlock(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
-    osal_retval_t ret;
-    int posix_ret;
+    osal_retval_t ret = OSAL_OK;
+    int posix_ret = 0;
+
+    if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__TICKET) {
+        ret = osal_spinlock_ticket_unlock(mtx);
+    } else if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__MCS) {
+        ret = osal_spinlock_mcs_unlock(mtx);
+    } else if ((mtx->attr & LIBOSAL_SPINLOCK_OWNER_WORD) != 0u) {
+        osal_uint32_t owner = osal_spinlock_tid();
+
+        if (!__atomic_compare_exchange_n(&mtx->owner, &owner, 0u, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            posix_ret = EPERM;
+        }
+    } else {
+        posix_ret = pthread_spin_unlock(&mtx->posix_sl);
+    }
 
-    posix_ret = pthread_spin_unlock(&mtx->posix_sl);
     if (posix_ret != 0) {
         if (posix_ret == EPERM) {
             ret = OSAL_ERR_PERMISSION_DENIED;
         } else {
             ret = OSAL_ERR_UNAVAILABLE;
         }
-    } else {
-        ret = OSAL_OK;
     }
 
     return ret;
@@ -181,9 +431,24 @@ osal_retval_t osal_spinlock_destroy(osal_spinlock_t *mtx) {
     assert(mtx != NULL);
 
     osal_retval_t ret = OSAL_OK;
-    int posix_ret;
+    int posix_ret = 0;
+
+    if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__TICKET) {
+        if (__atomic_load_n(&mtx->ticket_owner, __ATOMIC_RELAXED) != __atomic_load_n(&mtx->ticket_next, __ATOMIC_RELAXED)) {
+            posix_ret = EBUSY;
+        }
+    } else if ((mtx->attr & OSAL_SPINLOCK_ATTR__TYPE__MASK) == OSAL_SPINLOCK_ATTR__TYPE__MCS) {
+        if (__atomic_load_n(&mtx->mcs_tail, __ATOMIC_RELAXED) != NULL) {
+            posix_ret = EBUSY;
+        }
+    } else if ((mtx->attr & LIBOSAL_SPINLOCK_OWNER_WORD) != 0u) {
+        if (__atomic_load_n(&mtx->owner, __ATOMIC_RELAXED) != 0u) {
+            posix_ret = EBUSY;
+        }
+    } else {
+        posix_ret = pthread_spin_destroy(&mtx->posix_sl);
+    }
 
-    posix_ret = pthread_spin_destroy(&mtx->posix_sl);
     if (posix_ret != 0) {
         ret = OSAL_ERR_OPERATION_FAILED;
     }
@@ -36,6 +36,7 @@
 #include <libosal/config.h>
 #include <libosal/osal.h>
 #include <libosal/task.h>
+#include <libosal/trace.h>
 #include <libosal/io.h>
 
 #if LIBOSAL_HAVE_SYS_PRCTL_H == 1
@@ -44,11 +45,29 @@
 
 #include <errno.h>
 #include <assert.h>
+#include <stdlib.h>
+#include <time.h>
 
 #include <string.h>
 
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+#include "futex.h"
+#endif
+
+#define LIBOSAL_TASK_PERIODIC_TRACE_CNT     1000u       //!< \brief Handler calls recorded in periodic task trace.
+
+//! \brief State of a periodic task.
+struct osal_task_periodic {
+    osal_uint64_t period;                   //!< Period in [ns].
+    osal_uint64_t offset;                   //!< Release offset within period in [ns].
+    osal_task_periodic_handler_t handler;   //!< User handler.
+    osal_task_handler_arg_t arg;            //!< User handler argument.
+    osal_task_periodic_stats_t stats;       //!< Cycle statistics.
+};
+
 typedef struct posix_start_args {
-    int running;
+    osal_uint32_t *running;             //!< Set to 1 by the task, futex word in the task handle.
+    int apply_attr;                     //!< Task has to apply scheduling attributes itself.
 
     osal_task_handler_t user_handler;
     osal_task_handler_arg_t user_arg;
@@ -58,23 +77,26 @@ typedef struct posix_start_args {
 static void *posix_task_wrapper(void *args) {
     // cppcheck-suppress misra-c2012-11.5
     posix_start_args_t *start_args = (posix_start_args_t *)args;
+    osal_uint32_t *running = start_args->running;
 
-    // copy all stuff to local stack-objects, they will be destroyed after 'start_args->running = 1;'
+    // copy all stuff to local stack-objects, they will be destroyed after '*start_args->running = 1;'
     osal_task_handler_t user_handler = start_args->user_handler;
     osal_task_handler_arg_t user_arg = start_args->user_arg;
     const osal_task_attr_t *user_attr = start_args->user_attr;
 
     if (user_attr != NULL) {
-        if (user_attr->policy != 0u) {
-            (void)osal_task_set_policy(NULL, user_attr->policy);
-        }
+        if (start_args->apply_attr != 0) {
+            if (user_attr->policy != 0u) {
+                (void)osal_task_set_policy(NULL, user_attr->policy);
+            }
 
-        if (user_attr->priority != 0u) {
-            (void)osal_task_set_priority(NULL, user_attr->priority);
-        }
+            if (user_attr->priority != 0u) {
+                (void)osal_task_set_priority(NULL, user_attr->priority);
+            }
 
-        if (user_attr->affinity > 0u) {
-            (void)osal_task_set_affinity(NULL, user_attr->affinity);
+            if (user_attr->affinity > 0u) {
+                (void)osal_task_set_affinity(NULL, user_attr->affinity);
+            }
         }
 
 #if LIBOSAL_HAVE_SYS_PRCTL_H == 1
@@ -84,14 +106,79 @@ static void *posix_task_wrapper(void *args) {
 #endif
     }       
         
-    // after setting running to 1, we start_args will be invalid
-    start_args->running = 1;
+    // after setting running to 1, start_args will be invalid. The futex word
+    // lives in the task handle, which outlives the creator returning, so
+    // the wakeup never hits a reused stack address.
+    __atomic_store_n(running, 1u, __ATOMIC_RELEASE);
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+    osal_futex_wake(running, 1, 0);
+#endif
 
     return (*user_handler)(user_arg);
 }
 
+//! \brief Fill pthread attributes from osal task attributes.
+/*!
+ * Policy and priority are based on the calling thread like with 
+ * \ref osal_task_set_policy and \ref osal_task_set_priority, so the task
+ * starts running with its final scheduling parameters.
+ *
+ * \param[out]  pattr   Initialized pthread attributes.
+ * \param[in]   attr    Pointer to osal task attributes.
+ */
+static void posix_task_fill_attr(pthread_attr_t *pattr, const osal_task_attr_t *attr) {
+    int policy;
+    struct sched_param param;
+
+    if (((attr->policy != 0u) || (attr->priority != 0u)) &&
+            (pthread_getschedparam(pthread_self(), &policy, &param) == 0)) {
+        if (attr->policy == OSAL_SCHED_POLICY_FIFO) {
+            policy = SCHED_FIFO;
+        } else if (attr->policy == OSAL_SCHED_POLICY_ROUND_ROBIN) {
+            policy = SCHED_RR;
+        } else if (attr->policy != 0u) {
+            policy = SCHED_OTHER;
+        } else {
+            // keep policy of calling thread
+        }
+
+        if (attr->priority != 0u) {
+            param.sched_priority = attr->priority;
+        }
+
+        if (sched_get_priority_min(policy) > param.sched_priority) {
+            param.sched_priority = sched_get_priority_min(policy);
+        } else if (sched_get_priority_max(policy) < param.sched_priority) {
+            param.sched_priority = sched_get_priority_max(policy);
+        }
+
+        (void)pthread_attr_setinheritsched(pattr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(pattr, policy);
+        (void)pthread_attr_setschedparam(pattr, &param);
+    }
+
+#if LIBOSAL_HAVE_PTHREAD_SETAFFINITY_NP
+    if (attr->affinity > 0u) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (uint32_t i = 0u; i < (sizeof(attr->affinity) * 8u); ++i) {
+            if ((attr->affinity & ((uint32_t)1u << i)) != 0u) {
+                CPU_SET(i, &cpuset);
+            }
+        }
+
+        (void)pthread_attr_setaffinity_np(pattr, sizeof(cpu_set_t), &cpuset);
+    }
+#endif
+}
+
 //! \brief Create a task.
 /*!
+ * Scheduling policy, priority and affinity are set before the task starts
+ * running. If the caller is not allowed to create a task with these 
+ * scheduling parameters, the task is created with the defaults and tries
+ * to apply them itself. Returns after the task applied its attributes.
+ *
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
  * \param[in]   attr    Pointer to initial task attributes. Can be NULL then
  *                      the defaults of the underlying task will be used.
@@ -106,9 +193,26 @@ osal_retval_t osal_task_create(osal_task_t *hdl, const osal_task_attr_t *attr,
 
     osal_retval_t ret = OSAL_OK;
     int local_ret;
-    posix_start_args_t start_args = { 0, handler, arg, attr };
-
-    local_ret = pthread_create(&hdl->tid, NULL, posix_task_wrapper, &start_args);
+    posix_start_args_t start_args = { &hdl->started, 0, handler, arg, attr };
+
+    hdl->periodic = NULL;
+    hdl->started = 0u;
+
+    if (attr != NULL) {
+        pthread_attr_t pattr;
+        (void)pthread_attr_init(&pattr);
+        posix_task_fill_attr(&pattr, attr);
+        local_ret = pthread_create(&hdl->tid, &pattr, posix_task_wrapper, &start_args);
+        (void)pthread_attr_destroy(&pattr);
+
+        if ((local_ret == EPERM) || (local_ret == EINVAL)) {
+            // e.g. real-time policy without privileges, offline cpu
+            start_args.apply_attr = 1;
+            local_ret = pthread_create(&hdl->tid, NULL, posix_task_wrapper, &start_args);
+        }
+    } else {
+        local_ret = pthread_create(&hdl->tid, NULL, posix_task_wrapper, &start_args);
+    }
     
     if (local_ret != 0) {
         if (local_ret == EAGAIN) {
@@ -124,14 +228,159 @@ osal_retval_t osal_task_create(osal_task_t *hdl, const osal_task_attr_t *attr,
 
     if (ret == OSAL_OK) {
         // only wait if thread has been started successfully
-        while (start_args.running == 0) {
-            osal_sleep(1000000);
+        while (__atomic_load_n(&hdl->started, __ATOMIC_ACQUIRE) == 0u) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+            (void)osal_futex_wait(&hdl->started, 0u, 0, NULL);
+#else
+            (void)sched_yield();
+#endif
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Return current time on monotonic clock in [ns].
+static osal_uint64_t posix_task_monotonic_nsec(void) {
+    struct timespec ts = { 0, 0 };
+
+    (void)clock_gettime(LIBOSAL_CLOCK_MONOTONIC, &ts);
+
+    return ((osal_uint64_t)ts.tv_sec * NSEC_PER_SEC) + (osal_uint64_t)ts.tv_nsec;
+}
+
+//! \brief Raise statistics maximum.
+static void posix_task_periodic_max(osal_uint64_t *max, osal_uint64_t val) {
+    if (val > __atomic_load_n(max, __ATOMIC_RELAXED)) {
+        __atomic_store_n(max, val, __ATOMIC_RELAXED);
+    }
+}
+
+//! \brief Release loop of periodic task.
+/*!
+ * \param[in]   arg     Pointer to periodic task state.
+ *
+ * \return NULL
+ */
+static void *posix_task_periodic_wrapper(void *arg) {
+    // cppcheck-suppress misra-c2012-11.5
+    struct osal_task_periodic *periodic = (struct osal_task_periodic *)arg;
+    osal_task_periodic_stats_t *stats = &periodic->stats;
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t now = posix_task_monotonic_nsec();
+    osal_uint64_t release = (((now / periodic->period) + 1u) * periodic->period) + periodic->offset;
+
+    while (ret == OSAL_OK) {
+        struct timespec ts = { (time_t)(release / NSEC_PER_SEC), (long)(release % NSEC_PER_SEC) };
+
+        while (clock_nanosleep(LIBOSAL_CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+
+        now = posix_task_monotonic_nsec();
+        osal_trace_time(stats->trace, now);
+        posix_task_periodic_max(&stats->max_latency, now - release);
+        (void)__atomic_add_fetch(&stats->cycles, 1u, __ATOMIC_RELAXED);
+
+        ret = (*periodic->handler)(periodic->arg);
+
+        osal_uint64_t end = posix_task_monotonic_nsec();
+        posix_task_periodic_max(&stats->max_exec, end - now);
+
+        release += periodic->period;
+        if (end >= release) {
+            // skip missed releases, keep the phase
+            osal_uint64_t missed = ((end - release) / periodic->period) + 1u;
+            (void)__atomic_add_fetch(&stats->overruns, missed, __ATOMIC_RELAXED);
+            release += missed * periodic->period;
+        }
+    }
+
+    return NULL;
+}
+
+//! \brief Create a periodic task.
+/*!
+ * \param[in]   hdl         Pointer to osal task structure. Content is OS dependent.
+ * \param[in]   attr        Pointer to initial task attributes. Can be NULL then
+ *                          the defaults of the underlying task will be used.
+ * \param[in]   period_ns   Period in [ns].
+ * \param[in]   offset_ns   Release offset within period in [ns].
+ * \param[in]   handler     Handler to be called each period.
+ * \param[in]   arg         Pointer to argument passed to handler.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_create_periodic(osal_task_t *hdl, const osal_task_attr_t *attr, 
+        osal_uint64_t period_ns, osal_uint64_t offset_ns, 
+        osal_task_periodic_handler_t handler, osal_task_handler_arg_t arg) 
+{
+    assert(hdl != NULL);
+    assert(handler != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    struct osal_task_periodic *periodic = NULL;
+
+    if ((period_ns == 0u) || (offset_ns >= period_ns)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        periodic = calloc(1, sizeof(struct osal_task_periodic));
+        if (periodic == NULL) {
+            ret = OSAL_ERR_OUT_OF_MEMORY;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        periodic->period = period_ns;
+        periodic->offset = offset_ns;
+        periodic->handler = handler;
+        periodic->arg = arg;
+
+        ret = osal_trace_alloc(&periodic->stats.trace, LIBOSAL_TASK_PERIODIC_TRACE_CNT);
+        if (ret != OSAL_OK) {
+            free(periodic);
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        ret = osal_task_create(hdl, attr, posix_task_periodic_wrapper, periodic);
+        if (ret == OSAL_OK) {
+            hdl->periodic = periodic;
+        } else {
+            osal_trace_free(periodic->stats.trace);
+            free(periodic);
         }
     }
 
     return ret;
 }
 
+//! \brief Get cycle statistics of a periodic task.
+/*!
+ * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
+ * \param[out]  stats   Returns current statistics.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_task_get_periodic_stats(osal_task_t *hdl, osal_task_periodic_stats_t *stats) {
+    assert(hdl != NULL);
+    assert(stats != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (hdl->periodic == NULL) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        osal_task_periodic_stats_t *src = &hdl->periodic->stats;
+
+        stats->cycles = __atomic_load_n(&src->cycles, __ATOMIC_RELAXED);
+        stats->overruns = __atomic_load_n(&src->overruns, __ATOMIC_RELAXED);
+        stats->max_latency = __atomic_load_n(&src->max_latency, __ATOMIC_RELAXED);
+        stats->max_exec = __atomic_load_n(&src->max_exec, __ATOMIC_RELAXED);
+        stats->trace = src->trace;
+    }
+
+    return ret;
+}
+
 //! \brief Joins a task.
 /*!
  * \param[in]   hdl     Pointer to osal task structure. Content is OS dependent.
@@ -146,6 +395,12 @@ osal_retval_t osal_task_join(osal_task_t *hdl, osal_task_retval_t *retval) {
     local_ret = pthread_join(hdl->tid, retval);
     (void)local_ret;
 
+    if ((local_ret == 0) && (hdl->periodic != NULL)) {
+        osal_trace_free(hdl->periodic->stats.trace);
+        free(hdl->periodic);
+        hdl->periodic = NULL;
+    }
+
     if (local_ret != 0) {
         if (local_ret == EDEADLK) {
             ret = OSAL_ERR_DEAD_LOCK;
@@ -30,6 +30,7 @@
 
 #include <libosal/osal.h>
 #include <libosal/timer.h>
+#include <libosal/seqlock.h>
 
 // cppcheck-suppress misra-c2012-21.6
 #include <stdio.h>
@@ -38,9 +39,201 @@
 #include <assert.h>
 #include <errno.h>
 
+#include "cpu.h"
+#include "tsc.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__SIZEOF_INT128__)
+#include <cpuid.h>
+#define LIBOSAL_HAVE_TSC
+#endif
+
 //! Global configuration option for the clock source used by the timer
 //! functions.
-static int global_clock_id = CLOCK_REALTIME;
+static int global_clock_id = CLOCK_MONOTONIC;
+
+#define LIBOSAL_TSC_SHIFT               32u         //!< \brief Fixed point shift of cycles to ns factor.
+#define LIBOSAL_TSC_CALIBRATE_MIN       10000000u   //!< \brief Minimum calibration interval in [ns].
+#define LIBOSAL_TSC_SAMPLE_TRIES        5           //!< \brief Reference samples taken, the tightest one is used.
+#define LIBOSAL_TSC_REBASE_INTERVAL     100000000u  //!< \brief Interval of re-syncing with the monotonic clock in [ns].
+#define LIBOSAL_TSC_SLEW_SHIFT          10u         //!< \brief Rate correction is limited to factor >> LIBOSAL_TSC_SLEW_SHIFT.
+#define LIBOSAL_TSC_STEP_MIN            1000000u    //!< \brief Lag behind monotonic clock in [ns] which is stepped instead of slewed.
+
+//! TSC clock source state.
+/*!
+ * The conversion parameters are published with \p lock, readers may run 
+ * concurrently to a re-sync or to \ref osal_timer_set_clock_source.
+ * Writers are serialized with \p writing.
+ */
+static struct {
+    int             invariant;      //!< \brief TSC is invariant and a reference was taken.
+    int             active;         //!< \brief LIBOSAL_CLOCK_TSC is selected and calibrated.
+    int             writing;        //!< \brief Conversion parameters are being updated.
+    osal_seqlock_t  lock;           //!< \brief Protects conversion parameters below.
+    osal_uint64_t   ref_cycles;     //!< \brief Cycles of calibration reference from osal_init.
+    osal_uint64_t   ref_nsec;       //!< \brief Monotonic time of calibration reference.
+    osal_uint64_t   base_cycles;    //!< \brief Cycles at base_nsec.
+    osal_uint64_t   base_nsec;      //!< \brief Monotonic time of conversion base.
+    osal_uint64_t   mult;           //!< \brief ns per cycle, shifted by LIBOSAL_TSC_SHIFT.
+    osal_uint64_t   rebase_cycles;  //!< \brief Cycles after base until next re-sync.
+} global_tsc = { 0, 0, 0, { 0u }, 0u, 0u, 0u, 0u, 0u, 0u };
+
+#ifdef LIBOSAL_HAVE_TSC
+//! Converts cycles to time with given conversion base, cycles may be before the base.
+static inline osal_uint64_t osal_tsc_convert(osal_uint64_t cycles, osal_uint64_t base_cycles, 
+        osal_uint64_t base_nsec, osal_uint64_t mult) 
+{
+    osal_int64_t delta = (osal_int64_t)(cycles - base_cycles);
+    osal_uint64_t ret;
+
+    if (delta >= 0) {
+        ret = base_nsec + (osal_uint64_t)(((unsigned __int128)delta * mult) >> LIBOSAL_TSC_SHIFT);
+    } else {
+        ret = base_nsec - (osal_uint64_t)(((unsigned __int128)(-delta) * mult) >> LIBOSAL_TSC_SHIFT);
+    }
+
+    return ret;
+}
+
+//! Takes a pair of TSC and monotonic time as close together as possible.
+static void osal_tsc_sample(osal_uint64_t *cycles, osal_uint64_t *nsec) {
+    osal_uint64_t best = UINT64_MAX;
+    int i;
+
+    for (i = 0; i < LIBOSAL_TSC_SAMPLE_TRIES; ++i) {
+        struct timespec ts;
+        osal_uint64_t before = __builtin_ia32_rdtsc();
+        (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+        osal_uint64_t after = __builtin_ia32_rdtsc();
+
+        if ((after - before) < best) {
+            best = after - before;
+            *cycles = before + ((after - before) / 2u);
+            *nsec = ((osal_uint64_t)ts.tv_sec * NSEC_PER_SEC) + (osal_uint64_t)ts.tv_nsec;
+        }
+    }
+}
+
+//! Publishes new conversion parameters, caller has to own global_tsc.writing.
+static void osal_tsc_publish(osal_uint64_t cycles, osal_uint64_t nsec, osal_uint64_t mult) {
+    (void)osal_seqlock_write_begin(&global_tsc.lock);
+    global_tsc.base_cycles = cycles;
+    global_tsc.base_nsec = nsec;
+    global_tsc.mult = mult;
+    global_tsc.rebase_cycles = (osal_uint64_t)(((unsigned __int128)LIBOSAL_TSC_REBASE_INTERVAL << 
+                LIBOSAL_TSC_SHIFT) / mult);
+    (void)osal_seqlock_write_end(&global_tsc.lock);
+}
+
+//! Re-syncs the conversion with the monotonic clock.
+/*!
+ * The rate is estimated over the whole time since the reference from 
+ * osal_init and corrected so that the TSC time, which stays continuous at
+ * the new base, meets the monotonic clock again at the next re-sync. The 
+ * time is never stepped backwards, only a large lag is stepped forwards.
+ */
+static void osal_tsc_rebase(void) {
+    int expected = 0;
+
+    if (__atomic_compare_exchange_n(&global_tsc.writing, &expected, 1, 
+                0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        osal_uint64_t cycles, nsec;
+        osal_tsc_sample(&cycles, &nsec);
+
+        osal_uint64_t est = (osal_uint64_t)(((unsigned __int128)(nsec - global_tsc.ref_nsec) << 
+                    LIBOSAL_TSC_SHIFT) / (cycles - global_tsc.ref_cycles));
+        osal_uint64_t tsc_nsec = osal_tsc_convert(cycles, global_tsc.base_cycles, 
+                global_tsc.base_nsec, global_tsc.mult);
+        osal_int64_t offset = (osal_int64_t)(nsec - tsc_nsec);
+
+        if (offset > (osal_int64_t)LIBOSAL_TSC_STEP_MIN) {
+            osal_tsc_publish(cycles, nsec, est);
+        } else {
+            osal_uint64_t interval = (osal_uint64_t)(((unsigned __int128)LIBOSAL_TSC_REBASE_INTERVAL << 
+                        LIBOSAL_TSC_SHIFT) / est);
+            osal_int64_t max_corr = (osal_int64_t)(est >> LIBOSAL_TSC_SLEW_SHIFT);
+            osal_int64_t corr = (osal_int64_t)(((__int128)offset << LIBOSAL_TSC_SHIFT) / (__int128)interval);
+
+            if (corr > max_corr) {
+                corr = max_corr;
+            } else if (corr < -max_corr) {
+                corr = -max_corr;
+            }
+
+            osal_tsc_publish(cycles, tsc_nsec, (osal_uint64_t)((osal_int64_t)est + corr));
+        }
+
+        __atomic_store_n(&global_tsc.writing, 0, __ATOMIC_RELEASE);
+    }
+}
+
+//! Converts current TSC to monotonic time in nanoseconds.
+static osal_uint64_t osal_tsc_now(void) {
+    osal_uint64_t ret;
+    osal_uint32_t seq;
+    int rebase;
+
+    do {
+        seq = osal_seqlock_read_begin(&global_tsc.lock);
+        osal_uint64_t cycles = __builtin_ia32_rdtsc();
+        ret = osal_tsc_convert(cycles, global_tsc.base_cycles, global_tsc.base_nsec, global_tsc.mult);
+        rebase = ((cycles - global_tsc.base_cycles) >= global_tsc.rebase_cycles) ? 1 : 0;
+    } while (osal_seqlock_read_retry(&global_tsc.lock, seq) != 0u);
+
+    if (rebase != 0) {
+        osal_tsc_rebase();
+    }
+
+    return ret;
+}
+#endif
+
+// Checks for an invariant TSC and takes the calibration reference.
+osal_void_t osal_timer_tsc_init(void) {
+#ifdef LIBOSAL_HAVE_TSC
+    unsigned int eax, ebx, ecx, edx;
+
+    // CPUID.80000007H:EDX[8] - invariant TSC, constant rate in all ACPI P-, C- and T-states
+    if ((__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) != 0) && ((edx & (1u << 8u)) != 0u)) {
+        osal_tsc_sample(&global_tsc.ref_cycles, &global_tsc.ref_nsec);
+        global_tsc.invariant = 1;
+    }
+#endif
+}
+
+//! Finishes calibration against the reference from osal_init.
+static int osal_timer_tsc_calibrate(void) {
+    int ret = 0;
+
+#ifdef LIBOSAL_HAVE_TSC
+    if (global_tsc.invariant != 0) {
+        int expected = 0;
+        osal_uint64_t cycles, nsec;
+        osal_tsc_sample(&cycles, &nsec);
+
+        if ((nsec - global_tsc.ref_nsec) < LIBOSAL_TSC_CALIBRATE_MIN) {
+            struct timespec ts = { 0, (long)(LIBOSAL_TSC_CALIBRATE_MIN - (nsec - global_tsc.ref_nsec)) };
+            while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR) {}
+            osal_tsc_sample(&cycles, &nsec);
+        }
+
+        while (__atomic_compare_exchange_n(&global_tsc.writing, &expected, 1, 
+                    0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == 0) {
+            expected = 0;
+            osal_cpu_relax();
+        }
+
+        if (cycles > global_tsc.ref_cycles) {
+            unsigned __int128 scaled = (unsigned __int128)(nsec - global_tsc.ref_nsec) << LIBOSAL_TSC_SHIFT;
+            osal_tsc_publish(cycles, nsec, (osal_uint64_t)(scaled / (cycles - global_tsc.ref_cycles)));
+            ret = 1;
+        }
+
+        __atomic_store_n(&global_tsc.writing, 0, __ATOMIC_RELEASE);
+    }
+#endif
+
+    return ret;
+}
 
 // sleep in nanoseconds
 void osal_sleep(osal_uint64_t nsec) {
@@ -66,7 +259,7 @@ osal_retval_t osal_sleep_until(osal_timer_t *timer) {
     struct timespec ts = { timer->sec, timer->nsec };
 
     do {
-        local_ret = clock_nanosleep(global_clock_id, TIMER_ABSTIME, &ts, NULL);
+        local_ret = clock_nanosleep(osal_timer_clock(timer), TIMER_ABSTIME, &ts, NULL);
     } while (local_ret == EINTR);
 
     if (local_ret == EINVAL) {
@@ -83,11 +276,20 @@ osal_retval_t osal_sleep_until_nsec(osal_uint64_t nsec) {
     osal_timer_t abs_to;
     abs_to.sec = nsec / NSEC_PER_SEC;
     abs_to.nsec = nsec % NSEC_PER_SEC;
+    osal_timer_set_clock(&abs_to, global_clock_id);
     return osal_sleep_until(&abs_to);
 }
 
 //! Sets globally the internal clock source
-void osal_timer_set_clock_source(int clock_id) { global_clock_id = clock_id; }
+void osal_timer_set_clock_source(int clock_id) {
+    if (clock_id == LIBOSAL_CLOCK_TSC) {
+        global_clock_id = CLOCK_MONOTONIC;
+        __atomic_store_n(&global_tsc.active, osal_timer_tsc_calibrate(), __ATOMIC_RELEASE);
+    } else {
+        global_clock_id = clock_id;
+        __atomic_store_n(&global_tsc.active, 0, __ATOMIC_RELEASE);
+    }
+}
 
 //! Returns the globally configured internal clock source
 int osal_timer_get_clock_source(){
@@ -100,12 +302,21 @@ osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
     osal_retval_t ret = OSAL_OK;
 
     struct timespec ts;
+#ifdef LIBOSAL_HAVE_TSC
+    if (__atomic_load_n(&global_tsc.active, __ATOMIC_ACQUIRE) != 0) {
+        osal_uint64_t nsec = osal_tsc_now();
+        timer->sec = nsec / NSEC_PER_SEC;
+        timer->nsec = nsec % NSEC_PER_SEC;
+        osal_timer_set_clock(timer, global_clock_id);
+    } else
+#endif
     if (clock_gettime(global_clock_id, &ts) == -1) {
         perror("clock_gettime");
         ret = OSAL_ERR_UNAVAILABLE;
     } else {
         timer->sec = ts.tv_sec;
         timer->nsec = ts.tv_nsec;
+        osal_timer_set_clock(timer, global_clock_id);
     }
 
     return ret;
@@ -114,11 +325,19 @@ osal_retval_t osal_timer_gettime(osal_timer_t *timer) {
 // gets time in nanoseconds
 osal_uint64_t osal_timer_gettime_nsec(void) {
     osal_uint64_t ret = 0;
-    osal_timer_t tmr = { 0, 0 };
-    int local_ret = osal_timer_gettime(&tmr);
 
-    if (local_ret == OSAL_OK) {
-        ret = ((tmr.sec * NSEC_PER_SEC) + tmr.nsec);
+#ifdef LIBOSAL_HAVE_TSC
+    if (__atomic_load_n(&global_tsc.active, __ATOMIC_ACQUIRE) != 0) {
+        ret = osal_tsc_now();
+    } else
+#endif
+    {
+        osal_timer_t tmr = { 0, 0, 0 };
+        int local_ret = osal_timer_gettime(&tmr);
+
+        if (local_ret == OSAL_OK) {
+            ret = ((tmr.sec * NSEC_PER_SEC) + tmr.nsec);
+        }
     }
 
     return ret;
@@ -128,29 +347,54 @@ osal_uint64_t osal_timer_gettime_nsec(void) {
 void osal_timer_init(osal_timer_t *timer, osal_uint64_t timeout) {
     assert(timer != NULL);
 
-    struct timespec ts;
-    if (clock_gettime(global_clock_id, &ts) == -1) {
+    if (osal_timer_init_clock(timer, global_clock_id, timeout) != OSAL_OK) {
         perror("clock_gettime");
     }
+}
+
+// initialize timer on given clock with timeout
+osal_retval_t osal_timer_init_clock(osal_timer_t *timer, int clock_id, osal_uint64_t timeout) {
+    assert(timer != NULL);
 
+    osal_retval_t ret = OSAL_OK;
+    struct timespec ts;
     osal_timer_t a;
-    osal_timer_t b;
-    a.sec = ts.tv_sec;
-    a.nsec = ts.tv_nsec;
 
-    b.sec = (timeout / NSEC_PER_SEC);
-    b.nsec = (timeout % NSEC_PER_SEC);
+    if (clock_id == global_clock_id) {
+        // same time base as osal_timer_gettime, e.g. with LIBOSAL_CLOCK_TSC
+        ret = osal_timer_gettime(&a);
+    } else if (clock_gettime(clock_id, &ts) == -1) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        a.sec = ts.tv_sec;
+        a.nsec = ts.tv_nsec;
+        osal_timer_set_clock(&a, clock_id);
+    }
+
+    if (ret == OSAL_OK) {
+        osal_timer_t b;
+
+        b.sec = (timeout / NSEC_PER_SEC);
+        b.nsec = (timeout % NSEC_PER_SEC);
+
+        osal_timer_add(&a, &b, timer);
+    }
 
-    osal_timer_add(&a, &b, timer);
+    return ret;
 }
 
 // checks if timer is expired
 osal_retval_t osal_timer_expired(osal_timer_t *timer) {
     assert(timer != NULL);
 
-    osal_timer_t act = { 0, 0 };
+    osal_timer_t act = { 0, 0, 0 };
     osal_retval_t ret = OSAL_OK;
-    ret = osal_timer_gettime(&act);    
+
+    if (osal_timer_clock(timer) == global_clock_id) {
+        ret = osal_timer_gettime(&act);
+    } else {
+        ret = osal_timer_init_clock(&act, osal_timer_clock(timer), 0u);
+    }
 
     if (ret == OSAL_OK) {
         if (osal_timer_cmp(&act, timer, <) == 0) {
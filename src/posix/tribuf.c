@@ -0,0 +1,343 @@
+/**
+ * \file posix/tribuf.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL tribuf posix source.
+ *
+ * OSAL tribuf posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/tribuf.h>
+#include <libosal/osal.h>
+#include <libosal/config.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <sys/mman.h>
+
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+#include "futex.h"
+#endif
+
+#define LIBOSAL_TRIBUF_MAGIC        0x00AFFE30u     //!< \brief Triple buffer is initialized.
+#define LIBOSAL_TRIBUF_MAGIC_INIT   0x00AFFEFFu     //!< \brief Triple buffer is being initialized.
+#define LIBOSAL_TRIBUF_CACHE_LINE   64u             //!< \brief Cache line size.
+#define LIBOSAL_TRIBUF_INIT_POLL    100000u         //!< \brief Poll interval waiting for initialization in [ns].
+#define LIBOSAL_TRIBUF_INIT_POLLS   10000u          //!< \brief Maximum polls waiting for initialization.
+#define LIBOSAL_TRIBUF_POLL_NSEC    100000u         //!< \brief Poll interval waiting for data without futex.
+
+#define LIBOSAL_TRIBUF_STATE_INDEX  0x3u            //!< \brief Index of middle buffer.
+#define LIBOSAL_TRIBUF_STATE_FRESH  0x4u            //!< \brief Middle buffer holds an unread sample.
+
+//! \brief Triple buffer in shared memory.
+/*!
+ * \p state holds the index of the middle buffer and whether it was 
+ * published after the last acquire. Producer and consumer exchange their
+ * private \p back or \p front index with it, each living on its own 
+ * cache line. \p state doubles as futex word for a waiting consumer, which 
+ * registers in \p waiters so the producer only issues a futex wake if needed.
+ */
+struct osal_tribuf_shm {
+    osal_uint32_t       magic;              //!< Triple buffer is initialized.
+    osal_uint32_t       pad0;
+    osal_uint64_t       size;               //!< Sample size in bytes.
+    osal_uint64_t       stride;             //!< Distance between buffers in bytes.
+    osal_uint8_t        pad1[LIBOSAL_TRIBUF_CACHE_LINE - (3u * sizeof(osal_uint64_t))];
+    osal_uint32_t       state;              //!< Middle buffer index and fresh flag.
+    osal_uint32_t       waiters;            //!< Number of consumers waiting for data.
+    osal_uint8_t        pad2[LIBOSAL_TRIBUF_CACHE_LINE - sizeof(osal_uint64_t)];
+    osal_uint32_t       back;               //!< Buffer index owned by producer.
+    osal_uint8_t        pad3[LIBOSAL_TRIBUF_CACHE_LINE - sizeof(osal_uint32_t)];
+    osal_uint32_t       front;              //!< Buffer index owned by consumer.
+    osal_uint8_t        pad4[LIBOSAL_TRIBUF_CACHE_LINE - sizeof(osal_uint32_t)];
+    osal_uint8_t        data[0];
+};
+
+//! \brief Return buffer of index.
+static osal_uint8_t *osal_tribuf_data(struct osal_tribuf_shm *buf, osal_uint32_t idx) {
+    return &buf->data[idx * buf->stride];
+}
+
+//! \brief Map and initialize triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Triple buffer attributes.
+ * \param[in]   size    Sample size, 0 to attach only.
+ *
+ * \return OK or ERROR_CODE.
+ */
+static osal_retval_t osal_tribuf_open(osal_tribuf_t *tb, const osal_char_t *name, 
+        osal_tribuf_attr_t attr, osal_size_t size) 
+{
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t stride = (size + (LIBOSAL_TRIBUF_CACHE_LINE - 1u)) & ~(osal_uint64_t)(LIBOSAL_TRIBUF_CACHE_LINE - 1u);
+    osal_shm_attr_t shm_attr = OSAL_SHM_ATTR__FLAG__RDWR | (attr & OSAL_TRIBUF_ATTR__MODE__MASK);
+    osal_shm_map_attr_t map_attr = OSAL_SHM_MAP_ATTR__PROT_READ | OSAL_SHM_MAP_ATTR__PROT_WRITE | OSAL_SHM_MAP_ATTR__SHARED;
+    struct osal_tribuf_shm *buf = NULL;
+
+    if ((attr & OSAL_TRIBUF_ATTR__FLAG__CREAT) != 0u) {
+        shm_attr |= OSAL_SHM_ATTR__FLAG__CREAT;
+    }
+    if ((attr & OSAL_TRIBUF_ATTR__FLAG__EXCL) != 0u) {
+        shm_attr |= OSAL_SHM_ATTR__FLAG__EXCL;
+    }
+
+    if (((attr & OSAL_TRIBUF_ATTR__FLAG__CREAT) != 0u) && (size == 0u)) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        ret = osal_shm_open(&tb->shm, name, &shm_attr, sizeof(struct osal_tribuf_shm) + (3u * stride));
+    }
+
+    if (ret == OSAL_OK) {
+        if (tb->shm.size < sizeof(struct osal_tribuf_shm)) {
+            ret = OSAL_ERR_NOT_FOUND;
+        } else {
+            ret = osal_shm_map(&tb->shm, &map_attr, (osal_void_t **)&buf);
+        }
+
+        if (ret != OSAL_OK) {
+            (void)osal_shm_close(&tb->shm);
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        osal_uint32_t magic = 0u;
+        osal_uint32_t polls = 0u;
+
+        if (((attr & OSAL_TRIBUF_ATTR__FLAG__CREAT) != 0u) &&
+                __atomic_compare_exchange_n(&buf->magic, &magic, LIBOSAL_TRIBUF_MAGIC_INIT,
+                    0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            buf->size = size;
+            buf->stride = stride;
+            buf->back = 0u;
+            buf->state = 1u;
+            buf->front = 2u;
+            buf->waiters = 0u;
+
+            magic = LIBOSAL_TRIBUF_MAGIC;
+            __atomic_store_n(&buf->magic, magic, __ATOMIC_RELEASE);
+        }
+
+        // wait for creator to finish initialization
+        magic = __atomic_load_n(&buf->magic, __ATOMIC_ACQUIRE);
+        while ((magic != LIBOSAL_TRIBUF_MAGIC) && (polls++ < LIBOSAL_TRIBUF_INIT_POLLS)) {
+            osal_sleep(LIBOSAL_TRIBUF_INIT_POLL);
+            magic = __atomic_load_n(&buf->magic, __ATOMIC_ACQUIRE);
+        }
+
+        if ((magic != LIBOSAL_TRIBUF_MAGIC) || (buf->size == 0u) ||
+                ((sizeof(struct osal_tribuf_shm) + (3u * buf->stride)) > tb->shm.size)) {
+            (void)munmap(buf, tb->shm.size);
+            (void)osal_shm_close(&tb->shm);
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            tb->buf = buf;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Create or attach a triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ * \param[in]   attr    Pointer to triple buffer attributes. Can be NULL.
+ * \param[in]   size    Size of a sample in bytes. Ignored if already initialized.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_create(osal_tribuf_t *tb, const osal_char_t *name, 
+        const osal_tribuf_attr_t *attr, osal_size_t size) 
+{
+    assert(tb != NULL);
+    assert(name != NULL);
+
+    osal_tribuf_attr_t tmp = (attr != NULL) ? *attr : OSAL_TRIBUF_ATTR__FLAG__CREAT | (0600u << OSAL_TRIBUF_ATTR__MODE__SHIFT);
+
+    return osal_tribuf_open(tb, name, tmp, size);
+}
+
+//! \brief Attach to an existing triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   name    Shared memory name.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_attach(osal_tribuf_t *tb, const osal_char_t *name) {
+    assert(tb != NULL);
+    assert(name != NULL);
+
+    return osal_tribuf_open(tb, name, 0u, 0u);
+}
+
+//! \brief Get sample size of a triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  size    Returns size of a sample in bytes.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_get_size(osal_tribuf_t *tb, osal_size_t *size) {
+    assert(tb != NULL);
+    assert(size != NULL);
+
+    *size = tb->buf->size;
+
+    return OSAL_OK;
+}
+
+//! \brief Get the producers back buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to back buffer.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_get_write_buffer(osal_tribuf_t *tb, osal_void_t **ptr) {
+    assert(tb != NULL);
+    assert(ptr != NULL);
+
+    *ptr = osal_tribuf_data(tb->buf, tb->buf->back);
+
+    return OSAL_OK;
+}
+
+//! \brief Publish the back buffer as latest sample.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_publish(osal_tribuf_t *tb) {
+    assert(tb != NULL);
+
+    struct osal_tribuf_shm *buf = tb->buf;
+
+    // release sample in back buffer, acquire the one the consumer released
+    osal_uint32_t old = __atomic_exchange_n(&buf->state, buf->back | LIBOSAL_TRIBUF_STATE_FRESH, __ATOMIC_SEQ_CST);
+    buf->back = old & LIBOSAL_TRIBUF_STATE_INDEX;
+
+    // pairs with the consumer registering before re-checking the state
+    if (__atomic_load_n(&buf->waiters, __ATOMIC_SEQ_CST) != 0u) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+        osal_futex_wake(&buf->state, INT_MAX, 1);
+#endif
+    }
+
+    return OSAL_OK;
+}
+
+//! \brief Acquire the latest published sample.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[out]  ptr     Returns pointer to front buffer holding the latest sample.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_acquire_latest(osal_tribuf_t *tb, const osal_void_t **ptr) {
+    assert(tb != NULL);
+    assert(ptr != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    struct osal_tribuf_shm *buf = tb->buf;
+
+    if ((__atomic_load_n(&buf->state, __ATOMIC_RELAXED) & LIBOSAL_TRIBUF_STATE_FRESH) == 0u) {
+        ret = OSAL_ERR_NO_DATA;
+    } else {
+        // only the consumer clears the fresh flag, so it is still set
+        osal_uint32_t old = __atomic_exchange_n(&buf->state, buf->front, __ATOMIC_ACQ_REL);
+        buf->front = old & LIBOSAL_TRIBUF_STATE_INDEX;
+    }
+
+    *ptr = osal_tribuf_data(buf, buf->front);
+
+    return ret;
+}
+
+//! \brief Wait for a new sample.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_wait(osal_tribuf_t *tb, const osal_timer_t *to) {
+    assert(tb != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    struct osal_tribuf_shm *buf = tb->buf;
+    osal_uint32_t state = __atomic_load_n(&buf->state, __ATOMIC_ACQUIRE);
+
+    if ((state & LIBOSAL_TRIBUF_STATE_FRESH) == 0u) {
+        (void)__atomic_add_fetch(&buf->waiters, 1u, __ATOMIC_SEQ_CST);
+
+        // re-check after registering, the producer may not have seen us
+        state = __atomic_load_n(&buf->state, __ATOMIC_SEQ_CST);
+        while (((state & LIBOSAL_TRIBUF_STATE_FRESH) == 0u) && (ret == OSAL_OK)) {
+#if LIBOSAL_HAVE_LINUX_FUTEX_H == 1
+            ret = osal_futex_wait(&buf->state, state, 1, to);
+#else
+            osal_sleep(LIBOSAL_TRIBUF_POLL_NSEC);
+
+            if (to != NULL) {
+                osal_timer_t tmp = *to;
+                ret = osal_timer_expired(&tmp);
+            }
+#endif
+            state = __atomic_load_n(&buf->state, __ATOMIC_ACQUIRE);
+        }
+
+        (void)__atomic_sub_fetch(&buf->waiters, 1u, __ATOMIC_RELAXED);
+
+        if ((state & LIBOSAL_TRIBUF_STATE_FRESH) != 0u) {
+            ret = OSAL_OK;
+        }
+    }
+
+    return ret;
+}
+
+//! \brief Detach from a triple buffer.
+/*!
+ * \param[in]   tb      Pointer to osal tribuf structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_tribuf_close(osal_tribuf_t *tb) {
+    assert(tb != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (tb->buf != NULL) {
+        (void)munmap(tb->buf, tb->shm.size);
+        tb->buf = NULL;
+        ret = osal_shm_close(&tb->shm);
+    }
+
+    return ret;
+}
+
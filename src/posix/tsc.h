@@ -0,0 +1,44 @@
+/**
+ * \file posix/tsc.h
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL TSC clock source, internal use only.
+ *
+ * Calibration hook of the LIBOSAL_CLOCK_TSC clock source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LIBOSAL_POSIX_TSC__H
+#define LIBOSAL_POSIX_TSC__H
+
+#include <libosal/types.h>
+
+//! \brief Checks for an invariant TSC and takes the calibration reference.
+/*!
+ * Called once from \ref osal_init. The calibration against 
+ * LIBOSAL_CLOCK_MONOTONIC is finished when LIBOSAL_CLOCK_TSC is selected,
+ * the time between both reference samples is the calibration interval.
+ */
+osal_void_t osal_timer_tsc_init(void);
+
+#endif /* LIBOSAL_POSIX_TSC__H */
@@ -0,0 +1,246 @@
+/**
+ * \file posix/waitset.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL waitset posix source.
+ *
+ * OSAL waitset posix source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#define _GNU_SOURCE             /* ppoll, epoll_pwait2 */
+
+#include <libosal/osal.h>
+#include <libosal/waitset.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+
+#if LIBOSAL_HAVE_SYS_EPOLL_H == 1
+#include <sys/epoll.h>
+#include "eventfd.h"
+
+//! Maximum number of events fetched by one call to \ref osal_waitset_wait.
+#define LIBOSAL_WAITSET_MAX_EVENTS  32
+
+//! \brief Convert relative timeout to epoll_wait timeout.
+/*!
+ * \param[in]   pts     Relative timeout, NULL waits forever.
+ *
+ * \return Timeout in [ms] rounded up, -1 to wait forever.
+ */
+static int osal_waitset_timeout_ms(const struct timespec *pts) {
+    int ms = -1;
+
+    if (pts != NULL) {
+        osal_int64_t left = ((osal_int64_t)pts->tv_sec * NSEC_PER_SEC) + pts->tv_nsec;
+
+        if (left >= ((osal_int64_t)INT32_MAX * 1000000)) {
+            ms = INT32_MAX;
+        } else {
+            ms = (int)((left + 999999) / 1000000);
+        }
+    }
+
+    return ms;
+}
+#endif
+
+//! \brief Initialize a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_init(osal_waitset_t *ws) {
+    assert(ws != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_SYS_EPOLL_H == 1
+    ws->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (ws->epfd < 0) {
+        ret = OSAL_ERR_OPERATION_FAILED;
+    }
+#else
+    ws->epfd = -1;
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Add a pollable file descriptor to a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[in]   fd      Pollable file descriptor of an osal object.
+ * \param[in]   id      User defined id returned if \p fd is ready.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_add(osal_waitset_t *ws, osal_int32_t fd, osal_uint32_t id) {
+    assert(ws != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_SYS_EPOLL_H == 1
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = id;
+
+    if (epoll_ctl(ws->epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        int local_errno = errno;
+        if ((local_errno == EBADF) || (local_errno == EEXIST) || (local_errno == EPERM)) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        } else {
+            ret = OSAL_ERR_OPERATION_FAILED;
+        }
+    }
+#else
+    (void)fd;
+    (void)id;
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Remove a pollable file descriptor from a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[in]   fd      Pollable file descriptor previously added.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_remove(osal_waitset_t *ws, osal_int32_t fd) {
+    assert(ws != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+#if LIBOSAL_HAVE_SYS_EPOLL_H == 1
+    if (epoll_ctl(ws->epfd, EPOLL_CTL_DEL, fd, NULL) != 0) {
+        if (errno == ENOENT) {
+            ret = OSAL_ERR_NOT_FOUND;
+        } else {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+    }
+#else
+    (void)fd;
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Wait for any object of a waitset to become ready.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ * \param[out]  ids     Returns ids of ready objects.
+ * \param[in]   max_ids Maximum number of ids to return.
+ * \param[out]  cnt     Returns number of ready objects stored in \p ids.
+ * \param[in]   to      Absolute timeout on its own clock, NULL waits forever.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_wait(osal_waitset_t *ws, osal_uint32_t *ids, osal_size_t max_ids, 
+        osal_size_t *cnt, const osal_timer_t *to) 
+{
+    assert(ws != NULL);
+    assert(ids != NULL);
+    assert(cnt != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    *cnt = 0;
+
+#if LIBOSAL_HAVE_SYS_EPOLL_H == 1
+    struct epoll_event events[LIBOSAL_WAITSET_MAX_EVENTS];
+    int max_events = (max_ids < LIBOSAL_WAITSET_MAX_EVENTS) ? (int)max_ids : LIBOSAL_WAITSET_MAX_EVENTS;
+
+    // timeout is recalculated from absolute deadline on every call
+    struct timespec ts;
+    const struct timespec *pts = NULL;
+
+    if (max_events <= 0) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else if (osal_poll_timeout(to, &ts, &pts) != OSAL_OK) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+#if LIBOSAL_HAVE_EPOLL_PWAIT2 == 1
+        int local_ret = epoll_pwait2(ws->epfd, events, max_events, pts, NULL);
+        if ((local_ret < 0) && (errno == ENOSYS)) {
+            // kernel before 5.11, timeout is rounded up to [ms]
+            local_ret = epoll_wait(ws->epfd, events, max_events, osal_waitset_timeout_ms(pts));
+        }
+#else
+        int local_ret = epoll_wait(ws->epfd, events, max_events, osal_waitset_timeout_ms(pts));
+#endif
+
+        if (local_ret > 0) {
+            int i;
+            for (i = 0; i < local_ret; ++i) {
+                ids[i] = (osal_uint32_t)events[i].data.u64;
+            }
+
+            *cnt = (osal_size_t)local_ret;
+        } else if (local_ret == 0) {
+            ret = OSAL_ERR_TIMEOUT;
+        } else if (errno == EINTR) {
+            ret = OSAL_ERR_INTERRUPTED;
+        } else {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+    }
+#else
+    (void)ids;
+    (void)max_ids;
+    (void)to;
+    ret = OSAL_ERR_NOT_IMPLEMENTED;
+#endif
+
+    return ret;
+}
+
+//! \brief Destroys a waitset.
+/*!
+ * \param[in]   ws      Pointer to osal waitset structure. Content is OS dependent.
+ *
+ * \return OK or ERROR_CODE.
+ */
+osal_retval_t osal_waitset_destroy(osal_waitset_t *ws) {
+    assert(ws != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (ws->epfd >= 0) {
+        if (close(ws->epfd) != 0) {
+            ret = OSAL_ERR_INVALID_PARAM;
+        }
+
+        ws->epfd = -1;
+    }
+
+    return ret;
+}
+
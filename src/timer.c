@@ -31,13 +31,94 @@
 #include <libosal/osal.h>
 #include <libosal/timer.h>
 
+#include <assert.h>
+
+#ifdef LIBOSAL_BUILD_POSIX
+#include "posix/cpu.h"
+#else
+#define osal_cpu_relax()
+#endif
+
+#define LIBOSAL_SLEEP_PRECISE_MARGIN_INIT   50000u      //!< \brief Initial sleep margin before deadline in [ns].
+#define LIBOSAL_SLEEP_PRECISE_MARGIN_MIN    2000u       //!< \brief Minimum sleep margin in [ns].
+#define LIBOSAL_SLEEP_PRECISE_MARGIN_MAX    1000000u    //!< \brief Maximum sleep margin in [ns].
+#define LIBOSAL_SLEEP_PRECISE_GUARD         2000u       //!< \brief Added to observed wakeup latency in [ns].
+#define LIBOSAL_SLEEP_PRECISE_DECAY_SHIFT   4u          //!< \brief Margin decays by 1/16 of its excess per sleep.
+
+//! Sleep margin of calling task, 0 if not learned yet.
+static __thread osal_uint64_t osal_sleep_precise_margin = 0u;
+
 // Busy-wait until current time equals nsec value
 osal_retval_t osal_busy_wait_until_nsec(osal_uint64_t nsec) {
     osal_uint64_t now;
 
     do {
+        osal_cpu_relax();
         now = osal_timer_gettime_nsec();
     } while (now < nsec);
 
     return OSAL_OK;
 }
+
+// Adapt sleep margin to observed wakeup latency
+static void osal_sleep_precise_learn(osal_uint64_t latency) {
+    osal_uint64_t needed = latency + LIBOSAL_SLEEP_PRECISE_GUARD;
+
+    if (needed > osal_sleep_precise_margin) {
+        osal_sleep_precise_margin = needed;
+    } else {
+        osal_sleep_precise_margin -= (osal_sleep_precise_margin - needed) >> LIBOSAL_SLEEP_PRECISE_DECAY_SHIFT;
+    }
+
+    if (osal_sleep_precise_margin < LIBOSAL_SLEEP_PRECISE_MARGIN_MIN) {
+        osal_sleep_precise_margin = LIBOSAL_SLEEP_PRECISE_MARGIN_MIN;
+    } else if (osal_sleep_precise_margin > LIBOSAL_SLEEP_PRECISE_MARGIN_MAX) {
+        osal_sleep_precise_margin = LIBOSAL_SLEEP_PRECISE_MARGIN_MAX;
+    }
+}
+
+// Sleep until margin before timer, busy-wait for the rest
+osal_retval_t osal_sleep_until_precise(osal_timer_t *timer) {
+    assert(timer != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t deadline = (timer->sec * NSEC_PER_SEC) + timer->nsec;
+    osal_uint64_t now = osal_timer_gettime_nsec();
+
+    if (timer->nsec >= NSEC_PER_SEC) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else if (osal_timer_clock(timer) != osal_timer_get_clock_source()) {
+        // move deadline onto the configured clock source
+        osal_timer_t other;
+        ret = osal_timer_init_clock(&other, osal_timer_clock(timer), 0u);
+
+        if (ret == OSAL_OK) {
+            osal_uint64_t other_now = (other.sec * NSEC_PER_SEC) + other.nsec;
+            deadline = (deadline > other_now) ? (now + (deadline - other_now)) : now;
+        }
+    }
+
+    if (ret == OSAL_OK) {
+        if (osal_sleep_precise_margin == 0u) {
+            osal_sleep_precise_margin = LIBOSAL_SLEEP_PRECISE_MARGIN_INIT;
+        }
+
+        if (deadline > (now + osal_sleep_precise_margin)) {
+            osal_uint64_t target = deadline - osal_sleep_precise_margin;
+
+            ret = osal_sleep_until_nsec(target);
+            now = osal_timer_gettime_nsec();
+
+            if ((ret == OSAL_OK) && (now >= target)) {
+                osal_sleep_precise_learn(now - target);
+            }
+        }
+
+        while ((ret == OSAL_OK) && (now < deadline)) {
+            osal_cpu_relax();
+            now = osal_timer_gettime_nsec();
+        }
+    }
+
+    return ret;
+}
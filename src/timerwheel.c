@@ -0,0 +1,367 @@
+/**
+ * \file timerwheel.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL timer wheel source.
+ *
+ * OSAL hierarchical timer wheel source.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <libosal/config.h>
+#include <libosal/osal.h>
+#include <libosal/timerwheel.h>
+#include <assert.h>
+
+#define LIBOSAL_TIMERWHEEL_MASK     ((osal_uint64_t)OSAL_TIMERWHEEL_SLOTS - 1u)
+#define LIBOSAL_TIMERWHEEL_RANGE    ((osal_uint64_t)1u << (OSAL_TIMERWHEEL_LEVEL_BITS * OSAL_TIMERWHEEL_LEVELS))
+
+//! \brief Initialize an empty list.
+static osal_void_t osal_timerwheel_list_init(osal_timerwheel_node_t *head) {
+    head->next = head;
+    head->prev = head;
+}
+
+//! \brief Append node to list.
+static osal_void_t osal_timerwheel_list_add(osal_timerwheel_node_t *head, osal_timerwheel_node_t *node) {
+    node->next = head;
+    node->prev = head->prev;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+//! \brief Remove node from whatever list it is in.
+static osal_void_t osal_timerwheel_list_del(osal_timerwheel_node_t *node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+//! \brief Append all nodes of \p from to list \p to.
+static osal_void_t osal_timerwheel_list_splice(osal_timerwheel_node_t *from, osal_timerwheel_node_t *to) {
+    if (from->next != from) {
+        from->next->prev = to->prev;
+        to->prev->next = from->next;
+        from->prev->next = to;
+        to->prev = from->prev;
+        osal_timerwheel_list_init(from);
+    }
+}
+
+//! \brief Returns the current tick, the last tick whose time has come.
+static osal_uint64_t osal_timerwheel_now(osal_timerwheel_t *tw) {
+    osal_uint64_t now = osal_timer_gettime_nsec();
+    osal_uint64_t ret = 0u;
+
+    if (now > tw->start_ns) {
+        ret = (now - tw->start_ns) / tw->tick_ns;
+    }
+
+    return ret;
+}
+
+//! \brief Put timer into the slot of its expiry tick.
+/*!
+ * The level is chosen by the distance to the next processed tick, the
+ * slot by the bits of the expiry tick on that level. Expiries beyond the
+ * range of the wheel are put in the last slot reachable and re-inserted
+ * when it comes up.
+ *
+ * Timers due at or before the next processed tick are appended to the
+ * expired list. Its slot may already have been spliced by a process
+ * call running handlers, so it would only come up again a full turn
+ * of the wheel later.
+ *
+ * \param[in]   tw      Pointer to osal timer wheel structure, locked.
+ * \param[in]   tmr     Pointer to unlinked timer.
+ */
+static osal_void_t osal_timerwheel_insert(osal_timerwheel_t *tw, osal_timerwheel_timer_t *tmr) {
+    osal_uint64_t expiry = tmr->expiry;
+    osal_uint64_t delta;
+    osal_uint32_t level = 0u;
+
+    if (expiry <= tw->next_tick) {
+        osal_timerwheel_list_add(&tw->expired, &tmr->node);
+    } else {
+        delta = expiry - tw->next_tick;
+        if (delta >= LIBOSAL_TIMERWHEEL_RANGE) {
+            delta = LIBOSAL_TIMERWHEEL_RANGE - 1u;
+            expiry = tw->next_tick + delta;
+        }
+
+        while (delta >= ((osal_uint64_t)1u << (OSAL_TIMERWHEEL_LEVEL_BITS * (level + 1u)))) {
+            level++;
+        }
+
+        osal_timerwheel_list_add(&tw->slots[level][(expiry >> (OSAL_TIMERWHEEL_LEVEL_BITS * level)) & LIBOSAL_TIMERWHEEL_MASK],
+                &tmr->node);
+    }
+}
+
+//! \brief Move the timers of a slot one level down.
+/*!
+ * \param[in]   tw      Pointer to osal timer wheel structure, locked.
+ * \param[in]   level   Level to cascade from, greater than 0.
+ *
+ * \return Slot index which was cascaded.
+ */
+static osal_uint64_t osal_timerwheel_cascade(osal_timerwheel_t *tw, osal_uint32_t level) {
+    osal_uint64_t idx = (tw->next_tick >> (OSAL_TIMERWHEEL_LEVEL_BITS * level)) & LIBOSAL_TIMERWHEEL_MASK;
+    osal_timerwheel_node_t list;
+
+    osal_timerwheel_list_init(&list);
+    osal_timerwheel_list_splice(&tw->slots[level][idx], &list);
+
+    while (list.next != &list) {
+        osal_timerwheel_node_t *node = list.next;
+        osal_timerwheel_list_del(node);
+        osal_timerwheel_insert(tw, (osal_timerwheel_timer_t *)node);
+    }
+
+    return idx;
+}
+
+// Initialize a timer wheel.
+osal_retval_t osal_timerwheel_init(osal_timerwheel_t *tw, osal_uint64_t tick_ns) {
+    assert(tw != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint32_t level;
+    osal_uint32_t slot;
+
+    if (tick_ns == 0u) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        ret = osal_mutex_init(&tw->mtx, NULL);
+    }
+
+    if (ret == OSAL_OK) {
+        tw->tick_ns = tick_ns;
+        tw->start_ns = osal_timer_gettime_nsec();
+        tw->next_tick = 0u;
+        tw->armed = 0u;
+        tw->running = 0;
+        osal_timerwheel_list_init(&tw->expired);
+
+        for (level = 0u; level < OSAL_TIMERWHEEL_LEVELS; ++level) {
+            for (slot = 0u; slot < OSAL_TIMERWHEEL_SLOTS; ++slot) {
+                osal_timerwheel_list_init(&tw->slots[level][slot]);
+            }
+        }
+    }
+
+    return ret;
+}
+
+// Destroy a timer wheel.
+osal_retval_t osal_timerwheel_destroy(osal_timerwheel_t *tw) {
+    assert(tw != NULL);
+
+    if (tw->running != 0) {
+        (void)osal_timerwheel_stop(tw);
+    }
+
+    return osal_mutex_destroy(&tw->mtx);
+}
+
+//! \brief Dedicated timer wheel task.
+static osal_void_t *osal_timerwheel_task(osal_void_t *arg) {
+    osal_timerwheel_t *tw = (osal_timerwheel_t *)arg;
+
+    while (__atomic_load_n(&tw->running, __ATOMIC_ACQUIRE) != 0) {
+        osal_uint64_t next_tick = __atomic_load_n(&tw->next_tick, __ATOMIC_RELAXED);
+
+        (void)osal_sleep_until_nsec(tw->start_ns + (next_tick * tw->tick_ns));
+        (void)osal_timerwheel_process(tw);
+    }
+
+    return NULL;
+}
+
+// Start a dedicated task driving the timer wheel.
+osal_retval_t osal_timerwheel_start(osal_timerwheel_t *tw, const osal_task_attr_t *attr) {
+    assert(tw != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (tw->running != 0) {
+        ret = OSAL_ERR_BUSY;
+    } else {
+        __atomic_store_n(&tw->running, 1, __ATOMIC_RELEASE);
+
+        ret = osal_task_create(&tw->task, attr, osal_timerwheel_task, tw);
+        if (ret != OSAL_OK) {
+            tw->running = 0;
+        }
+    }
+
+    return ret;
+}
+
+// Stop the dedicated task.
+osal_retval_t osal_timerwheel_stop(osal_timerwheel_t *tw) {
+    assert(tw != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+
+    if (tw->running == 0) {
+        ret = OSAL_ERR_NOT_FOUND;
+    } else {
+        __atomic_store_n(&tw->running, 0, __ATOMIC_RELEASE);
+        ret = osal_task_join(&tw->task, NULL);
+    }
+
+    return ret;
+}
+
+// Process all ticks up to the current time.
+osal_retval_t osal_timerwheel_process(osal_timerwheel_t *tw) {
+    assert(tw != NULL);
+
+    osal_retval_t ret = OSAL_OK;
+    osal_uint64_t now = osal_timerwheel_now(tw);
+
+    ret = osal_mutex_lock(&tw->mtx);
+
+    while ((ret == OSAL_OK) && (tw->next_tick <= now)) {
+        osal_uint64_t idx = tw->next_tick & LIBOSAL_TIMERWHEEL_MASK;
+        osal_uint32_t level = 1u;
+
+        if (tw->armed == 0u) {
+            // nothing to expire, skip idle ticks at once
+            __atomic_store_n(&tw->next_tick, now + 1u, __ATOMIC_RELAXED);
+            break;
+        }
+
+        if (idx == 0u) {
+            while ((level < OSAL_TIMERWHEEL_LEVELS) && (osal_timerwheel_cascade(tw, level) == 0u)) {
+                level++;
+            }
+        }
+
+        osal_timerwheel_list_splice(&tw->slots[0][idx], &tw->expired);
+
+        while (tw->expired.next != &tw->expired) {
+            osal_timerwheel_timer_t *tmr = (osal_timerwheel_timer_t *)tw->expired.next;
+            osal_timerwheel_handler_t handler = tmr->handler;
+            osal_void_t *arg = tmr->arg;
+
+            osal_timerwheel_list_del(&tmr->node);
+
+            // re-arm before calling, so the handler may cancel it
+            if (tmr->period != 0u) {
+                tmr->expiry += tmr->period;
+                if (tmr->expiry <= tw->next_tick) {
+                    tmr->expiry += (((tw->next_tick - tmr->expiry) / tmr->period) + 1u) * tmr->period;
+                }
+
+                osal_timerwheel_insert(tw, tmr);
+            } else {
+                tw->armed--;
+            }
+
+            (void)osal_mutex_unlock(&tw->mtx);
+            handler(arg);
+            (void)osal_mutex_lock(&tw->mtx);
+        }
+
+        __atomic_store_n(&tw->next_tick, tw->next_tick + 1u, __ATOMIC_RELAXED);
+    }
+
+    if (ret == OSAL_OK) {
+        ret = osal_mutex_unlock(&tw->mtx);
+    }
+
+    return ret;
+}
+
+// Initialize a timer.
+osal_retval_t osal_timerwheel_timer_init(osal_timerwheel_timer_t *tmr,
+        osal_timerwheel_handler_t handler, osal_void_t *arg)
+{
+    assert(tmr != NULL);
+    assert(handler != NULL);
+
+    tmr->node.next = NULL;
+    tmr->node.prev = NULL;
+    tmr->expiry = 0u;
+    tmr->period = 0u;
+    tmr->handler = handler;
+    tmr->arg = arg;
+
+    return OSAL_OK;
+}
+
+// Arm a timer.
+osal_retval_t osal_timerwheel_arm(osal_timerwheel_t *tw, osal_timerwheel_timer_t *tmr,
+        osal_uint64_t delay_ns, osal_uint64_t period_ns)
+{
+    assert(tw != NULL);
+    assert(tmr != NULL);
+
+    osal_retval_t ret = osal_mutex_lock(&tw->mtx);
+
+    if (ret == OSAL_OK) {
+        // sampled under the lock, so it is not older than the tick being processed
+        osal_uint64_t now = osal_timer_gettime_nsec();
+        osal_uint64_t elapsed = (now > tw->start_ns) ? (now - tw->start_ns) : 0u;
+
+        if (tmr->node.next != NULL) {
+            osal_timerwheel_list_del(&tmr->node);
+        } else {
+            tw->armed++;
+        }
+
+        // first tick starting at or after now + delay, never early
+        tmr->expiry = (elapsed + delay_ns + tw->tick_ns - 1u) / tw->tick_ns;
+        tmr->period = (period_ns + tw->tick_ns - 1u) / tw->tick_ns;
+        osal_timerwheel_insert(tw, tmr);
+
+        ret = osal_mutex_unlock(&tw->mtx);
+    }
+
+    return ret;
+}
+
+// Cancel a timer.
+osal_retval_t osal_timerwheel_cancel(osal_timerwheel_t *tw, osal_timerwheel_timer_t *tmr) {
+    assert(tw != NULL);
+    assert(tmr != NULL);
+
+    osal_retval_t ret = osal_mutex_lock(&tw->mtx);
+
+    if (ret == OSAL_OK) {
+        if (tmr->node.next != NULL) {
+            osal_timerwheel_list_del(&tmr->node);
+            tw->armed--;
+        } else {
+            ret = OSAL_ERR_NOT_FOUND;
+        }
+
+        (void)osal_mutex_unlock(&tw->mtx);
+    }
+
+    return ret;
+}
+
@@ -33,28 +33,155 @@
 #include <stdarg.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define LOGGER_MAX_BATCH    256     //!< Maximum messages written with one writev call.
+#define LOGGER_MAX_PREFIX   96      //!< Maximum length of message prefix.
+
+//! \brief Format message prefix with timestamp, level, task id and tag.
+static size_t logger_prefix(char *buf, const osal_io_shm_msg_t *msg) {
+    static const char levels[] = "?EWID";
+    char level = msg->level < (sizeof(levels) - 1u) ? levels[msg->level] : '?';
+    int len;
+
+    if (msg->tag != NULL) {
+        len = snprintf(buf, LOGGER_MAX_PREFIX, "%" PRIu64 ".%09" PRIu64 " %c %u [%s] ", 
+                msg->timestamp / 1000000000u, msg->timestamp % 1000000000u, level, msg->tid, msg->tag);
+    } else {
+        len = snprintf(buf, LOGGER_MAX_PREFIX, "%" PRIu64 ".%09" PRIu64 " %c %u ", 
+                msg->timestamp / 1000000000u, msg->timestamp % 1000000000u, level, msg->tid);
+    }
+
+    return len < 0 ? 0u : len >= LOGGER_MAX_PREFIX ? LOGGER_MAX_PREFIX - 1u : (size_t)len;
+}
+
+//! \brief Write all iovecs, handles partial writes.
+static int logger_writev(int fd, struct iovec *iov, int iovcnt) {
+    int ret = 0;
+
+    while ((iovcnt > 0) && (ret == 0)) {
+        ssize_t written = writev(fd, iov, iovcnt);
+
+        if (written < 0) {
+            if (errno != EINTR) {
+                ret = -1;
+            }
+        } else {
+            while ((iovcnt > 0) && ((size_t)written >= iov->iov_len)) {
+                written -= iov->iov_len;
+                iov++;
+                iovcnt--;
+            }
+
+            if (iovcnt > 0) {
+                iov->iov_base = (char *)iov->iov_base + written;
+                iov->iov_len -= written;
+            }
+        }
+    }
+
+    return ret;
+}
     
 extern int main(int argc, char **argv) {
-    if (argc < 2) {
-        printf("usage: %s <shm_name>\n", argv[0]);
+    unsigned long task_rings = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:")) != -1) {
+        if (opt == 'r') {
+            char *end = NULL;
+            task_rings = strtoul(optarg, &end, 0);
+            if ((*optarg == '\0') || (*end != '\0') || (task_rings > LIBOSAL_IO_SHM_MAX_TASK_RINGS)) {
+                fprintf(stderr, "invalid number of task rings: %s\n", optarg);
+                return 1;
+            }
+        } else {
+            optind = argc + 1;
+        }
+    }
+
+    if (optind >= argc) {
+        printf("usage: %s [-r <task_rings>] <shm_name> [<output_file>]\n", argv[0]);
         return 0;
     }
 
+    int fd = STDOUT_FILENO;
+
+    if ((argc - optind) > 1) {
+        fd = open(argv[optind + 1], O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            perror("opening output file failed");
+            return 1;
+        }
+    }
+
     printf("SHM logger\n");
-    //printf("max messages: %d\n", LIBOSAL_IO_SHM_MAX_MSGS);
-    //printf("max message size: %d\n", LIBOSAL_IO_SHM_MAX_MSG_SIZE);
+    fflush(stdout);
 
-    osal_io_shm_setup(argv[1], 1000, 512);
+    // writers started later find the task rings created here
+    osal_io_shm_attr_t attr = (osal_io_shm_attr_t)task_rings << OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT;
+    if (osal_io_shm_setup_attr(argv[optind], 1000, 512, &attr) != OSAL_OK) {
+        fprintf(stderr, "setting up shm %s failed\n", argv[optind]);
+        return 1;
+    }
 
-    osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+    static char newline[] = "\n";
+    osal_io_shm_msg_t msgs[LOGGER_MAX_BATCH];
+    static char prefix[LOGGER_MAX_BATCH][LOGGER_MAX_PREFIX];
+    struct iovec iov[3 * LOGGER_MAX_BATCH];
+    osal_uint64_t dropped = 0u;
 
     while (1) {
         osal_timer_t to;
-        (void)osal_timer_init(&to, 10000000);
-        osal_retval_t ret = osal_io_shm_get_message(msg, &to);
+        osal_size_t cnt = 0;
+
+        (void)osal_timer_init(&to, 1000000000);
+        osal_retval_t ret = osal_io_shm_acquire_messages(msgs, LOGGER_MAX_BATCH, &cnt, &to);
         if (ret == OSAL_OK) {
-            printf("%s\n", msg);
+            int iovcnt = 0;
+
+            for (osal_size_t i = 0; i < cnt; ++i) {
+                iov[iovcnt].iov_base = prefix[i];
+                iov[iovcnt].iov_len = logger_prefix(prefix[i], &msgs[i]);
+                iovcnt++;
+
+                iov[iovcnt].iov_base = (void *)msgs[i].msg;
+                iov[iovcnt].iov_len = msgs[i].len;
+                iovcnt++;
+
+                // terminate messages without trailing newline
+                if ((msgs[i].len == 0u) || (msgs[i].msg[msgs[i].len - 1u] != '\n')) {
+                    iov[iovcnt].iov_base = newline;
+                    iov[iovcnt].iov_len = 1;
+                    iovcnt++;
+                }
+            }
+
+            int wret = logger_writev(fd, iov, iovcnt);
+            (void)osal_io_shm_commit_messages();
+
+            if (wret != 0) {
+                perror("writing messages failed");
+                break;
+            }
         }
+
+        // report lost messages
+        osal_io_shm_stats_t stats;
+        if ((osal_io_shm_get_stats(&stats) == OSAL_OK) && (stats.dropped != dropped)) {
+            fprintf(stderr, "SHM logger: %" PRIu64 " messages dropped, high water mark %" PRIu64 "/%" PRIu64 " bytes\n",
+                    stats.dropped - dropped, stats.high_water_mark, stats.size);
+            dropped = stats.dropped;
+        }
+    }
+
+    if (fd != STDOUT_FILENO) {
+        close(fd);
     }
 
     return 0;
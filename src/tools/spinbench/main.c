@@ -0,0 +1,174 @@
+/**
+ * \file main.c
+ *
+ * \author Robert Burger <robert.burger@dlr.de>
+ *
+ * \date 16 Oct 2026
+ *
+ * \brief OSAL spinlock benchmark.
+ *
+ * Compares throughput and fairness of the spinlock types under contention.
+ */
+
+/*
+ * This file is part of libosal.
+ *
+ * libosal is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ * 
+ * libosal is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libosal; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+#include <libosal/osal.h>
+#include <libosal/io.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SPINBENCH_MAX_TASKS     64u
+
+//! \brief Spinlock type under test.
+typedef struct spinbench_type {
+    const osal_char_t *name;
+    osal_spinlock_attr_t attr;
+} spinbench_type_t;
+
+static const spinbench_type_t spinbench_types[] = {
+    { "default", OSAL_SPINLOCK_ATTR__TYPE__NORMAL },
+    { "owner",   OSAL_SPINLOCK_ATTR__PROCESS_SHARED },
+    { "ticket",  OSAL_SPINLOCK_ATTR__TYPE__TICKET },
+    { "mcs",     OSAL_SPINLOCK_ATTR__TYPE__MCS },
+};
+
+//! \brief State shared by all benchmark tasks.
+typedef struct spinbench_shared {
+    osal_spinlock_t lock;
+    osal_uint32_t start;
+    osal_uint32_t stop;
+    osal_uint32_t hold;
+    volatile osal_uint64_t counter;
+} spinbench_shared_t;
+
+//! \brief Per task state.
+typedef struct spinbench_task {
+    spinbench_shared_t *shared;
+    osal_uint64_t acquired;
+    osal_uint64_t errors;
+} spinbench_task_t;
+
+//! \brief Lock, hold for some iterations and unlock until stopped.
+static osal_void_t *spinbench_handler(osal_void_t *arg) {
+    spinbench_task_t *task = (spinbench_task_t *)arg;
+    spinbench_shared_t *shared = task->shared;
+
+    while (__atomic_load_n(&shared->start, __ATOMIC_ACQUIRE) == 0u) {}
+
+    while (__atomic_load_n(&shared->stop, __ATOMIC_RELAXED) == 0u) {
+        if (osal_spinlock_lock(&shared->lock) != OSAL_OK) {
+            task->errors++;
+            continue;
+        }
+
+        for (osal_uint32_t i = 0u; i < shared->hold; ++i) {
+            shared->counter++;
+        }
+
+        (void)osal_spinlock_unlock(&shared->lock);
+        task->acquired++;
+    }
+
+    return NULL;
+}
+
+//! \brief Run one spinlock type.
+static osal_void_t spinbench_run(const spinbench_type_t *type, osal_uint32_t n_tasks, 
+        osal_uint64_t duration_ns, osal_uint32_t hold) 
+{
+    static spinbench_shared_t shared;
+    static spinbench_task_t tasks[SPINBENCH_MAX_TASKS];
+    static osal_task_t hdls[SPINBENCH_MAX_TASKS];
+    osal_uint64_t total = 0u;
+    osal_uint64_t min = UINT64_MAX;
+    osal_uint64_t max = 0u;
+    osal_uint64_t errors = 0u;
+    osal_uint64_t start_ns;
+    osal_uint64_t elapsed_ns;
+
+    (void)memset(&shared, 0, sizeof(shared));
+    shared.hold = hold;
+
+    if (osal_spinlock_init(&shared.lock, &type->attr) != OSAL_OK) {
+        osal_printf("%-8s init failed\n", type->name);
+        return;
+    }
+
+    for (osal_uint32_t i = 0u; i < n_tasks; ++i) {
+        tasks[i].shared = &shared;
+        tasks[i].acquired = 0u;
+        tasks[i].errors = 0u;
+        (void)osal_task_create(&hdls[i], NULL, spinbench_handler, &tasks[i]);
+    }
+
+    start_ns = osal_timer_gettime_nsec();
+    __atomic_store_n(&shared.start, 1u, __ATOMIC_RELEASE);
+    osal_sleep(duration_ns);
+    __atomic_store_n(&shared.stop, 1u, __ATOMIC_RELAXED);
+
+    for (osal_uint32_t i = 0u; i < n_tasks; ++i) {
+        (void)osal_task_join(&hdls[i], NULL);
+        (void)osal_task_destroy(&hdls[i]);
+
+        total += tasks[i].acquired;
+        errors += tasks[i].errors;
+        if (tasks[i].acquired < min) { min = tasks[i].acquired; }
+        if (tasks[i].acquired > max) { max = tasks[i].acquired; }
+    }
+    elapsed_ns = osal_timer_gettime_nsec() - start_ns;
+
+    (void)osal_spinlock_destroy(&shared.lock);
+
+    osal_printf("%-8s %12lu %10.1f %12lu %12lu %8.3f %lu\n", type->name, 
+            (unsigned long)total, (total != 0u) ? ((double)elapsed_ns / (double)total) : 0.,
+            (unsigned long)min, (unsigned long)max, 
+            (max != 0u) ? ((double)min / (double)max) : 0., (unsigned long)errors);
+}
+
+extern int main(int argc, char **argv) {
+    osal_uint32_t n_tasks = 4u;
+    osal_uint64_t duration_ms = 1000u;
+    osal_uint32_t hold = 10u;
+
+    if ((argc > 1) && ((strcmp(argv[1], "-h") == 0) || (strcmp(argv[1], "--help") == 0))) {
+        osal_printf("usage: %s [tasks] [duration_ms] [hold_iterations]\n", argv[0]);
+        return 0;
+    }
+
+    if (argc > 1) { n_tasks = (osal_uint32_t)strtoul(argv[1], NULL, 0); }
+    if (argc > 2) { duration_ms = strtoull(argv[2], NULL, 0); }
+    if (argc > 3) { hold = (osal_uint32_t)strtoul(argv[3], NULL, 0); }
+
+    if ((n_tasks == 0u) || (n_tasks > SPINBENCH_MAX_TASKS)) {
+        osal_printf("number of tasks has to be between 1 and %u\n", SPINBENCH_MAX_TASKS);
+        return 1;
+    }
+
+    osal_init();
+
+    osal_printf("%u tasks, %lu ms, %u hold iterations\n", n_tasks, (unsigned long)duration_ms, hold);
+    osal_printf("%-8s %12s %10s %12s %12s %8s %s\n", "type", "acquired", "ns/lock", 
+            "min/task", "max/task", "fair", "errors");
+
+    for (osal_uint32_t i = 0u; i < (sizeof(spinbench_types) / sizeof(spinbench_types[0])); ++i) {
+        spinbench_run(&spinbench_types[i], n_tasks, duration_ms * 1000000u, hold);
+    }
+
+    return 0;
+}
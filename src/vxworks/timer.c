@@ -76,6 +76,7 @@ int osal_timer_gettime(osal_timer_t *timer) {
     } else {
         timer->sec = ts.tv_sec;
         timer->nsec = ts.tv_nsec;
+        osal_timer_set_clock(timer, global_clock_id);
     }
 
     return ret;
@@ -84,7 +85,7 @@ int osal_timer_gettime(osal_timer_t *timer) {
 // gets time in nanoseconds
 osal_int64_t osal_timer_gettime_nsec(void) {
     osal_int64_t ret = 0;
-    osal_timer_t tmr = { 0, 0 };
+    osal_timer_t tmr = { 0, 0, 0 };
     int local_ret = osal_timer_gettime(&tmr);
 
     if (local_ret == OSAL_OK) {
@@ -98,27 +99,41 @@ osal_int64_t osal_timer_gettime_nsec(void) {
 void osal_timer_init(osal_timer_t *timer, osal_int64_t timeout) {
     assert(timer != NULL);
 
-    struct timespec ts;
-    if (clock_gettime(global_clock_id, &ts) == -1) {
+    if (osal_timer_init_clock(timer, global_clock_id, timeout) != OSAL_OK) {
         perror("clock_gettime");
     }
+}
 
-    osal_timer_t a;
-    osal_timer_t b;
-    a.sec = ts.tv_sec;
-    a.nsec = ts.tv_nsec;
+// initialize timer on given clock with timeout
+osal_retval_t osal_timer_init_clock(osal_timer_t *timer, int clock_id, osal_uint64_t timeout) {
+    assert(timer != NULL);
 
-    b.sec = (timeout / NSEC_PER_SEC);
-    b.nsec = (timeout % NSEC_PER_SEC);
+    osal_retval_t ret = OSAL_OK;
+    struct timespec ts;
 
-    osal_timer_add(&a, &b, timer);
+    if (clock_gettime(clock_id, &ts) == -1) {
+        ret = OSAL_ERR_INVALID_PARAM;
+    } else {
+        osal_timer_t a;
+        osal_timer_t b;
+        a.sec = ts.tv_sec;
+        a.nsec = ts.tv_nsec;
+        osal_timer_set_clock(&a, clock_id);
+
+        b.sec = (timeout / NSEC_PER_SEC);
+        b.nsec = (timeout % NSEC_PER_SEC);
+
+        osal_timer_add(&a, &b, timer);
+    }
+
+    return ret;
 }
 
 // checks if timer is expired
 int osal_timer_expired(osal_timer_t *timer) {
     assert(timer != NULL);
 
-    osal_timer_t act = { 0, 0 };
+    osal_timer_t act = { 0, 0, 0 };
     int ret = OSAL_OK;
     ret = osal_timer_gettime(&act);    
 
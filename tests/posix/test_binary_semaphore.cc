@@ -9,7 +9,9 @@
 #include <sched.h>
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <sys/wait.h>
 #include <time.h>
+#include <unistd.h>
 #include <vector>
 
 namespace test_semaphore {
@@ -1258,6 +1260,61 @@ TEST(BinarySemaphoreFunction, TryCount) {
 }
 } // namespace trywait
 
+namespace process_shared {
+
+/* two processes hand a token back and forth through a pair of
+   process shared binary semaphores in shared memory. */
+
+const int LOOPCOUNT = 10000;
+
+typedef struct {
+  osal_binary_semaphore_t ping;
+  osal_binary_semaphore_t pong;
+  int counter;
+} shared_params;
+
+TEST(BinarySemaphoreFunction, ProcessShared) {
+  shared_params *params = (shared_params *)mmap(
+      NULL, sizeof(shared_params), PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(params, MAP_FAILED) << "mmap() failed";
+
+  osal_binary_semaphore_attr_t attr = OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED;
+  ASSERT_EQ(osal_binary_semaphore_init(&params->ping, &attr), OSAL_OK);
+  ASSERT_EQ(osal_binary_semaphore_init(&params->pong, &attr), OSAL_OK);
+  params->counter = 0;
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+
+  if (pid == 0) {
+    for (int i = 0; i < LOOPCOUNT; i++) {
+      osal_binary_semaphore_wait(&params->ping);
+      params->counter++;
+      osal_binary_semaphore_post(&params->pong);
+    }
+    _exit(0);
+  }
+
+  for (int i = 0; i < LOOPCOUNT; i++) {
+    EXPECT_EQ(osal_binary_semaphore_post(&params->ping), OSAL_OK);
+    osal_timer_t deadline = testutils::set_deadline(5, 0);
+    ASSERT_EQ(osal_binary_semaphore_timedwait(&params->pong, &deadline), OSAL_OK)
+        << "no answer from child process";
+    EXPECT_EQ(params->counter, i + 1);
+  }
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  EXPECT_EQ(status, 0) << "child process failed";
+
+  EXPECT_EQ(osal_binary_semaphore_trywait(&params->pong), OSAL_ERR_BUSY);
+  EXPECT_EQ(osal_binary_semaphore_destroy(&params->ping), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_destroy(&params->pong), OSAL_OK);
+  munmap(params, sizeof(shared_params));
+}
+} // namespace process_shared
+
 } // namespace test_semaphore
 
 int main(int argc, char **argv) {
@@ -580,7 +580,7 @@ void *test_condvar_wait(void *arg) {
 
   osal_retval_t orv;
   int rv;
-  osal_timer_t max_wait_time;
+  osal_timer_t max_wait_time = OSAL_TIMER_INITIALIZER_CLOCK(CLOCK_MONOTONIC);
   timespec now;
   clock_gettime(CLOCK_MONOTONIC, &now);
   now.tv_nsec += MAX_WAIT_TIME_NSEC;
@@ -799,6 +799,81 @@ TEST(CondvarFunction, ParallelWait) {
 }
 } // namespace condvar_timedwait
 
+/* timeouts on either clock expire after the requested time, no
+   matter on which clock the condvar waits. */
+
+static uint64_t monotonic_nsec() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+TEST(CondvarFunction, TimedWaitClocks) {
+  const osal_uint64_t TIMEOUT_NS = 20000000;
+  const osal_condvar_attr_t cv_attrs[] = {
+      0, OSAL_CONDVAR_ATTR__CLOCK_REALTIME};
+  const int clocks[] = {LIBOSAL_CLOCK_MONOTONIC, LIBOSAL_CLOCK_REALTIME};
+
+  osal_mutex_t mtx;
+  ASSERT_EQ(osal_mutex_init(&mtx, nullptr), OSAL_OK);
+
+  for (osal_condvar_attr_t cv_attr : cv_attrs) {
+    osal_condvar_t cv;
+    ASSERT_EQ(osal_condvar_init(&cv, &cv_attr), OSAL_OK);
+
+    for (int clock_id : clocks) {
+      osal_timer_t to;
+      ASSERT_EQ(osal_timer_init_clock(&to, clock_id, TIMEOUT_NS), OSAL_OK);
+      EXPECT_EQ(osal_timer_clock(&to), clock_id);
+
+      uint64_t start = monotonic_nsec();
+      ASSERT_EQ(osal_mutex_lock(&mtx), OSAL_OK);
+      EXPECT_EQ(osal_condvar_timedwait(&cv, &mtx, &to), OSAL_ERR_TIMEOUT);
+      ASSERT_EQ(osal_mutex_unlock(&mtx), OSAL_OK);
+      uint64_t elapsed = monotonic_nsec() - start;
+
+      // a converted timeout may lose the time spent converting it
+      EXPECT_GE(elapsed + 100000, TIMEOUT_NS)
+          << "condvar attr " << cv_attr << ", clock " << clock_id;
+      EXPECT_LT(elapsed, 50 * TIMEOUT_NS)
+          << "condvar attr " << cv_attr << ", clock " << clock_id;
+    }
+
+    EXPECT_EQ(osal_condvar_destroy(&cv), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_mutex_destroy(&mtx), OSAL_OK);
+}
+
+/* a timeout on an invalid clock is reported instead of silently
+   expiring at once. */
+
+TEST(CondvarFunction, TimedWaitInvalidClock) {
+  const osal_condvar_attr_t cv_attrs[] = {
+      0, OSAL_CONDVAR_ATTR__CLOCK_REALTIME};
+
+  osal_mutex_t mtx;
+  ASSERT_EQ(osal_mutex_init(&mtx, nullptr), OSAL_OK);
+
+  for (osal_condvar_attr_t cv_attr : cv_attrs) {
+    osal_condvar_t cv;
+    ASSERT_EQ(osal_condvar_init(&cv, &cv_attr), OSAL_OK);
+
+    osal_timer_t to;
+    osal_timer_init(&to, 20000000);
+    osal_timer_set_clock(&to, 1000);
+
+    ASSERT_EQ(osal_mutex_lock(&mtx), OSAL_OK);
+    EXPECT_EQ(osal_condvar_timedwait(&cv, &mtx, &to), OSAL_ERR_INVALID_PARAM)
+        << "condvar attr " << cv_attr;
+    ASSERT_EQ(osal_mutex_unlock(&mtx), OSAL_OK);
+
+    EXPECT_EQ(osal_condvar_destroy(&cv), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_mutex_destroy(&mtx), OSAL_OK);
+}
+
 } // namespace test_condvar
 
 int main(int argc, char **argv) {
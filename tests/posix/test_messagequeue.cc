@@ -673,6 +673,61 @@ TEST(MessageQueueFunction, ReadonlyWriteonly) {
 }
 } // namespace readonly_writeonly
 
+/* batches on a POSIX message queue: the receiver only waits for the
+   first message and gets what is queued at that time. */
+
+TEST(MessageQueueFunction, Batch) {
+  osal_mq_t mq;
+  char bufs[8][32];
+  char rbufs[8][32];
+  osal_mq_msg_t msgs[8];
+  osal_mq_msg_t rmsgs[8];
+  osal_size_t cnt = 0;
+
+  osal_mq_attr_t attr = {};
+  attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT;
+  attr.max_messages = 10;
+  attr.max_message_size = 32;
+  attr.mode = S_IRUSR | S_IWUSR;
+  mq_unlink("/test_batch");
+
+  osal_retval_t orv = osal_mq_open(&mq, "/test_batch", &attr);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (int i = 0; i < 8; i++) {
+    msgs[i].msg = bufs[i];
+    msgs[i].len = snprintf(bufs[i], sizeof(bufs[i]), "msg %d", i) + 1;
+    msgs[i].prio = 0;
+    rmsgs[i].msg = rbufs[i];
+    rmsgs[i].len = sizeof(rbufs[i]);
+  }
+
+  orv = osal_mq_send_batch(&mq, msgs, 5, &cnt, nullptr);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send_batch() failed";
+  EXPECT_EQ(cnt, 5u);
+
+  osal_timer_t deadline = set_deadline(1, 0);
+  orv = osal_mq_receive_batch(&mq, rmsgs, 8, &cnt, &deadline);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_receive_batch() failed";
+  ASSERT_EQ(cnt, 5u);
+  for (int i = 0; i < 5; i++) {
+    EXPECT_STREQ(rmsgs[i].msg, bufs[i]);
+    EXPECT_EQ(rmsgs[i].len, msgs[i].len);
+  }
+
+  for (int i = 0; i < 8; i++) {
+    rmsgs[i].len = sizeof(rbufs[i]);
+  }
+  deadline = set_deadline(0, 50000000);
+  orv = osal_mq_receive_batch(&mq, rmsgs, 8, &cnt, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(cnt, 0u);
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  mq_unlink("/test_batch");
+}
+
 namespace test_invalidparams {
 TEST(MessageQueueDetect, InvalidParamsAccess) {
 
@@ -0,0 +1,542 @@
+#include "libosal/mq.h"
+#include "libosal/osal.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+
+namespace test_messagequeue_shmring {
+
+using testutils::set_deadline;
+
+/*
+  Tests of the message queue backend which uses a lock-free ring
+  in shared memory, selected by OSAL_MQ_ATTR__OFLAG__SHM_RING.
+*/
+
+struct message_t {
+  uint32_t producer;
+  uint32_t seq;
+};
+
+static osal_retval_t open_ring(osal_mq_t *mq, const char *name,
+                               osal_size_t max_messages) {
+  osal_mq_attr_t attr = {};
+  attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT |
+                OSAL_MQ_ATTR__OFLAG__SHM_RING;
+  attr.mode = S_IRUSR | S_IWUSR;
+  attr.max_messages = max_messages;
+  attr.max_message_size = sizeof(message_t);
+
+  return osal_mq_open(mq, name, &attr);
+}
+
+/* messages are received in the order they were sent, full and
+   empty rings time out. */
+
+TEST(MessageQueueShmRing, SendReceive) {
+  osal_mq_t mq;
+  message_t msg = {};
+  osal_uint32_t prio = 0;
+
+  shm_unlink("/test_mq_ring");
+  osal_retval_t orv = open_ring(&mq, "/test_mq_ring", 4);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (uint32_t i = 0; i < 4; i++) {
+    msg.seq = i;
+    orv = osal_mq_send(&mq, (char *)&msg, sizeof(msg), i);
+    EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send() failed";
+  }
+
+  osal_timer_t deadline = set_deadline(0, 50000000);
+  orv = osal_mq_timedsend(&mq, (char *)&msg, sizeof(msg), 0, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "send to full ring did not time out";
+
+  for (uint32_t i = 0; i < 4; i++) {
+    orv = osal_mq_receive(&mq, (char *)&msg, sizeof(msg), &prio);
+    EXPECT_EQ(orv, OSAL_OK) << "osal_mq_receive() failed";
+    EXPECT_EQ(msg.seq, i);
+    EXPECT_EQ(prio, i);
+  }
+
+  deadline = set_deadline(0, 50000000);
+  orv = osal_mq_timedreceive(&mq, (char *)&msg, sizeof(msg), &prio, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "receive from empty ring did not time out";
+
+  // messages larger than the slots and too small buffers are rejected
+  char big[2 * sizeof(message_t)] = {};
+  orv = osal_mq_send(&mq, big, sizeof(big), 0);
+  EXPECT_EQ(orv, OSAL_ERR_INVALID_PARAM);
+  orv = osal_mq_receive(&mq, big, sizeof(message_t) - 1, &prio);
+  EXPECT_EQ(orv, OSAL_ERR_INVALID_PARAM);
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring");
+
+  // a ring of one slot is full after one message, a producer must not
+  // take the committed slot for the next position
+  shm_unlink("/test_mq_ring1");
+  orv = open_ring(&mq, "/test_mq_ring1", 1);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (uint32_t i = 0; i < 3; i++) {
+    msg.seq = i;
+    orv = osal_mq_send(&mq, (char *)&msg, sizeof(msg), 0);
+    EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send() failed";
+
+    deadline = set_deadline(0, 10000000);
+    orv = osal_mq_timedsend(&mq, (char *)&msg, sizeof(msg), 0, &deadline);
+    EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "send to full ring did not time out";
+
+    msg.seq = 100;
+    orv = osal_mq_receive(&mq, (char *)&msg, sizeof(msg), &prio);
+    EXPECT_EQ(orv, OSAL_OK) << "osal_mq_receive() failed";
+    EXPECT_EQ(msg.seq, i);
+
+    deadline = set_deadline(0, 10000000);
+    orv = osal_mq_timedreceive(&mq, (char *)&msg, sizeof(msg), &prio, &deadline);
+    EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "receive from empty ring did not time out";
+  }
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring1");
+}
+
+/* messages built in place with reserve/commit are received in the
+   order they were reserved, peeked messages keep their slot until
+   they are released. */
+
+TEST(MessageQueueShmRing, ZeroCopy) {
+  const osal_size_t FRAME_SIZE = 4096;
+  osal_mq_t mq;
+  osal_mq_attr_t attr = {};
+  attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT |
+                OSAL_MQ_ATTR__OFLAG__SHM_RING;
+  attr.mode = S_IRUSR | S_IWUSR;
+  attr.max_messages = 2;
+  attr.max_message_size = FRAME_SIZE;
+
+  shm_unlink("/test_mq_ring_zc");
+  osal_retval_t orv = osal_mq_open(&mq, "/test_mq_ring_zc", &attr);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  osal_void_t *frames[2];
+  for (int i = 0; i < 2; i++) {
+    orv = osal_mq_reserve(&mq, FRAME_SIZE, &frames[i]);
+    ASSERT_EQ(orv, OSAL_OK) << "osal_mq_reserve() failed";
+    memset(frames[i], 'a' + i, FRAME_SIZE);
+  }
+
+  // second frame is held back until the first one is committed
+  ASSERT_EQ(osal_mq_commit(&mq, frames[1]), OSAL_OK);
+  EXPECT_EQ(osal_mq_commit(&mq, frames[1]), OSAL_ERR_INVALID_PARAM)
+      << "frame committed twice";
+
+  char buf[FRAME_SIZE];
+  osal_timer_t deadline = set_deadline(0, 50000000);
+  orv = osal_mq_timedreceive(&mq, buf, sizeof(buf), nullptr, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "received frame before it was committed";
+
+  ASSERT_EQ(osal_mq_commit(&mq, frames[0]), OSAL_OK);
+  EXPECT_EQ(osal_mq_release(&mq, frames[0]), OSAL_ERR_INVALID_PARAM)
+      << "frame released before it was peeked";
+
+  const osal_void_t *ptr[2];
+  for (int i = 0; i < 2; i++) {
+    osal_size_t len = 0;
+    orv = osal_mq_peek(&mq, &ptr[i], &len, nullptr);
+    ASSERT_EQ(orv, OSAL_OK) << "osal_mq_peek() failed";
+    EXPECT_EQ(len, FRAME_SIZE);
+    EXPECT_EQ(((const char *)ptr[i])[0], 'a' + i);
+    EXPECT_EQ(((const char *)ptr[i])[FRAME_SIZE - 1], 'a' + i);
+  }
+
+  // peeked slots are not free before release
+  deadline = set_deadline(0, 50000000);
+  orv = osal_mq_timedsend(&mq, buf, 1, 0, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT) << "slot reused before it was released";
+
+  EXPECT_EQ(osal_mq_release(&mq, (const char *)ptr[0] + 1), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_mq_release(&mq, buf), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_mq_commit(&mq, (osal_void_t *)ptr[0]), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_mq_release(&mq, ptr[0]), OSAL_OK);
+  EXPECT_EQ(osal_mq_release(&mq, ptr[0]), OSAL_ERR_INVALID_PARAM)
+      << "frame released twice";
+  EXPECT_EQ(osal_mq_release(&mq, ptr[1]), OSAL_OK);
+
+  orv = osal_mq_send(&mq, "x", 1, 0);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send() failed";
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_zc");
+
+  // with one slot every position maps to the same slot
+  attr.max_messages = 1;
+  shm_unlink("/test_mq_ring_zc1");
+  orv = osal_mq_open(&mq, "/test_mq_ring_zc1", &attr);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (int i = 0; i < 3; i++) {
+    osal_void_t *frame;
+    ASSERT_EQ(osal_mq_reserve(&mq, FRAME_SIZE, &frame), OSAL_OK);
+    ASSERT_EQ(osal_mq_commit(&mq, frame), OSAL_OK);
+    EXPECT_EQ(osal_mq_commit(&mq, frame), OSAL_ERR_INVALID_PARAM)
+        << "frame committed twice";
+
+    const osal_void_t *msg;
+    osal_size_t len = 0;
+    ASSERT_EQ(osal_mq_peek(&mq, &msg, &len, nullptr), OSAL_OK);
+    EXPECT_EQ(osal_mq_commit(&mq, (osal_void_t *)msg), OSAL_ERR_INVALID_PARAM);
+    ASSERT_EQ(osal_mq_release(&mq, msg), OSAL_OK);
+    EXPECT_EQ(osal_mq_release(&mq, msg), OSAL_ERR_INVALID_PARAM)
+        << "frame released twice";
+    EXPECT_EQ(osal_mq_commit(&mq, frame), OSAL_ERR_INVALID_PARAM)
+        << "released frame committed";
+  }
+
+  orv = osal_mq_send(&mq, "x", 1, 0);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send() failed";
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_zc1");
+}
+
+/* a batch sent to a blocked receiver is signaled once after the whole
+   batch, so the receiver gets all of it with one call. */
+
+struct batch_shared_t {
+  osal_mq_t mq;
+  char bufs[16][32];
+  osal_mq_msg_t msgs[16];
+  osal_size_t received;
+  osal_retval_t orv;
+};
+
+void *run_batch_receiver(void *p_arg) {
+  batch_shared_t *shared = (batch_shared_t *)p_arg;
+  osal_timer_t deadline = set_deadline(2, 0);
+  shared->orv = osal_mq_receive_batch(&shared->mq, shared->msgs, 16,
+                                      &shared->received, &deadline);
+  return nullptr;
+}
+
+TEST(MessageQueueShmRing, Batch) {
+  batch_shared_t shared = {};
+  char bufs[20][32];
+  osal_mq_msg_t msgs[20];
+  osal_size_t cnt = 0;
+  pthread_t receiver;
+
+  osal_mq_attr_t attr = {};
+  attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT |
+                OSAL_MQ_ATTR__OFLAG__SHM_RING;
+  attr.mode = S_IRUSR | S_IWUSR;
+  attr.max_messages = 16;
+  attr.max_message_size = 32;
+
+  shm_unlink("/test_mq_ring_batch");
+  osal_retval_t orv = osal_mq_open(&shared.mq, "/test_mq_ring_batch", &attr);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (int i = 0; i < 20; i++) {
+    msgs[i].msg = bufs[i];
+    msgs[i].len = snprintf(bufs[i], sizeof(bufs[i]), "msg %d", i) + 1;
+    msgs[i].prio = i;
+  }
+  for (int i = 0; i < 16; i++) {
+    shared.msgs[i].msg = shared.bufs[i];
+    shared.msgs[i].len = sizeof(shared.bufs[i]);
+  }
+
+  ASSERT_EQ(pthread_create(&receiver, nullptr, run_batch_receiver, &shared), 0);
+  osal_sleep(50000000);
+
+  orv = osal_mq_send_batch(&shared.mq, msgs, 8, &cnt, nullptr);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_send_batch() failed";
+  EXPECT_EQ(cnt, (osal_size_t)8);
+
+  pthread_join(receiver, nullptr);
+  EXPECT_EQ(shared.orv, OSAL_OK) << "osal_mq_receive_batch() failed";
+  ASSERT_EQ(shared.received, (osal_size_t)8) << "batch was split";
+  for (int i = 0; i < 8; i++) {
+    EXPECT_STREQ(shared.msgs[i].msg, bufs[i]);
+    EXPECT_EQ(shared.msgs[i].len, msgs[i].len);
+    EXPECT_EQ(shared.msgs[i].prio, (osal_uint32_t)i);
+  }
+
+  // batch larger than the ring times out after filling it
+  osal_timer_t deadline = set_deadline(0, 50000000);
+  orv = osal_mq_send_batch(&shared.mq, msgs, 20, &cnt, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(cnt, (osal_size_t)16);
+
+  for (int i = 0; i < 16; i++) {
+    shared.msgs[i].len = sizeof(shared.bufs[i]);
+  }
+  orv = osal_mq_receive_batch(&shared.mq, shared.msgs, 10, &cnt, nullptr);
+  EXPECT_EQ(orv, OSAL_OK);
+  EXPECT_EQ(cnt, (osal_size_t)10);
+  orv = osal_mq_receive_batch(&shared.mq, &shared.msgs[10], 6, &cnt, nullptr);
+  EXPECT_EQ(orv, OSAL_OK);
+  EXPECT_EQ(cnt, (osal_size_t)6);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_STREQ(shared.msgs[i].msg, bufs[i]);
+  }
+
+  for (int i = 0; i < 16; i++) {
+    shared.msgs[i].len = sizeof(shared.bufs[i]);
+  }
+  deadline = set_deadline(0, 50000000);
+  orv = osal_mq_receive_batch(&shared.mq, shared.msgs, 16, &cnt, &deadline);
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(cnt, (osal_size_t)0);
+
+  // batch stops at first invalid message
+  msgs[1].len = 64;
+  orv = osal_mq_send_batch(&shared.mq, msgs, 4, &cnt, nullptr);
+  EXPECT_EQ(orv, OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(cnt, (osal_size_t)1);
+
+  orv = osal_mq_close(&shared.mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_batch");
+}
+
+/* a commit wakes a single blocked consumer. If it is woken by a slot
+   behind one which is not committed yet, the wakeup still has to reach
+   a second consumer once both slots are committed. */
+
+struct wake_shared_t {
+  osal_mq_t mq;
+  osal_retval_t orv[2];
+  osal_uint64_t elapsed[2];
+};
+
+struct wake_arg_t {
+  wake_shared_t *shared;
+  int id;
+};
+
+void *run_wake_receiver(void *p_arg) {
+  wake_arg_t *arg = (wake_arg_t *)p_arg;
+  message_t msg;
+  osal_timer_t deadline = set_deadline(2, 0);
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  arg->shared->orv[arg->id] = osal_mq_timedreceive(
+      &arg->shared->mq, (char *)&msg, sizeof(msg), nullptr, &deadline);
+  arg->shared->elapsed[arg->id] = osal_timer_gettime_nsec() - start;
+  return nullptr;
+}
+
+TEST(MessageQueueShmRing, WakeOne) {
+  wake_shared_t shared = {};
+  wake_arg_t args[2];
+  pthread_t receivers[2];
+  osal_void_t *frames[2];
+
+  shm_unlink("/test_mq_ring_wake");
+  osal_retval_t orv = open_ring(&shared.mq, "/test_mq_ring_wake", 4);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (int i = 0; i < 2; i++) {
+    args[i] = {&shared, i};
+    ASSERT_EQ(pthread_create(&receivers[i], nullptr, run_wake_receiver, &args[i]), 0);
+  }
+  osal_sleep(50000000);
+
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ(osal_mq_reserve(&shared.mq, sizeof(message_t), &frames[i]), OSAL_OK);
+    memset(frames[i], 0, sizeof(message_t));
+  }
+
+  // the woken consumer finds the first slot not committed
+  ASSERT_EQ(osal_mq_commit(&shared.mq, frames[1]), OSAL_OK);
+  osal_sleep(20000000);
+  ASSERT_EQ(osal_mq_commit(&shared.mq, frames[0]), OSAL_OK);
+
+  for (int i = 0; i < 2; i++) {
+    pthread_join(receivers[i], nullptr);
+    EXPECT_EQ(shared.orv[i], OSAL_OK) << "consumer " << i;
+    EXPECT_LT(shared.elapsed[i], 1000000000u)
+        << "consumer " << i << " was not woken";
+  }
+
+  orv = osal_mq_close(&shared.mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_wake");
+}
+
+/* several producers and consumers share a small ring, so both sides
+   block frequently. Every message has to be received exactly once and
+   in order per producer. */
+
+namespace multiwriter_multireader {
+const uint32_t N_PRODUCERS = 4;
+const uint32_t M_CONSUMERS = 3;
+const uint32_t NUM_MESSAGES_PER_PRODUCER = 20000;
+
+struct shared_t {
+  osal_mq_t mq;
+  uint32_t received[M_CONSUMERS][N_PRODUCERS];
+  bool in_order[M_CONSUMERS];
+};
+
+struct arg_t {
+  shared_t *shared;
+  uint32_t id;
+};
+
+void *run_producer(void *p_arg) {
+  arg_t *arg = (arg_t *)p_arg;
+  message_t msg = {arg->id, 0};
+
+  for (uint32_t i = 0; i < NUM_MESSAGES_PER_PRODUCER; i++) {
+    msg.seq = i;
+    osal_mq_send(&arg->shared->mq, (char *)&msg, sizeof(msg), 0);
+  }
+
+  return nullptr;
+}
+
+void *run_consumer(void *p_arg) {
+  arg_t *arg = (arg_t *)p_arg;
+  shared_t *shared = arg->shared;
+  int32_t last[N_PRODUCERS];
+  message_t msg;
+
+  for (uint32_t i = 0; i < N_PRODUCERS; i++) {
+    last[i] = -1;
+  }
+
+  while (true) {
+    osal_timer_t deadline = set_deadline(0, 200000000);
+    if (osal_mq_timedreceive(&shared->mq, (char *)&msg, sizeof(msg), nullptr,
+                             &deadline) != OSAL_OK) {
+      break;
+    }
+
+    if ((msg.producer >= N_PRODUCERS) || ((int32_t)msg.seq <= last[msg.producer])) {
+      shared->in_order[arg->id] = false;
+    } else {
+      last[msg.producer] = msg.seq;
+    }
+    shared->received[arg->id][msg.producer % N_PRODUCERS]++;
+  }
+
+  return nullptr;
+}
+
+TEST(MessageQueueShmRing, MultiSendMultiReceive) {
+  shared_t shared = {};
+  pthread_t producers[N_PRODUCERS];
+  pthread_t consumers[M_CONSUMERS];
+  arg_t producer_args[N_PRODUCERS];
+  arg_t consumer_args[M_CONSUMERS];
+
+  shm_unlink("/test_mq_ring_mpmc");
+  osal_retval_t orv = open_ring(&shared.mq, "/test_mq_ring_mpmc", 8);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  for (uint32_t i = 0; i < M_CONSUMERS; i++) {
+    shared.in_order[i] = true;
+    consumer_args[i] = {&shared, i};
+    ASSERT_EQ(pthread_create(&consumers[i], nullptr, run_consumer, &consumer_args[i]), 0);
+  }
+
+  for (uint32_t i = 0; i < N_PRODUCERS; i++) {
+    producer_args[i] = {&shared, i};
+    ASSERT_EQ(pthread_create(&producers[i], nullptr, run_producer, &producer_args[i]), 0);
+  }
+
+  for (uint32_t i = 0; i < N_PRODUCERS; i++) {
+    pthread_join(producers[i], nullptr);
+  }
+
+  for (uint32_t i = 0; i < M_CONSUMERS; i++) {
+    pthread_join(consumers[i], nullptr);
+    EXPECT_TRUE(shared.in_order[i]) << "consumer " << i << " received messages out of order";
+  }
+
+  for (uint32_t p = 0; p < N_PRODUCERS; p++) {
+    uint32_t sum = 0;
+    for (uint32_t c = 0; c < M_CONSUMERS; c++) {
+      sum += shared.received[c][p];
+    }
+    EXPECT_EQ(sum, NUM_MESSAGES_PER_PRODUCER) << "messages of producer " << p << " lost";
+  }
+
+  orv = osal_mq_close(&shared.mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_mpmc");
+}
+
+} // namespace multiwriter_multireader
+
+/* a second process opens the existing ring by name and sends to
+   the creating process. */
+
+TEST(MessageQueueShmRing, InterProcess) {
+  const uint32_t NUM_MESSAGES = 10000;
+  osal_mq_t mq;
+  message_t msg;
+
+  shm_unlink("/test_mq_ring_proc");
+  osal_retval_t orv = open_ring(&mq, "/test_mq_ring_proc", 16);
+  ASSERT_EQ(orv, OSAL_OK) << "osal_mq_open() failed";
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+
+  if (pid == 0) {
+    osal_mq_t child_mq;
+    osal_mq_attr_t attr = {};
+    attr.oflags = OSAL_MQ_ATTR__OFLAG__WRONLY | OSAL_MQ_ATTR__OFLAG__SHM_RING;
+
+    if (osal_mq_open(&child_mq, "/test_mq_ring_proc", &attr) != OSAL_OK) {
+      _exit(1);
+    }
+
+    for (uint32_t i = 0; i < NUM_MESSAGES; i++) {
+      msg = {1, i};
+      if (osal_mq_send(&child_mq, (char *)&msg, sizeof(msg), 0) != OSAL_OK) {
+        _exit(2);
+      }
+    }
+
+    osal_mq_close(&child_mq);
+    _exit(0);
+  }
+
+  uint32_t received = 0;
+  for (uint32_t i = 0; i < NUM_MESSAGES; i++) {
+    osal_timer_t deadline = set_deadline(2, 0);
+    orv = osal_mq_timedreceive(&mq, (char *)&msg, sizeof(msg), nullptr, &deadline);
+    if (orv != OSAL_OK) {
+      break;
+    }
+    EXPECT_EQ(msg.seq, i);
+    received++;
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0)) << "child failed";
+  EXPECT_EQ(received, NUM_MESSAGES);
+
+  orv = osal_mq_close(&mq);
+  EXPECT_EQ(orv, OSAL_OK) << "osal_mq_close() failed";
+  shm_unlink("/test_mq_ring_proc");
+}
+
+} // namespace test_messagequeue_shmring
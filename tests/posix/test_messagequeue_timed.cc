@@ -53,7 +53,7 @@ void *run_producer(void *p_params) {
       now.tv_nsec -= 1000000000;
       now.tv_sec += 1;
     }
-    osal_timer_t deadline;
+    osal_timer_t deadline = OSAL_TIMER_INITIALIZER_CLOCK(CLOCK_REALTIME);
     deadline.sec = now.tv_sec;
     deadline.nsec = now.tv_nsec;
 
@@ -98,7 +98,7 @@ void *run_consumer(void *p_params) {
       now.tv_nsec -= 1000000000;
       now.tv_sec += 1;
     }
-    osal_timer_t deadline;
+    osal_timer_t deadline = OSAL_TIMER_INITIALIZER_CLOCK(CLOCK_REALTIME);
     deadline.sec = now.tv_sec;
     deadline.nsec = now.tv_nsec;
 
@@ -155,6 +155,55 @@ TEST(MutexFunction, ParallelMultiThreading) {
       << "multi-threaded counter test failed";
 }
 
+/* adaptive mutexes spin before blocking. They have to provide the
+   same mutual exclusion, also in combination with priority
+   inheritance and robustness. */
+
+TEST(MutexFunction, AdaptiveParallel) {
+  const ulong N_THREADS = 8;
+  const uint LOOPCOUNT = 20000;
+  const osal_mutex_attr_t attrs[] = {
+      OSAL_MUTEX_ATTR__ADAPTIVE,
+      OSAL_MUTEX_ATTR__ADAPTIVE | (3u << OSAL_MUTEX_ATTR__ADAPTIVE_SPIN__SHIFT),
+      OSAL_MUTEX_ATTR__ADAPTIVE | OSAL_MUTEX_ATTR__PROTOCOL__INHERIT,
+      OSAL_MUTEX_ATTR__ADAPTIVE | OSAL_MUTEX_ATTR__ROBUST |
+          OSAL_MUTEX_ATTR__TYPE__ERRORCHECK,
+  };
+
+  for (osal_mutex_attr_t attr : attrs) {
+    pthread_t thread_ids[N_THREADS];
+    thread_param_t thread_params[N_THREADS];
+    osal_mutex_t count_mutex;
+    unsigned long counter = 0;
+    osal_retval_t orv;
+    int rv;
+
+    orv = osal_mutex_init(&count_mutex, &attr);
+    ASSERT_EQ(orv, OSAL_OK) << "osal_mutex_init() failed";
+
+    for (ulong i = 0; i < N_THREADS; i++) {
+      thread_params[i].thread_id = i;
+      thread_params[i].p_count_mutex = &count_mutex;
+      thread_params[i].p_counter = &counter;
+      thread_params[i].loopcount = LOOPCOUNT;
+      thread_params[i].max_wait_time_nsec = 0;
+
+      rv = pthread_create(&(thread_ids[i]), nullptr, test_random,
+                          (void *)&(thread_params[i]));
+      ASSERT_EQ(rv, 0) << "pthread_create() failed";
+    }
+    for (ulong i = 0; i < N_THREADS; i++) {
+      rv = pthread_join(thread_ids[i], nullptr);
+      ASSERT_EQ(rv, 0) << "pthread_join() failed";
+    }
+    orv = osal_mutex_destroy(&count_mutex);
+    ASSERT_EQ(orv, OSAL_OK) << "osal_mutex_destroy() failed";
+
+    EXPECT_EQ(counter, N_THREADS * LOOPCOUNT)
+        << "multi-threaded counter test failed for attr " << attr;
+  }
+}
+
 TEST(MutexFunction, MultithreadingPlusRandomizedWait) {
   const ulong N_THREADS = 8;
   const uint LOOPCOUNT = 10000;
@@ -330,6 +379,32 @@ TEST(MutexDetect, OwnerDead2) {
   EXPECT_EQ(orv, 0) << "Could not destroy mutex";
 }
 
+TEST(MutexDetect, AdaptiveOwnerDead) {
+  osal_mutex_t my_mutex;
+  osal_mutex_attr_t attr;
+  osal_retval_t orv = {};
+  int rv = 0;
+  pthread_t thread_id;
+
+  attr = OSAL_MUTEX_ATTR__TYPE__ERRORCHECK | OSAL_MUTEX_ATTR__ROBUST |
+         OSAL_MUTEX_ATTR__ADAPTIVE;
+
+  orv = osal_mutex_init(&my_mutex, &attr);
+  ASSERT_EQ(orv, 0) << "Could not initialize mutex";
+
+  rv = pthread_create(&thread_id, nullptr, lock_thread, (void *)&(my_mutex));
+  ASSERT_EQ(rv, 0) << "pthread_create() failed";
+  rv = pthread_join(thread_id, nullptr);
+  ASSERT_EQ(rv, 0) << "pthread_join() failed";
+
+  // spin phase has to pass the owner dead state through
+  orv = osal_mutex_lock(&my_mutex);
+  EXPECT_EQ(orv, OSAL_ERR_OWNER_DEAD) << "Could lock orphaned mutex";
+
+  orv = osal_mutex_destroy(&my_mutex);
+  EXPECT_EQ(orv, 0) << "Could not destroy mutex";
+}
+
 TEST(MutexFunction, InheritPar) {
   osal_mutex_t my_mutex;
   osal_mutex_attr_t attr;
@@ -0,0 +1,213 @@
+#include "libosal/osal.h"
+#include "libosal/rwlock.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace test_rwlock {
+
+using testutils::set_deadline;
+
+/*
+  Tests of the reader-writer lock.
+*/
+
+/* readers share the lock, writers exclude everybody. */
+
+TEST(RwlockFunction, SingleThreaded) {
+  osal_rwlock_t rw;
+  osal_timer_t deadline;
+
+  ASSERT_EQ(osal_rwlock_init(&rw, NULL), OSAL_OK);
+
+  EXPECT_EQ(osal_rwlock_rdlock(&rw), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_tryrdlock(&rw), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_trywrlock(&rw), OSAL_ERR_BUSY);
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_rwlock_timedwrlock(&rw, &deadline), OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+
+  EXPECT_EQ(osal_rwlock_wrlock(&rw), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_tryrdlock(&rw), OSAL_ERR_BUSY);
+  EXPECT_EQ(osal_rwlock_trywrlock(&rw), OSAL_ERR_BUSY);
+  EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_rwlock_timedwrlock(&rw, &deadline), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_rwlock_timedrdlock(&rw, &deadline), OSAL_OK);
+  EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+
+  EXPECT_EQ(osal_rwlock_destroy(&rw), OSAL_OK);
+}
+
+/* writers update two values which readers must always see
+   consistently, and no increment of the writers may be lost. */
+
+struct shared_data {
+  osal_rwlock_t rw;
+  volatile unsigned long a;
+  volatile unsigned long b;
+  volatile int inconsistent;
+};
+
+const int LOOPCOUNT = 20000;
+
+static void *reader(void *arg) {
+  shared_data *data = (shared_data *)arg;
+
+  for (int i = 0; i < LOOPCOUNT; i++) {
+    osal_rwlock_rdlock(&data->rw);
+    if (data->a != data->b) {
+      data->inconsistent = 1;
+    }
+    osal_rwlock_unlock(&data->rw);
+  }
+
+  return NULL;
+}
+
+static void *writer(void *arg) {
+  shared_data *data = (shared_data *)arg;
+
+  for (int i = 0; i < LOOPCOUNT; i++) {
+    osal_rwlock_wrlock(&data->rw);
+    data->a = data->a + 1;
+    data->b = data->b + 1;
+    osal_rwlock_unlock(&data->rw);
+  }
+
+  return NULL;
+}
+
+TEST(RwlockFunction, ParallelReadersWriters) {
+  const int N_READERS = 8;
+  const int N_WRITERS = 2;
+  const osal_rwlock_attr_t attrs[] = {0, OSAL_RWLOCK_ATTR__PREFER_WRITER};
+
+  for (osal_rwlock_attr_t attr : attrs) {
+    shared_data data = {};
+    pthread_t threads[N_READERS + N_WRITERS];
+
+    ASSERT_EQ(osal_rwlock_init(&data.rw, &attr), OSAL_OK);
+
+    for (int i = 0; i < N_READERS + N_WRITERS; i++) {
+      ASSERT_EQ(pthread_create(&threads[i], NULL,
+                               i < N_READERS ? reader : writer, &data),
+                0);
+    }
+    for (int i = 0; i < N_READERS + N_WRITERS; i++) {
+      pthread_join(threads[i], NULL);
+    }
+
+    EXPECT_EQ(data.inconsistent, 0) << "reader saw a partial update";
+    EXPECT_EQ(data.a, (unsigned long)(N_WRITERS * LOOPCOUNT));
+    EXPECT_EQ(osal_rwlock_destroy(&data.rw), OSAL_OK);
+  }
+}
+
+/* with writer preference a waiting writer blocks new readers, with
+   the default reader preference new readers still get the lock. */
+
+static void *blocked_writer(void *arg) {
+  osal_rwlock_t *rw = (osal_rwlock_t *)arg;
+
+  osal_rwlock_wrlock(rw);
+  osal_rwlock_unlock(rw);
+
+  return NULL;
+}
+
+struct reader_result {
+  osal_rwlock_t *rw;
+  osal_retval_t ret;
+};
+
+static void *timed_reader(void *arg) {
+  reader_result *res = (reader_result *)arg;
+  osal_timer_t deadline = set_deadline(0, 50000000);
+
+  res->ret = osal_rwlock_timedrdlock(res->rw, &deadline);
+  if (res->ret == OSAL_OK) {
+    osal_rwlock_unlock(res->rw);
+  }
+
+  return NULL;
+}
+
+TEST(RwlockFunction, PreferWriter) {
+  const osal_rwlock_attr_t attrs[] = {0, OSAL_RWLOCK_ATTR__PREFER_WRITER};
+  const osal_retval_t expected[] = {OSAL_OK, OSAL_ERR_TIMEOUT};
+
+  for (int i = 0; i < 2; i++) {
+    osal_rwlock_t rw;
+    pthread_t writer_thread, reader_thread;
+    reader_result res = {&rw, OSAL_ERR_OPERATION_FAILED};
+
+    ASSERT_EQ(osal_rwlock_init(&rw, &attrs[i]), OSAL_OK);
+    ASSERT_EQ(osal_rwlock_rdlock(&rw), OSAL_OK);
+
+    ASSERT_EQ(pthread_create(&writer_thread, NULL, blocked_writer, &rw), 0);
+    osal_sleep(50000000);
+
+    ASSERT_EQ(pthread_create(&reader_thread, NULL, timed_reader, &res), 0);
+    pthread_join(reader_thread, NULL);
+    EXPECT_EQ(res.ret, expected[i]) << "unexpected reader result for attr "
+                                    << attrs[i];
+
+    EXPECT_EQ(osal_rwlock_unlock(&rw), OSAL_OK);
+    pthread_join(writer_thread, NULL);
+    EXPECT_EQ(osal_rwlock_destroy(&rw), OSAL_OK);
+  }
+}
+
+/* a process shared rwlock in shared memory excludes another
+   process. */
+
+TEST(RwlockFunction, ProcessShared) {
+  osal_rwlock_t *rw = (osal_rwlock_t *)mmap(NULL, sizeof(osal_rwlock_t),
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(rw, MAP_FAILED) << "mmap() failed";
+
+  osal_rwlock_attr_t attr = OSAL_RWLOCK_ATTR__PROCESS_SHARED;
+  ASSERT_EQ(osal_rwlock_init(rw, &attr), OSAL_OK);
+  ASSERT_EQ(osal_rwlock_wrlock(rw), OSAL_OK);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+
+  if (pid == 0) {
+    int failed = 0;
+    osal_timer_t deadline = set_deadline(0, 20000000);
+
+    failed |= (osal_rwlock_tryrdlock(rw) != OSAL_ERR_BUSY);
+    failed |= (osal_rwlock_timedrdlock(rw, &deadline) != OSAL_ERR_TIMEOUT);
+    deadline = set_deadline(5, 0);
+    failed |= (osal_rwlock_timedrdlock(rw, &deadline) != OSAL_OK);
+    failed |= (osal_rwlock_unlock(rw) != OSAL_OK);
+    _exit(failed);
+  }
+
+  osal_sleep(100000000);
+  EXPECT_EQ(osal_rwlock_unlock(rw), OSAL_OK);
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  EXPECT_EQ(status, 0) << "child process failed";
+
+  EXPECT_EQ(osal_rwlock_destroy(rw), OSAL_OK);
+  munmap(rw, sizeof(osal_rwlock_t));
+}
+
+} // namespace test_rwlock
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
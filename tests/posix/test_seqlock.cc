@@ -0,0 +1,199 @@
+#include "libosal/osal.h"
+#include "libosal/seqlock.h"
+#include "libosal/shm.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace test_seqlock {
+
+/*
+  Tests of the sequence lock. Snapshots are checked for torn reads
+  by writing state vectors whose elements all carry the same value.
+*/
+
+const int NUM_VALUES = 64;
+
+struct state_t {
+  uint64_t values[NUM_VALUES];
+};
+
+struct shared_t {
+  osal_seqlock_t sl;
+  state_t state;
+  volatile int stop;
+};
+
+static void fill_state(state_t *state, uint64_t value) {
+  for (int i = 0; i < NUM_VALUES; i++) {
+    state->values[i] = value;
+  }
+}
+
+static bool is_consistent(const state_t *state) {
+  for (int i = 1; i < NUM_VALUES; i++) {
+    if (state->values[i] != state->values[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* readers retry while a write section is active. */
+
+TEST(SeqlockFunction, SingleThreaded) {
+  osal_seqlock_t sl;
+  state_t state, snapshot;
+
+  ASSERT_EQ(osal_seqlock_init(&sl, NULL), OSAL_OK);
+
+  fill_state(&state, 1);
+  EXPECT_EQ(osal_seqlock_write(&sl, &state, &state, sizeof(state)), OSAL_OK);
+
+  osal_uint32_t seq = osal_seqlock_read_begin(&sl);
+  EXPECT_EQ(osal_seqlock_read_retry(&sl, seq), 0u);
+
+  EXPECT_EQ(osal_seqlock_write_begin(&sl), OSAL_OK);
+  EXPECT_EQ(osal_seqlock_read_retry(&sl, seq), 1u)
+      << "read section overlapping a write was not detected";
+  EXPECT_EQ(osal_seqlock_tryread(&sl, &snapshot, &state, sizeof(state)),
+            OSAL_ERR_BUSY);
+  fill_state(&state, 2);
+  EXPECT_EQ(osal_seqlock_write_end(&sl), OSAL_OK);
+
+  EXPECT_EQ(osal_seqlock_tryread(&sl, &snapshot, &state, sizeof(state)),
+            OSAL_OK);
+  EXPECT_EQ(snapshot.values[0], 2u);
+  EXPECT_EQ(osal_seqlock_read(&sl, &snapshot, &state, sizeof(state)), OSAL_OK);
+  EXPECT_TRUE(is_consistent(&snapshot));
+
+  EXPECT_EQ(osal_seqlock_destroy(&sl), OSAL_OK);
+}
+
+/* a writer thread continuously updates the state, reader threads
+   must never see a torn snapshot and must see increasing values. */
+
+static void *writer(void *arg) {
+  shared_t *shared = (shared_t *)arg;
+  state_t next;
+  uint64_t value = 0;
+
+  while (!shared->stop) {
+    fill_state(&next, ++value);
+    osal_seqlock_write(&shared->sl, &shared->state, &next, sizeof(next));
+  }
+
+  return NULL;
+}
+
+static void *reader(void *arg) {
+  shared_t *shared = (shared_t *)arg;
+  state_t snapshot;
+  uint64_t last = 0;
+  long failed = 0;
+
+  for (int i = 0; i < 100000; i++) {
+    osal_seqlock_read(&shared->sl, &snapshot, &shared->state, sizeof(snapshot));
+    if (!is_consistent(&snapshot) || (snapshot.values[0] < last)) {
+      failed++;
+    }
+    last = snapshot.values[0];
+  }
+
+  return (void *)failed;
+}
+
+TEST(SeqlockFunction, ParallelTornReads) {
+  const int N_READERS = 4;
+  shared_t shared = {};
+  pthread_t writer_thread, reader_threads[N_READERS];
+
+  ASSERT_EQ(osal_seqlock_init(&shared.sl, NULL), OSAL_OK);
+
+  ASSERT_EQ(pthread_create(&writer_thread, NULL, writer, &shared), 0);
+  for (int i = 0; i < N_READERS; i++) {
+    ASSERT_EQ(pthread_create(&reader_threads[i], NULL, reader, &shared), 0);
+  }
+
+  for (int i = 0; i < N_READERS; i++) {
+    void *failed = NULL;
+    pthread_join(reader_threads[i], &failed);
+    EXPECT_EQ((long)failed, 0) << "reader saw torn or outdated snapshots";
+  }
+
+  shared.stop = 1;
+  pthread_join(writer_thread, NULL);
+  EXPECT_EQ(osal_seqlock_destroy(&shared.sl), OSAL_OK);
+}
+
+/* the seqlock works inside memory mapped with osal_shm_map, the
+   writer runs in another process. */
+
+#define SHM_NAME "/test_seqlock"
+
+static shared_t *map_shared(osal_shm_t *shm, osal_shm_attr_t attr) {
+  shared_t *shared = NULL;
+  osal_shm_map_attr_t map_attr = (OSAL_SHM_MAP_ATTR__PROT_READ |
+                                  OSAL_SHM_MAP_ATTR__PROT_WRITE |
+                                  OSAL_SHM_MAP_ATTR__SHARED);
+
+  if (osal_shm_open(shm, SHM_NAME, &attr, sizeof(shared_t)) != OSAL_OK) {
+    return NULL;
+  }
+  if (osal_shm_map(shm, &map_attr, (osal_void_t **)&shared) != OSAL_OK) {
+    return NULL;
+  }
+  return shared;
+}
+
+TEST(SeqlockFunction, SharedMemory) {
+  osal_shm_t shm;
+
+  shm_unlink(SHM_NAME);
+  shared_t *shared = map_shared(
+      &shm, OSAL_SHM_ATTR__FLAG__RDWR | OSAL_SHM_ATTR__FLAG__CREAT |
+                (S_IRWXU << OSAL_SHM_ATTR__MODE__SHIFT));
+  ASSERT_NE(shared, nullptr) << "could not map shared memory";
+
+  osal_seqlock_attr_t attr = OSAL_SEQLOCK_ATTR__PROCESS_SHARED;
+  ASSERT_EQ(osal_seqlock_init(&shared->sl, &attr), OSAL_OK);
+  fill_state(&shared->state, 0);
+  shared->stop = 0;
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+
+  if (pid == 0) {
+    osal_shm_t child_shm;
+    shared_t *child =
+        map_shared(&child_shm, OSAL_SHM_ATTR__FLAG__RDWR);
+    if (child == NULL) {
+      _exit(1);
+    }
+    writer(child);
+    _exit(0);
+  }
+
+  long failed = (long)reader(shared);
+  EXPECT_EQ(failed, 0) << "reader saw torn or outdated snapshots";
+
+  shared->stop = 1;
+  int status = -1;
+  waitpid(pid, &status, 0);
+  EXPECT_EQ(status, 0) << "writer process failed";
+
+  EXPECT_EQ(osal_seqlock_destroy(&shared->sl), OSAL_OK);
+  EXPECT_EQ(osal_shm_close(&shm), OSAL_OK);
+  shm_unlink(SHM_NAME);
+}
+
+} // namespace test_seqlock
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
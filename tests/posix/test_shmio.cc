@@ -2,7 +2,14 @@
 
 #include "libosal/io.h"
 #include "libosal/osal.h"
+#include "libosal/timer.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include <unistd.h>
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace test_shmio {
 
@@ -27,6 +34,749 @@ TEST(SHMIOFunction, SimpleMessage) {
                     << "' vs. '" << TEST_MESSAGE << "'";
 }
 
+/* in binary mode the reader formats the message from the format table
+   and the raw arguments, which has to give the same text as formatting
+   by the writer. */
+
+TEST(SHMIOFunction, BinaryMessage) {
+  const char *str_arg = "string";
+  char expected[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+  unlink("/dev/shm/shm_io_bin");
+  osal_io_shm_attr_t attr = OSAL_IO_SHM_ATTR__BINARY;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_bin", 16, 256, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  for (int i = 0; i < 3; i++) {
+    orv = osal_printf("%d %-5u|%+.3f %s %*d %.*s %ld %lld %zu %x %c %% %p\n", 
+            -i, 42u, 3.14159 * i, str_arg, 6, i, 3, str_arg, -1234567L, 
+            (long long)1 << 40, (size_t)77, 0xbeef, 'z', (void *)str_arg);
+    EXPECT_EQ(orv, 0) << " osal_printf failed";
+
+    snprintf(expected, sizeof(expected), "%d %-5u|%+.3f %s %*d %.*s %ld %lld %zu %x %c %% %p\n", 
+            -i, 42u, 3.14159 * i, str_arg, 6, i, 3, str_arg, -1234567L, 
+            (long long)1 << 40, (size_t)77, 0xbeef, 'z', (void *)str_arg);
+
+    orv = osal_io_shm_get_message(msg, nullptr);
+    EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+    EXPECT_STREQ(msg, expected);
+  }
+
+  // long double is not recorded in binary, formatted by the writer instead
+  orv = osal_printf("%.2Lf\n", (long double)1.5);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "1.50\n");
+
+  // strings are truncated to the message size
+  std::string long_str(1000, 'x');
+  orv = osal_printf("%s|%d\n", long_str.c_str(), 5);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_EQ(strncmp(msg, long_str.c_str(), 100), 0);
+  EXPECT_LT(strlen(msg), (size_t)256);
+
+  // a format buffer reused with other content is not recorded with the
+  // argument types cached for the old content
+  char fmt_buf[32];
+  strcpy(fmt_buf, "%d\n");
+  orv = osal_printf(fmt_buf, 7);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "7\n");
+
+  strcpy(fmt_buf, "%s\n");
+  orv = osal_printf(fmt_buf, str_arg);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "string\n");
+}
+
+/* string arguments with a precision need not be zero-terminated, the
+   writer must not read beyond the precision just like snprintf. */
+
+TEST(SHMIOFunction, BinaryMessagePrecision) {
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+  long page_size = sysconf(_SC_PAGESIZE);
+
+  unlink("/dev/shm/shm_io_bin_prec");
+  osal_io_shm_attr_t attr = OSAL_IO_SHM_ATTR__BINARY;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_bin_prec", 16, 256, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  // 4 bytes without terminating zero right in front of an inaccessible page
+  char *pages = (char *)mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, 
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(pages, MAP_FAILED);
+  ASSERT_EQ(mprotect(&pages[page_size], page_size, PROT_NONE), 0);
+  char *field = &pages[page_size - 4];
+  memcpy(field, "abcd", 4);
+
+  orv = osal_printf("[%.4s]\n", field);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "[abcd]\n");
+
+  orv = osal_printf("[%*.*s|%.2s]\n", 6, 4, field, field);
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "[  abcd|ab]\n");
+
+  // a negative precision argument is taken as if it was omitted
+  orv = osal_printf("[%.*s]\n", -1, "string");
+  EXPECT_EQ(orv, 0) << " osal_printf failed";
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_EQ(orv, 0) << " osal_io_shm_get_message failed";
+  EXPECT_STREQ(msg, "[string]\n");
+
+  munmap(pages, 2 * page_size);
+}
+
+TEST(SHMIOFunction, BatchMessages) {
+  const int NUM_MSGS = 10;
+  osal_char_t msgs[16][LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+  osal_size_t cnt = 0;
+
+  unlink("/dev/shm/shm_io_batch");
+  osal_retval_t orv = osal_io_shm_setup("shm_io_batch", 32, 64);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_get_messages(msgs, 16, &cnt, nullptr) == OSAL_OK) {
+  }
+
+  for (int i = 0; i < NUM_MSGS; i++) {
+    osal_printf("batch %d\n", i);
+  }
+
+  osal_timer_t deadline = {(osal_uint64_t)time(nullptr) + 2, 0};
+  orv = osal_io_shm_get_messages(msgs, 16, &cnt, &deadline);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_get_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)NUM_MSGS);
+
+  for (int i = 0; i < NUM_MSGS; i++) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "batch %d\n", i);
+    EXPECT_STREQ(msgs[i], expected);
+  }
+
+  orv = osal_io_shm_get_messages(msgs, 16, &cnt, nullptr);
+  EXPECT_NE(orv, 0) << " unexpected additional message";
+  EXPECT_EQ(cnt, (osal_size_t)0);
+}
+
+/* messages acquired zero-copy point into the shm ring and must
+   not be overwritten by writers until they are committed. */
+
+TEST(SHMIOFunction, ZeroCopyMessages) {
+  const int NUM_MSGS = 4;
+  osal_io_shm_msg_t msgs[64];
+  osal_size_t cnt = 0;
+
+  unlink("/dev/shm/shm_io_zc");
+  osal_retval_t orv = osal_io_shm_setup("shm_io_zc", 4, 64);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr) == OSAL_OK) {
+    osal_io_shm_commit_messages();
+  }
+
+  for (int i = 0; i < NUM_MSGS; i++) {
+    osal_printf("zero copy %d\n", i);
+  }
+
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)NUM_MSGS);
+
+  // only one batch at a time
+  osal_size_t cnt2 = 0;
+  EXPECT_EQ(osal_io_shm_acquire_messages(msgs, 64, &cnt2, nullptr), OSAL_ERR_BUSY);
+
+  // fill the rest of the ring, once it is full new messages have to be 
+  // dropped because all older ones are held
+  int extra = 0;
+  while ((extra < 64) && (osal_printf("extra %d\n", extra) == OSAL_OK)) {
+    extra++;
+  }
+  EXPECT_LT(extra, 64) << " held messages were dropped";
+
+  for (int i = 0; i < NUM_MSGS; i++) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "zero copy %d\n", i);
+    EXPECT_EQ(std::string(msgs[i].msg, msgs[i].len), expected);
+  }
+
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_ERR_INVALID_PARAM);
+
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)extra);
+
+  for (int i = 0; i < extra; i++) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "extra %d\n", i);
+    EXPECT_EQ(std::string(msgs[i].msg, msgs[i].len), expected);
+  }
+
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+
+  EXPECT_EQ(osal_printf("after commit\n"), OSAL_OK);
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)1);
+  EXPECT_STREQ(msgs[0].msg, "after commit\n");
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+}
+
+/* with drop newest policy a full ring keeps the oldest messages,
+   every dropped message is counted in the shm statistics. */
+
+TEST(SHMIOFunction, OverflowDropNewest) {
+  const int NUM_MSGS = 4;
+  osal_io_shm_msg_t msgs[64];
+  osal_size_t cnt = 0;
+  osal_io_shm_stats_t start, stats;
+
+  unlink("/dev/shm/shm_io_drop");
+  osal_io_shm_attr_t attr = OSAL_IO_SHM_ATTR__OVERFLOW__DROP_NEWEST;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_drop", NUM_MSGS, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr) == OSAL_OK) {
+    osal_io_shm_commit_messages();
+  }
+
+  ASSERT_EQ(osal_io_shm_get_stats(&start), OSAL_OK);
+  EXPECT_EQ(start.num_rings, 1u);
+  EXPECT_GE(start.size, (osal_uint64_t)(NUM_MSGS * 64));
+  EXPECT_EQ(start.dropped, 0u);
+
+  int kept = 0;
+  while ((kept < 64) && (osal_printf("drop %d\n", kept) == OSAL_OK)) {
+    kept++;
+  }
+
+  // short messages take less space than the maximum message size
+  EXPECT_GT(kept, NUM_MSGS);
+  EXPECT_LT(kept, 64);
+  EXPECT_EQ(osal_printf("drop %d\n", kept), OSAL_ERR_BUSY);
+
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.messages - start.messages, (osal_uint64_t)kept);
+  EXPECT_EQ(stats.dropped, 2u);
+  EXPECT_GT(stats.high_water_mark, stats.size / 2);
+  EXPECT_LE(stats.high_water_mark, stats.size);
+
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)kept);
+
+  osal_uint64_t bytes = 0;
+  for (int i = 0; i < kept; i++) {
+    char expected[32];
+    snprintf(expected, sizeof(expected), "drop %d\n", i);
+    EXPECT_EQ(std::string(msgs[i].msg, msgs[i].len), expected);
+    bytes += msgs[i].len;
+  }
+
+  EXPECT_EQ(stats.bytes - start.bytes, bytes);
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+}
+
+/* with blocking policy a writer waits for the reader to free slots
+   at most until the configured timeout expires. */
+
+TEST(SHMIOFunction, OverflowBlockTimeout) {
+  osal_io_shm_msg_t msgs[64];
+  osal_size_t cnt = 0;
+  osal_io_shm_stats_t stats;
+
+  unlink("/dev/shm/shm_io_block");
+  osal_io_shm_attr_t attr = OSAL_IO_SHM_ATTR__OVERFLOW__BLOCK | 
+    (100u << OSAL_IO_SHM_ATTR__BLOCK_TIMEOUT__SHIFT);
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_block", 4, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr) == OSAL_OK) {
+    osal_io_shm_commit_messages();
+  }
+
+  int written = 0;
+  osal_uint64_t start = 0;
+  do {
+    start = osal_timer_gettime_nsec();
+    orv = osal_printf("block %d\n", written);
+  } while ((orv == OSAL_OK) && (++written < 64));
+
+  osal_uint64_t waited = osal_timer_gettime_nsec() - start;
+  EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+  EXPECT_GE(waited, 90000000u) << " writer did not block";
+  EXPECT_LT(waited, 2000000000u) << " writer blocked too long";
+
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.dropped, 1u);
+
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  EXPECT_EQ(cnt, (osal_size_t)written);
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+
+  // reset policy for other tests
+  attr = 0;
+  orv = osal_io_shm_setup_attr("shm_io_block", 4, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+}
+
+/* disabled levels must not evaluate their arguments, enabled records
+   carry level, tag, task id and a monotonic timestamp. */
+
+static int shmio_log_evaluated = 0;
+
+static int shmio_log_arg(int val) {
+  shmio_log_evaluated++;
+  return val;
+}
+
+TEST(SHMIOFunction, LogLevels) {
+  static const char TAG[] = "test";
+  osal_io_shm_msg_t msgs[64];
+  osal_size_t cnt = 0;
+  shmio_log_evaluated = 0;
+
+  unlink("/dev/shm/shm_io_level");
+  osal_retval_t orv = osal_io_shm_setup("shm_io_level", 16, 128);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr) == OSAL_OK) {
+    osal_io_shm_commit_messages();
+  }
+
+  EXPECT_EQ(osal_io_get_log_level(), OSAL_IO_LOG_LEVEL__INFO);
+
+  orv = osal_log(OSAL_IO_LOG_LEVEL__DEBUG, TAG, "debug %d\n", shmio_log_arg(1));
+  EXPECT_EQ(orv, OSAL_OK);
+  EXPECT_EQ(shmio_log_evaluated, 0) << " arguments of disabled level evaluated";
+  EXPECT_NE(osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr), OSAL_OK);
+
+  osal_uint64_t start = osal_timer_gettime_nsec();
+  orv = osal_log(OSAL_IO_LOG_LEVEL__WARNING, TAG, "warning %d\n", shmio_log_arg(2));
+  EXPECT_EQ(orv, OSAL_OK);
+  EXPECT_EQ(shmio_log_evaluated, 1);
+  osal_printf("untagged\n");
+  osal_uint64_t end = osal_timer_gettime_nsec();
+
+  // the level is also checked without the macro
+  orv = osal_log_printf(OSAL_IO_LOG_LEVEL__DEBUG, TAG, "debug %d\n", 4);
+  EXPECT_EQ(orv, OSAL_OK);
+  osal_io_set_log_level(OSAL_IO_LOG_LEVEL__WARNING);
+  orv = osal_printf("info\n");
+  EXPECT_EQ(orv, OSAL_OK);
+
+  osal_io_set_log_level(OSAL_IO_LOG_LEVEL__DEBUG);
+  osal_log(OSAL_IO_LOG_LEVEL__DEBUG, TAG, "debug %d\n", shmio_log_arg(3));
+  osal_io_set_log_level(OSAL_IO_LOG_LEVEL__INFO);
+
+  orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr);
+  ASSERT_EQ(orv, 0) << " osal_io_shm_acquire_messages failed";
+  ASSERT_EQ(cnt, (osal_size_t)3);
+
+  EXPECT_STREQ(msgs[0].msg, "warning 2\n");
+  EXPECT_EQ(msgs[0].level, OSAL_IO_LOG_LEVEL__WARNING);
+  ASSERT_NE(msgs[0].tag, nullptr);
+  EXPECT_STREQ(msgs[0].tag, TAG);
+  EXPECT_EQ(msgs[0].tid, (osal_uint32_t)gettid());
+  EXPECT_GE(msgs[0].timestamp, start);
+  EXPECT_LE(msgs[0].timestamp, msgs[1].timestamp);
+
+  EXPECT_STREQ(msgs[1].msg, "untagged\n");
+  EXPECT_EQ(msgs[1].level, OSAL_IO_LOG_LEVEL__INFO);
+  EXPECT_EQ(msgs[1].tag, nullptr);
+  EXPECT_LE(msgs[1].timestamp, end);
+
+  EXPECT_STREQ(msgs[2].msg, "debug 3\n");
+  EXPECT_EQ(msgs[2].level, OSAL_IO_LOG_LEVEL__DEBUG);
+  EXPECT_EQ(msgs[2].tag, msgs[0].tag) << " tag registered twice";
+  EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+}
+
+/* a sleeping reader has to be woken up by a writer long before its
+   timeout expires. */
+
+void *shmio_delayed_writer(void *p_arg) {
+  (void)p_arg;
+  osal_sleep(100000000);
+  osal_printf("wakeup\n");
+  return nullptr;
+}
+
+TEST(SHMIOMultithreading, ReaderWakeup) {
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+  unlink("/dev/shm/shm_io_wakeup");
+  osal_retval_t orv = osal_io_shm_setup("shm_io_wakeup", 32, 64);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  pthread_t thread;
+  pthread_create(&thread, nullptr, shmio_delayed_writer, nullptr);
+
+  time_t start = time(nullptr);
+  osal_timer_t deadline = {(osal_uint64_t)start + 10, 0};
+  orv = osal_io_shm_get_message(msg, &deadline);
+  time_t end = time(nullptr);
+
+  pthread_join(thread, nullptr);
+
+  ASSERT_EQ(orv, 0) << " reader was not woken up";
+  EXPECT_STREQ(msg, "wakeup\n");
+  EXPECT_LT(end - start, 5) << " reader was woken up by timeout";
+}
+
+/* the following test runs several writer threads which all print
+   into the same shm ring concurrently. The ring is big enough to hold
+   all messages, so every message has to be received exactly once,
+   untorn and in per-thread order. */
+
+const int NUM_WRITERS = 4;
+const int MSGS_PER_WRITER = 200;
+
+void *shmio_writer(void *p_arg) {
+  int writer_id = *((int *)p_arg);
+
+  for (int i = 0; i < MSGS_PER_WRITER; i++) {
+    osal_printf("writer %d message %d\n", writer_id, i);
+  }
+
+  return nullptr;
+}
+
+TEST(SHMIOMultithreading, ConcurrentWriters) {
+  unlink("/dev/shm/shm_io_mt");
+  osal_retval_t orv = osal_io_shm_setup("shm_io_mt", 1024, 64);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  pthread_t threads[NUM_WRITERS];
+  int writer_ids[NUM_WRITERS];
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    writer_ids[i] = i;
+    pthread_create(&threads[i], nullptr, shmio_writer, &writer_ids[i]);
+  }
+
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    pthread_join(threads[i], nullptr);
+  }
+
+  std::vector<int> next_msg(NUM_WRITERS, 0);
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+  for (int i = 0; i < (NUM_WRITERS * MSGS_PER_WRITER); i++) {
+    osal_timer_t deadline = {(osal_uint64_t)time(nullptr) + 2, 0};
+    orv = osal_io_shm_get_message(msg, &deadline);
+    ASSERT_EQ(orv, 0) << " message " << i << " missing";
+
+    int writer_id = -1;
+    int msg_id = -1;
+    ASSERT_EQ(sscanf(msg, "writer %d message %d\n", &writer_id, &msg_id), 2)
+        << "torn message: '" << msg << "'";
+    ASSERT_GE(writer_id, 0);
+    ASSERT_LT(writer_id, NUM_WRITERS);
+    EXPECT_EQ(msg_id, next_msg[writer_id]) << "lost or reordered message";
+    next_msg[writer_id] = msg_id + 1;
+  }
+
+  orv = osal_io_shm_get_message(msg, nullptr);
+  EXPECT_NE(orv, 0) << " unexpected additional message: '" << msg << "'";
+}
+
+/* with per task rings every writer thread gets a ring of its own as
+   long as there are free rings, the others share the common ring.
+   Rings are released when their thread exits. The reader has to merge
+   all rings by timestamp. */
+
+const int NUM_TASK_RINGS = 4;
+const int NUM_RING_WRITERS = 6;
+
+void *shmio_single_writer(void *p_arg) {
+  int writer_id = *((int *)p_arg);
+  osal_printf("sequential writer %d\n", writer_id);
+  return nullptr;
+}
+
+/* holds a task ring until released by the second barrier. */
+static pthread_barrier_t shmio_holder_barrier;
+
+void *shmio_ring_holder(void *p_arg) {
+  int holder_id = *((int *)p_arg);
+  osal_printf("holder %d\n", holder_id);
+  pthread_barrier_wait(&shmio_holder_barrier);
+  pthread_barrier_wait(&shmio_holder_barrier);
+  return nullptr;
+}
+
+/* prints its first message before any writer exits, so every writer
+   takes a ring while the others still hold theirs. */
+static pthread_barrier_t shmio_writer_barrier;
+
+void *shmio_synced_writer(void *p_arg) {
+  int writer_id = *((int *)p_arg);
+
+  osal_printf("writer %d message %d\n", writer_id, 0);
+  pthread_barrier_wait(&shmio_writer_barrier);
+  for (int i = 1; i < MSGS_PER_WRITER; i++) {
+    osal_printf("writer %d message %d\n", writer_id, i);
+  }
+
+  return nullptr;
+}
+
+/* runs concurrent writers and returns the number of messages received
+   in per-thread order. */
+static int shmio_run_writers() {
+  pthread_t threads[NUM_WRITERS];
+  int writer_ids[NUM_WRITERS];
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+  pthread_barrier_init(&shmio_writer_barrier, nullptr, NUM_WRITERS);
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    writer_ids[i] = i;
+    pthread_create(&threads[i], nullptr, shmio_synced_writer, &writer_ids[i]);
+  }
+
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    pthread_join(threads[i], nullptr);
+  }
+  pthread_barrier_destroy(&shmio_writer_barrier);
+
+  std::vector<int> next_msg(NUM_WRITERS, 0);
+  int received = 0;
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+    int writer_id = -1;
+    int msg_id = -1;
+    EXPECT_EQ(sscanf(msg, "writer %d message %d\n", &writer_id, &msg_id), 2)
+        << "torn message: '" << msg << "'";
+    if ((writer_id < 0) || (writer_id >= NUM_WRITERS)) {
+      ADD_FAILURE() << "invalid writer in message: '" << msg << "'";
+      break;
+    }
+    EXPECT_GE(msg_id, next_msg[writer_id]) << "reordered message";
+    next_msg[writer_id] = msg_id + 1;
+    received++;
+  }
+
+  return received;
+}
+
+TEST(SHMIOMultithreading, TaskRings) {
+  unlink("/dev/shm/shm_io_rings");
+  osal_io_shm_attr_t attr = NUM_TASK_RINGS << OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_rings", 256, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+
+  // drain messages printed by setup
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  // messages of writers running one after another have to be
+  // returned in that order, although they are in different rings
+  pthread_t threads[NUM_RING_WRITERS];
+  int writer_ids[NUM_RING_WRITERS];
+  for (int i = 0; i < NUM_RING_WRITERS; i++) {
+    writer_ids[i] = i;
+    pthread_create(&threads[i], nullptr, shmio_single_writer, &writer_ids[i]);
+    pthread_join(threads[i], nullptr);
+  }
+
+  for (int i = 0; i < NUM_RING_WRITERS; i++) {
+    char expected[64];
+    snprintf(expected, sizeof(expected), "sequential writer %d\n", i);
+
+    orv = osal_io_shm_get_message(msg, nullptr);
+    ASSERT_EQ(orv, 0) << " message " << i << " missing";
+    EXPECT_STREQ(msg, expected);
+  }
+
+  // the finished threads released their task rings, concurrent writers
+  // get a ring of their own and nothing is dropped
+  osal_io_shm_stats_t stats;
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  osal_uint64_t dropped = stats.dropped;
+
+  EXPECT_EQ(shmio_run_writers(), NUM_WRITERS * MSGS_PER_WRITER);
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.dropped, dropped) << "task rings were not released";
+
+  // with all task rings held by other threads, concurrent writers have
+  // to share the common ring
+  pthread_barrier_init(&shmio_holder_barrier, nullptr, NUM_TASK_RINGS + 1);
+  for (int i = 0; i < NUM_TASK_RINGS; i++) {
+    writer_ids[i] = i;
+    pthread_create(&threads[i], nullptr, shmio_ring_holder, &writer_ids[i]);
+  }
+  pthread_barrier_wait(&shmio_holder_barrier);
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  dropped = stats.dropped;
+  int received = shmio_run_writers();
+
+  // shared ring holds more than 256 short messages, the oldest ones 
+  // are dropped
+  EXPECT_GT(received, 256);
+  EXPECT_LT(received, NUM_WRITERS * MSGS_PER_WRITER);
+
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(received + (int)(stats.dropped - dropped), NUM_WRITERS * MSGS_PER_WRITER);
+
+  pthread_barrier_wait(&shmio_holder_barrier);
+  for (int i = 0; i < NUM_TASK_RINGS; i++) {
+    pthread_join(threads[i], nullptr);
+  }
+  pthread_barrier_destroy(&shmio_holder_barrier);
+}
+
+/* a writer process which leaves with _exit never releases its task
+   ring, the ring is taken over once its owner is gone. */
+
+TEST(SHMIOMultithreading, TaskRingsDeadOwner) {
+  unlink("/dev/shm/shm_io_rings_dead");
+  osal_io_shm_attr_t attr = NUM_TASK_RINGS << OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_rings_dead", 256, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  osal_char_t msg[LIBOSAL_IO_SHM_MAX_MSG_SIZE];
+  while (osal_io_shm_get_message(msg, nullptr) == OSAL_OK) {
+  }
+
+  // each child takes a free task ring, all of them stay claimed
+  for (int i = 0; i < NUM_TASK_RINGS; i++) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      osal_printf("child %d\n", i);
+      _exit(0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+  }
+
+  for (int i = 0; i < NUM_TASK_RINGS; i++) {
+    char expected[64];
+    snprintf(expected, sizeof(expected), "child %d\n", i);
+
+    orv = osal_io_shm_get_message(msg, nullptr);
+    ASSERT_EQ(orv, 0) << " message " << i << " missing";
+    EXPECT_STREQ(msg, expected);
+  }
+
+  // concurrent writers take over the rings of the dead children
+  osal_io_shm_stats_t stats;
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  osal_uint64_t dropped = stats.dropped;
+
+  EXPECT_EQ(shmio_run_writers(), NUM_WRITERS * MSGS_PER_WRITER);
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.dropped, dropped) << "rings of dead owners were not taken over";
+
+  // the layout of an existing shm is kept, another number of task rings 
+  // is only warned about
+  attr = 2u << OSAL_IO_SHM_ATTR__TASK_RINGS__SHIFT;
+  orv = osal_io_shm_setup_attr("shm_io_rings_dead", 256, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.num_rings, (osal_uint32_t)NUM_TASK_RINGS + 1u);
+}
+
+/* a writer blocking on a full ring has to be woken up each time the 
+   reader commits the messages it holds, no message may be lost. */
+
+const int NUM_BLOCKED_MSGS = 100;
+
+void *shmio_blocked_writer(void *p_arg) {
+  osal_retval_t *p_ret = (osal_retval_t *)p_arg;
+
+  for (int i = 0; (i < NUM_BLOCKED_MSGS) && (*p_ret == OSAL_OK); i++) {
+    *p_ret = osal_printf("blocked %d\n", i);
+  }
+
+  return nullptr;
+}
+
+TEST(SHMIOMultithreading, BlockedWriter) {
+  osal_io_shm_msg_t msgs[64];
+  osal_size_t cnt = 0;
+
+  unlink("/dev/shm/shm_io_blocked");
+  osal_io_shm_attr_t attr = OSAL_IO_SHM_ATTR__OVERFLOW__BLOCK;
+  osal_retval_t orv = osal_io_shm_setup_attr("shm_io_blocked", 4, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+
+  // drain messages printed by setup
+  while (osal_io_shm_acquire_messages(msgs, 64, &cnt, nullptr) == OSAL_OK) {
+    osal_io_shm_commit_messages();
+  }
+
+  osal_retval_t writer_ret = OSAL_OK;
+  pthread_t thread;
+  pthread_create(&thread, nullptr, shmio_blocked_writer, &writer_ret);
+
+  int received = 0;
+  while (received < NUM_BLOCKED_MSGS) {
+    osal_timer_t deadline = {(osal_uint64_t)time(nullptr) + 5, 0};
+    orv = osal_io_shm_acquire_messages(msgs, 64, &cnt, &deadline);
+    ASSERT_EQ(orv, 0) << " writer was not woken up after " << received << " messages";
+
+    for (osal_size_t i = 0; i < cnt; i++) {
+      char expected[32];
+      snprintf(expected, sizeof(expected), "blocked %d\n", received);
+      EXPECT_EQ(std::string(msgs[i].msg, msgs[i].len), expected);
+      received++;
+    }
+
+    // give the writer time to run the ring full and block
+    osal_sleep(1000000);
+    EXPECT_EQ(osal_io_shm_commit_messages(), OSAL_OK);
+  }
+
+  pthread_join(thread, nullptr);
+  EXPECT_EQ(writer_ret, OSAL_OK);
+
+  osal_io_shm_stats_t stats;
+  ASSERT_EQ(osal_io_shm_get_stats(&stats), OSAL_OK);
+  EXPECT_EQ(stats.dropped, 0u);
+
+  // reset policy for other tests
+  attr = 0;
+  orv = osal_io_shm_setup_attr("shm_io_blocked", 4, 64, &attr);
+  ASSERT_EQ(orv, 0) << " setting up shm io failed";
+}
+
 } // namespace test_shmio
 
 int main(int argc, char **argv) {
@@ -1,5 +1,8 @@
 #include "gtest/gtest.h"
 #include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <vector>
 
 #include "libosal/osal.h"
@@ -191,6 +194,286 @@ TEST(SpinlockMultithreading, RandomizedPlusWait) {
       << "multi-threaded counter test failed";
 }
 
+/* ticket and MCS spinlocks hand over in FIFO order. */
+
+static unsigned long run_parallel(osal_spinlock_attr_t attr, ulong n_threads,
+                                  uint loopcount) {
+  std::vector<pthread_t> thread_ids(n_threads);
+  std::vector<thread_param_t> thread_params(n_threads);
+  osal_spinlock_t count_spinlock;
+  unsigned long counter = 0;
+
+  EXPECT_EQ(osal_spinlock_init(&count_spinlock, &attr), OSAL_OK);
+
+  for (ulong i = 0; i < n_threads; i++) {
+    thread_params[i].thread_id = i;
+    thread_params[i].p_count_spinlock = &count_spinlock;
+    thread_params[i].p_counter = &counter;
+    thread_params[i].loopcount = loopcount;
+    thread_params[i].max_wait_time_nsec = 0;
+    pthread_create(&thread_ids[i], nullptr, test_random, &thread_params[i]);
+  }
+  for (ulong i = 0; i < n_threads; i++) {
+    pthread_join(thread_ids[i], nullptr);
+  }
+  EXPECT_EQ(osal_spinlock_destroy(&count_spinlock), OSAL_OK);
+
+  return counter;
+}
+
+TEST(SpinlockFunction, TicketParallel) {
+  const ulong N_THREADS = 8;
+  const uint LOOPCOUNT = 20000;
+
+  EXPECT_EQ(run_parallel(OSAL_SPINLOCK_ATTR__TYPE__TICKET, N_THREADS,
+                         LOOPCOUNT),
+            N_THREADS * LOOPCOUNT)
+      << "multi-threaded counter test failed";
+}
+
+TEST(SpinlockFunction, MCSParallel) {
+  const ulong N_THREADS = 8;
+  const uint LOOPCOUNT = 20000;
+
+  EXPECT_EQ(run_parallel(OSAL_SPINLOCK_ATTR__TYPE__MCS, N_THREADS, LOOPCOUNT),
+            N_THREADS * LOOPCOUNT)
+      << "multi-threaded counter test failed";
+}
+
+TEST(SpinlockFunction, MCSNested) {
+  osal_spinlock_attr_t attr = OSAL_SPINLOCK_ATTR__TYPE__MCS;
+  osal_spinlock_t first, second;
+
+  ASSERT_EQ(osal_spinlock_init(&first, &attr), OSAL_OK);
+  ASSERT_EQ(osal_spinlock_init(&second, &attr), OSAL_OK);
+
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(osal_spinlock_lock(&first), OSAL_OK);
+    ASSERT_EQ(osal_spinlock_lock(&second), OSAL_OK);
+    // release out of order
+    ASSERT_EQ(osal_spinlock_unlock(&first), OSAL_OK);
+    ASSERT_EQ(osal_spinlock_unlock(&second), OSAL_OK);
+  }
+
+  EXPECT_EQ(osal_spinlock_destroy(&first), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&second), OSAL_OK);
+}
+
+TEST(SpinlockFunction, TicketProcessShared) {
+  const int N_PROCS = 4;
+  const unsigned long LOOPCOUNT = 20000;
+  pid_t pids[N_PROCS];
+
+  struct shared_ticket_t {
+    osal_spinlock_t spinlock;
+    unsigned long counter;
+  };
+
+  shared_ticket_t *shared = (shared_ticket_t *)mmap(
+      nullptr, sizeof(shared_ticket_t), PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(shared, MAP_FAILED);
+
+  osal_spinlock_attr_t attr =
+      OSAL_SPINLOCK_ATTR__TYPE__TICKET | OSAL_SPINLOCK_ATTR__PROCESS_SHARED;
+  ASSERT_EQ(osal_spinlock_init(&shared->spinlock, &attr), OSAL_OK);
+  shared->counter = 0;
+
+  for (int i = 0; i < N_PROCS; i++) {
+    pids[i] = fork();
+    ASSERT_GE(pids[i], 0) << "fork() failed";
+    if (pids[i] == 0) {
+      for (unsigned long j = 0; j < LOOPCOUNT; j++) {
+        osal_spinlock_lock(&shared->spinlock);
+        volatile unsigned long old_value = shared->counter;
+        shared->counter = old_value + 1;
+        osal_spinlock_unlock(&shared->spinlock);
+      }
+      _exit(0);
+    }
+  }
+
+  for (int i = 0; i < N_PROCS; i++) {
+    waitpid(pids[i], nullptr, 0);
+  }
+
+  EXPECT_EQ(shared->counter, N_PROCS * LOOPCOUNT)
+      << "multi-process counter test failed";
+  EXPECT_EQ(osal_spinlock_destroy(&shared->spinlock), OSAL_OK);
+  munmap(shared, sizeof(shared_ticket_t));
+}
+
+TEST(SpinlockDetect, QueuedUsageErrors) {
+  osal_spinlock_attr_t attr = OSAL_SPINLOCK_ATTR__TYPE__MCS;
+  osal_spinlock_t my_spinlock;
+
+  ASSERT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_ERR_PERMISSION_DENIED)
+      << "unlock of unlocked MCS spinlock was not detected";
+  ASSERT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_ERR_DEAD_LOCK)
+      << "relock of MCS spinlock was not detected";
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_ERR_OPERATION_FAILED);
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_OK);
+
+  attr = OSAL_SPINLOCK_ATTR__TYPE__TICKET;
+  ASSERT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_ERR_PERMISSION_DENIED)
+      << "unlock of unlocked ticket spinlock was not detected";
+  ASSERT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_ERR_OPERATION_FAILED);
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_OK);
+}
+
+TEST(SpinlockReject, QueuedAttributes) {
+  osal_spinlock_t my_spinlock;
+  osal_spinlock_attr_t attr;
+
+  attr = OSAL_SPINLOCK_ATTR__TYPE__TICKET | OSAL_SPINLOCK_ATTR__ROBUST;
+  EXPECT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_ERR_INVALID_PARAM);
+
+  attr = OSAL_SPINLOCK_ATTR__TYPE__MCS | OSAL_SPINLOCK_ATTR__ROBUST;
+  EXPECT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_ERR_INVALID_PARAM);
+
+  attr = OSAL_SPINLOCK_ATTR__TYPE__MCS | OSAL_SPINLOCK_ATTR__PROCESS_SHARED;
+  EXPECT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_ERR_INVALID_PARAM);
+}
+
+/* robust and process shared spinlocks track their owner. */
+
+TEST(SpinlockDetect, RelockAndForeignUnlock) {
+  osal_spinlock_t my_spinlock;
+  osal_spinlock_attr_t attr = OSAL_SPINLOCK_ATTR__PROCESS_SHARED;
+  pthread_t thread_id;
+
+  ASSERT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_OK);
+  ASSERT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_ERR_DEAD_LOCK)
+      << "relock by owner was not detected";
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_ERR_OPERATION_FAILED)
+      << "locked spinlock could be destroyed";
+
+  ASSERT_EQ(pthread_create(
+                &thread_id, nullptr,
+                [](void *arg) -> void * {
+                  return (void *)(long)osal_spinlock_unlock(
+                      (osal_spinlock_t *)arg);
+                },
+                &my_spinlock),
+            0);
+  void *unlock_ret = nullptr;
+  pthread_join(thread_id, &unlock_ret);
+  EXPECT_EQ((long)unlock_ret, OSAL_ERR_PERMISSION_DENIED)
+      << "unlock by other task was not detected";
+
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_OK);
+}
+
+void *lock_and_exit(void *p_params) {
+  osal_spinlock_lock((osal_spinlock_t *)p_params);
+  return nullptr;
+}
+
+TEST(SpinlockDetect, OwnerDeadThread) {
+  osal_spinlock_t my_spinlock;
+  osal_spinlock_attr_t attr = OSAL_SPINLOCK_ATTR__ROBUST;
+  pthread_t thread_id;
+
+  ASSERT_EQ(osal_spinlock_init(&my_spinlock, &attr), OSAL_OK);
+  ASSERT_EQ(pthread_create(&thread_id, nullptr, lock_and_exit, &my_spinlock),
+            0);
+  pthread_join(thread_id, nullptr);
+
+  EXPECT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_ERR_OWNER_DEAD)
+      << "lock of dead owner was not taken over";
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_lock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_unlock(&my_spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&my_spinlock), OSAL_OK);
+}
+
+/* the spinlock lives in shared anonymous memory, a forked process
+   holds it when it terminates. */
+
+struct shared_t {
+  osal_spinlock_t spinlock;
+  unsigned long counter;
+};
+
+static shared_t *map_shared() {
+  void *ptr = mmap(nullptr, sizeof(shared_t), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  return (ptr == MAP_FAILED) ? nullptr : (shared_t *)ptr;
+}
+
+TEST(SpinlockDetect, OwnerDeadProcess) {
+  shared_t *shared = map_shared();
+  ASSERT_NE(shared, nullptr);
+
+  osal_spinlock_attr_t attr =
+      OSAL_SPINLOCK_ATTR__PROCESS_SHARED | OSAL_SPINLOCK_ATTR__ROBUST;
+  ASSERT_EQ(osal_spinlock_init(&shared->spinlock, &attr), OSAL_OK);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+  if (pid == 0) {
+    _exit((osal_spinlock_lock(&shared->spinlock) == OSAL_OK) ? 0 : 1);
+  }
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  ASSERT_EQ(status, 0) << "child could not lock spinlock";
+
+  EXPECT_EQ(osal_spinlock_lock(&shared->spinlock), OSAL_ERR_OWNER_DEAD)
+      << "lock of dead process was not taken over";
+  EXPECT_EQ(osal_spinlock_unlock(&shared->spinlock), OSAL_OK);
+  EXPECT_EQ(osal_spinlock_destroy(&shared->spinlock), OSAL_OK);
+  munmap(shared, sizeof(shared_t));
+}
+
+TEST(SpinlockFunction, ProcessShared) {
+  const int N_PROCS = 4;
+  const unsigned long LOOPCOUNT = 20000;
+  pid_t pids[N_PROCS];
+
+  shared_t *shared = map_shared();
+  ASSERT_NE(shared, nullptr);
+
+  osal_spinlock_attr_t attr = OSAL_SPINLOCK_ATTR__PROCESS_SHARED;
+  ASSERT_EQ(osal_spinlock_init(&shared->spinlock, &attr), OSAL_OK);
+  shared->counter = 0;
+
+  for (int i = 0; i < N_PROCS; i++) {
+    pids[i] = fork();
+    ASSERT_GE(pids[i], 0) << "fork() failed";
+    if (pids[i] == 0) {
+      for (unsigned long j = 0; j < LOOPCOUNT; j++) {
+        if (osal_spinlock_lock(&shared->spinlock) != OSAL_OK) {
+          _exit(1);
+        }
+        volatile unsigned long old_value = shared->counter;
+        shared->counter = old_value + 1;
+        osal_spinlock_unlock(&shared->spinlock);
+      }
+      _exit(0);
+    }
+  }
+
+  for (int i = 0; i < N_PROCS; i++) {
+    int status = -1;
+    waitpid(pids[i], &status, 0);
+    EXPECT_EQ(status, 0) << "process could not lock spinlock";
+  }
+
+  EXPECT_EQ(shared->counter, N_PROCS * LOOPCOUNT)
+      << "multi-process counter test failed";
+  EXPECT_EQ(osal_spinlock_destroy(&shared->spinlock), OSAL_OK);
+  munmap(shared, sizeof(shared_t));
+}
+
 } // namespace test_spinlock
 
 int main(int argc, char **argv) {
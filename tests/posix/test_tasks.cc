@@ -533,6 +533,195 @@ TEST(TasksMultithreadingFunction, SuspendResume) {
 
 #endif
 
+/* periodic tasks are released at absolute deadlines on the monotonic
+   clock, overruns are counted. */
+
+typedef struct {
+  osal_uint64_t period;
+  osal_uint64_t busy;
+  osal_uint32_t max_calls;
+  volatile osal_uint32_t calls;
+  volatile int stop;
+  osal_uint64_t first;
+  osal_uint64_t last;
+} periodic_param_t;
+
+static osal_uint64_t monotonic_nsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((osal_uint64_t)ts.tv_sec * 1000000000u) + ts.tv_nsec;
+}
+
+static osal_retval_t periodic_handler(void *arg) {
+  periodic_param_t *param = (periodic_param_t *)arg;
+  osal_uint64_t now = monotonic_nsec();
+
+  if (param->calls == 0) {
+    param->first = now;
+  }
+  param->last = now;
+  param->calls = param->calls + 1;
+
+  if (param->busy > 0) {
+    while ((monotonic_nsec() - now) < param->busy) {
+    }
+  }
+
+  return ((param->stop != 0) || (param->calls >= param->max_calls))
+             ? OSAL_ERR_INTERRUPTED
+             : OSAL_OK;
+}
+
+TEST(TasksPeriodicFunction, Release) {
+  const osal_uint64_t PERIOD = 2000000;
+  const osal_uint64_t OFFSET = 500000;
+  osal_task_t task;
+  osal_task_periodic_stats_t stats;
+  periodic_param_t param = {};
+
+  param.period = PERIOD;
+  param.max_calls = 50;
+
+  ASSERT_EQ(osal_task_create_periodic(&task, nullptr, PERIOD, OFFSET,
+                                      periodic_handler, &param),
+            OSAL_OK);
+
+  while (param.calls < param.max_calls) {
+    osal_sleep(PERIOD);
+  }
+
+  ASSERT_EQ(osal_task_get_periodic_stats(&task, &stats), OSAL_OK);
+  EXPECT_EQ(stats.cycles, param.max_calls);
+  EXPECT_NE(stats.trace, nullptr);
+  EXPECT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  // releases follow the absolute schedule, missed ones are skipped
+  osal_uint64_t releases =
+      (param.last - OFFSET) / PERIOD - (param.first - OFFSET) / PERIOD;
+  EXPECT_EQ(releases, param.max_calls - 1 + stats.overruns)
+      << "releases do not follow absolute schedule";
+  EXPECT_GE((param.first % PERIOD), OFFSET)
+      << "first release not at period offset";
+}
+
+TEST(TasksPeriodicFunction, Overrun) {
+  const osal_uint64_t PERIOD = 1000000;
+  osal_task_t task;
+  osal_task_periodic_stats_t stats;
+  periodic_param_t param = {};
+
+  param.period = PERIOD;
+  param.busy = 2500000;
+  param.max_calls = 1000;
+
+  ASSERT_EQ(osal_task_create_periodic(&task, nullptr, PERIOD, 0,
+                                      periodic_handler, &param),
+            OSAL_OK);
+
+  while (param.calls < 5) {
+    osal_sleep(PERIOD);
+  }
+  param.stop = 1;
+
+  ASSERT_EQ(osal_task_get_periodic_stats(&task, &stats), OSAL_OK);
+  EXPECT_GE(stats.overruns, 2 * (stats.cycles - 1))
+      << "overruns were not detected";
+  EXPECT_GE(stats.max_exec, param.busy);
+  EXPECT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+}
+
+/* tasks start without a polling handshake and run with their
+   scheduling attributes from the first instruction of the handler. */
+
+TEST(TasksStartFunction, Latency) {
+  const int NUM = 200;
+  osal_task_t task;
+
+  osal_uint64_t start = monotonic_nsec();
+  for (int i = 0; i < NUM; i++) {
+    ASSERT_EQ(osal_task_create(
+                  &task, nullptr, [](void *) -> void * { return nullptr; },
+                  nullptr),
+              OSAL_OK);
+    ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+  }
+  osal_uint64_t avg = (monotonic_nsec() - start) / NUM;
+
+  EXPECT_LT(avg, 500000u) << "task start takes " << avg << " ns on average";
+}
+
+typedef struct {
+  int policy;
+  int priority;
+  volatile int stop;
+} start_param_t;
+
+static void *start_attrs(void *arg) {
+  start_param_t *param = (start_param_t *)arg;
+  struct sched_param sp;
+
+  pthread_getschedparam(pthread_self(), &param->policy, &sp);
+  param->priority = sp.sched_priority;
+
+  while (param->stop == 0) {
+    osal_sleep(1000000);
+  }
+  return nullptr;
+}
+
+TEST(TasksStartFunction, Attributes) {
+  osal_task_t task;
+  osal_task_attr_t attr = {};
+  start_param_t param = {-1, -1, 0};
+  osal_task_sched_policy_t policy;
+  osal_task_sched_priority_t prio;
+
+  attr.policy = OSAL_SCHED_POLICY_FIFO;
+  attr.priority = 10;
+  attr.affinity = 0x1;
+
+  ASSERT_EQ(osal_task_create(&task, &attr, start_attrs, &param), OSAL_OK);
+
+  ASSERT_EQ(osal_task_get_policy(&task, &policy), OSAL_OK);
+  ASSERT_EQ(osal_task_get_priority(&task, &prio), OSAL_OK);
+
+  // the handler runs after the creator is released, its results are
+  // only complete after the join
+  param.stop = 1;
+  ASSERT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+
+  // attributes seen by the handler at start are the final ones, with
+  // or without the privileges to use them
+  EXPECT_EQ(param.policy,
+            (policy == OSAL_SCHED_POLICY_FIFO) ? SCHED_FIFO : SCHED_OTHER);
+  EXPECT_EQ(param.priority, (int)prio);
+}
+
+TEST(TasksPeriodicReject, InvalidPeriod) {
+  osal_task_t task;
+  periodic_param_t param = {};
+
+  EXPECT_EQ(osal_task_create_periodic(&task, nullptr, 0, 0, periodic_handler,
+                                      &param),
+            OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_task_create_periodic(&task, nullptr, 1000000, 1000000,
+                                      periodic_handler, &param),
+            OSAL_ERR_INVALID_PARAM);
+}
+
+TEST(TasksPeriodicReject, NotPeriodic) {
+  osal_task_t task;
+  osal_task_periodic_stats_t stats;
+
+  ASSERT_EQ(osal_task_create(
+                &task, nullptr, [](void *) -> void * { return nullptr; },
+                nullptr),
+            OSAL_OK);
+  EXPECT_EQ(osal_task_get_periodic_stats(&task, &stats),
+            OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_task_join(&task, nullptr), OSAL_OK);
+}
+
 } // namespace test_getattrs
 
 int main(int argc, char **argv) {
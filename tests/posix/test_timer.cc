@@ -469,6 +469,145 @@ TEST(TimerFunction, BusyWait) {
   EXPECT_GE(stop, now + delta) << "osal_busy_wait incorrect delta";
 }
 
+TEST(TimerFunction, SleepUntilPrecise) {
+  const bool runs_realtime = is_realtime();
+
+  // the sleep has to be a lot more precise than osal_sleep_until
+  const osal_uint64_t TIMER_TOLERANCE_MORE_NS = runs_realtime ? 10000 : 50000;
+  const osal_uint64_t delta = 2000000;
+  const int LOOPS = 100;
+  osal_uint64_t max_late = 0;
+  osal_uint64_t sum_late = 0;
+
+  for (int i = 0; i < LOOPS; i++) {
+    osal_timer_t deadline;
+    osal_timer_init(&deadline, delta);
+    const osal_uint64_t deadline_nsec =
+        (deadline.sec * NSEC_PER_SEC) + deadline.nsec;
+
+    osal_retval_t orv = osal_sleep_until_precise(&deadline);
+    const osal_uint64_t stop = osal_timer_gettime_nsec();
+
+    ASSERT_EQ(orv, OSAL_OK) << "osal_sleep_until_precise failed";
+    ASSERT_GE(stop, deadline_nsec) << "woke up before deadline";
+
+    osal_uint64_t late = stop - deadline_nsec;
+    sum_late += late;
+    if (late > max_late) {
+      max_late = late;
+    }
+  }
+
+  if (verbose) {
+    printf("precise sleep: average late %lu ns, max late %lu ns\n",
+           (unsigned long)(sum_late / LOOPS), (unsigned long)max_late);
+  }
+
+  // the spin phase ends right after the deadline unless preempted
+  if (check_latency) {
+    EXPECT_LT(sum_late / LOOPS, TIMER_TOLERANCE_MORE_NS)
+        << "average wakeup too late";
+  }
+}
+
+/* timers carry their clock, the configured clock source only
+   applies to timers initialized afterwards. */
+
+TEST(TimerFunction, ClockIds) {
+  const osal_uint64_t delta = 10000000;
+  osal_timer_t timer;
+
+  EXPECT_EQ(osal_timer_get_clock_source(), LIBOSAL_CLOCK_MONOTONIC)
+      << "monotonic clock is not the default";
+  osal_timer_init(&timer, delta);
+  EXPECT_EQ(osal_timer_clock(&timer), LIBOSAL_CLOCK_MONOTONIC);
+
+  osal_timer_set_clock_source(LIBOSAL_CLOCK_REALTIME);
+  EXPECT_EQ(osal_timer_expired(&timer), OSAL_OK)
+      << "timer followed the changed clock source";
+  osal_timer_set_clock_source(LIBOSAL_CLOCK_MONOTONIC);
+
+  const int clocks[] = {LIBOSAL_CLOCK_MONOTONIC, LIBOSAL_CLOCK_REALTIME};
+  for (int clock_id : clocks) {
+    ASSERT_EQ(osal_timer_init_clock(&timer, clock_id, delta), OSAL_OK);
+    EXPECT_EQ(osal_timer_clock(&timer), clock_id);
+
+    const osal_uint64_t start = osal_timer_gettime_nsec();
+    EXPECT_EQ(osal_sleep_until(&timer), OSAL_OK);
+    const osal_uint64_t stop = osal_timer_gettime_nsec();
+
+    EXPECT_EQ(osal_timer_expired(&timer), OSAL_ERR_TIMEOUT);
+    EXPECT_GE(stop - start + 100000, delta) << "clock " << clock_id;
+  }
+
+  EXPECT_EQ(osal_timer_init_clock(&timer, -1000, delta),
+            OSAL_ERR_INVALID_PARAM);
+
+  // a timer built by hand without a tagged clock is on CLOCK_REALTIME,
+  // whatever is left in its clock field
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  timer.sec = now.tv_sec + 1;
+  timer.nsec = 0;
+  timer.clock_tag = CLOCK_MONOTONIC;
+  EXPECT_EQ(osal_timer_clock(&timer), LIBOSAL_CLOCK_REALTIME);
+  EXPECT_EQ(osal_timer_expired(&timer), OSAL_OK);
+  timer.sec = now.tv_sec - 1;
+  EXPECT_EQ(osal_timer_expired(&timer), OSAL_ERR_TIMEOUT);
+}
+
+/* the TSC clock source must follow the monotonic clock, whether the
+   cpu has an invariant TSC or the monotonic clock is used instead. */
+
+static uint64_t monotonic_nsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+TEST(TimerFunction, ClockTsc) {
+  const int previous = osal_timer_get_clock_source();
+  const uint64_t TOLERANCE_NS = 100000;
+  const int LOOPS = 100000;
+
+  osal_timer_set_clock_source(LIBOSAL_CLOCK_TSC);
+  EXPECT_EQ(osal_timer_get_clock_source(), LIBOSAL_CLOCK_MONOTONIC)
+      << "sleeps and waits have to use the monotonic clock";
+
+  uint64_t last = osal_timer_gettime_nsec();
+  long backwards = 0;
+  for (int i = 0; i < LOOPS; i++) {
+    uint64_t now = osal_timer_gettime_nsec();
+    if (now < last) {
+      backwards++;
+    }
+    last = now;
+  }
+  EXPECT_EQ(backwards, 0) << "clock went backwards";
+
+  // spans several re-syncs with the monotonic clock
+  for (int i = 0; i < 30; i++) {
+    osal_sleep(20000000);
+
+    uint64_t before = monotonic_nsec();
+    uint64_t now = osal_timer_gettime_nsec();
+    uint64_t after = monotonic_nsec();
+
+    EXPECT_GE(now + TOLERANCE_NS, before) << "TSC time lags behind";
+    EXPECT_LE(now, after + TOLERANCE_NS) << "TSC time runs ahead";
+    EXPECT_GE(now, last) << "clock went backwards on re-sync";
+    last = now;
+
+    // deadlines are built on the same time base
+    osal_timer_t deadline;
+    osal_timer_init(&deadline, 0);
+    EXPECT_GE((deadline.sec * 1000000000u) + deadline.nsec, now);
+    EXPECT_EQ(osal_timer_expired(&deadline), OSAL_ERR_TIMEOUT);
+  }
+
+  osal_timer_set_clock_source(previous);
+}
+
 } // namespace test_timer
 
 int main(int argc, char **argv) {
@@ -0,0 +1,262 @@
+#include "libosal/osal.h"
+#include "libosal/timerwheel.h"
+#include "gtest/gtest.h"
+#include <stdlib.h>
+#include <vector>
+
+namespace test_timerwheel {
+
+using std::vector;
+
+/*
+  Tests of the timer wheel. Handlers record the time they were
+  called, which is compared against the time the timer was armed.
+*/
+
+// generous, the tests do not run with real-time priority
+const osal_uint64_t LATE_TOLERANCE_NS = 50000000;
+
+struct record_t {
+  osal_uint64_t due;
+  osal_uint64_t fired;
+  int calls;
+};
+
+static void record_handler(osal_void_t *arg) {
+  record_t *rec = (record_t *)arg;
+  rec->fired = osal_timer_gettime_nsec();
+  rec->calls++;
+}
+
+/* drive the wheel manually until all records fired or timeout. */
+static void process_until(osal_timerwheel_t *tw, vector<record_t> &recs,
+                          osal_uint64_t timeout_ns) {
+  osal_uint64_t end = osal_timer_gettime_nsec() + timeout_ns;
+
+  while (osal_timer_gettime_nsec() < end) {
+    ASSERT_EQ(osal_timerwheel_process(tw), OSAL_OK);
+
+    bool done = true;
+    for (const record_t &rec : recs) {
+      if (rec.calls == 0) {
+        done = false;
+        break;
+      }
+    }
+    if (done) {
+      break;
+    }
+    osal_sleep(100000);
+  }
+}
+
+/* one-shot timers fire once and never early, a cancelled timer
+   does not fire. */
+
+TEST(TimerwheelFunction, OneShot) {
+  osal_timerwheel_t tw;
+  const osal_uint64_t delays[] = {0, 1000000, 5000000, 20000000, 100000000};
+  const int NUM = sizeof(delays) / sizeof(delays[0]);
+  vector<record_t> recs(NUM);
+  vector<osal_timerwheel_timer_t> timers(NUM);
+  record_t cancelled = {0, 0, 0};
+  osal_timerwheel_timer_t cancelled_timer;
+
+  ASSERT_EQ(osal_timerwheel_init(&tw, 1000000), OSAL_OK);
+
+  for (int i = 0; i < NUM; i++) {
+    recs[i] = {osal_timer_gettime_nsec() + delays[i], 0, 0};
+    ASSERT_EQ(osal_timerwheel_timer_init(&timers[i], record_handler, &recs[i]),
+              OSAL_OK);
+    ASSERT_EQ(osal_timerwheel_arm(&tw, &timers[i], delays[i], 0), OSAL_OK);
+  }
+
+  ASSERT_EQ(osal_timerwheel_timer_init(&cancelled_timer, record_handler,
+                                       &cancelled),
+            OSAL_OK);
+  ASSERT_EQ(osal_timerwheel_arm(&tw, &cancelled_timer, 10000000, 0), OSAL_OK);
+  EXPECT_EQ(osal_timerwheel_cancel(&tw, &cancelled_timer), OSAL_OK);
+  EXPECT_EQ(osal_timerwheel_cancel(&tw, &cancelled_timer),
+            OSAL_ERR_NOT_FOUND);
+
+  process_until(&tw, recs, 2000000000);
+
+  for (int i = 0; i < NUM; i++) {
+    EXPECT_EQ(recs[i].calls, 1) << "timer " << i;
+    EXPECT_GE(recs[i].fired, recs[i].due) << "timer " << i << " fired early";
+    EXPECT_LT(recs[i].fired, recs[i].due + LATE_TOLERANCE_NS)
+        << "timer " << i << " fired late";
+    EXPECT_EQ(osal_timerwheel_cancel(&tw, &timers[i]), OSAL_ERR_NOT_FOUND)
+        << "one-shot timer still armed";
+  }
+  EXPECT_EQ(cancelled.calls, 0) << "cancelled timer fired";
+
+  EXPECT_EQ(osal_timerwheel_destroy(&tw), OSAL_OK);
+}
+
+/* many timers spread over several levels of the wheel, each fires
+   once in time after it was cascaded down. */
+
+TEST(TimerwheelFunction, ManyTimers) {
+  osal_timerwheel_t tw;
+  const int NUM = 20000;
+  const osal_uint64_t MAX_DELAY_NS = 400000000;
+  vector<record_t> recs(NUM);
+  vector<osal_timerwheel_timer_t> timers(NUM);
+
+  // 1 us ticks, 400 ms reach the fourth level
+  ASSERT_EQ(osal_timerwheel_init(&tw, 1000), OSAL_OK);
+
+  srand(42);
+  for (int i = 0; i < NUM; i++) {
+    osal_uint64_t delay = (osal_uint64_t)rand() % MAX_DELAY_NS;
+    recs[i] = {osal_timer_gettime_nsec() + delay, 0, 0};
+    ASSERT_EQ(osal_timerwheel_timer_init(&timers[i], record_handler, &recs[i]),
+              OSAL_OK);
+    ASSERT_EQ(osal_timerwheel_arm(&tw, &timers[i], delay, 0), OSAL_OK);
+  }
+
+  // cancel every tenth timer again
+  for (int i = 0; i < NUM; i += 10) {
+    EXPECT_EQ(osal_timerwheel_cancel(&tw, &timers[i]), OSAL_OK);
+    recs[i].calls = -1;
+  }
+
+  process_until(&tw, recs, 5000000000);
+
+  int early = 0, late = 0, wrong = 0;
+  for (int i = 0; i < NUM; i++) {
+    if ((i % 10) == 0) {
+      wrong += (recs[i].calls != -1) ? 1 : 0;
+      continue;
+    }
+    wrong += (recs[i].calls != 1) ? 1 : 0;
+    early += (recs[i].fired < recs[i].due) ? 1 : 0;
+    late += (recs[i].fired >= recs[i].due + LATE_TOLERANCE_NS) ? 1 : 0;
+  }
+
+  EXPECT_EQ(wrong, 0) << "timers not fired exactly once";
+  EXPECT_EQ(early, 0) << "timers fired early";
+  EXPECT_EQ(late, 0) << "timers fired late";
+
+  EXPECT_EQ(osal_timerwheel_destroy(&tw), OSAL_OK);
+}
+
+/* a periodic timer on the dedicated task, which cancels itself. */
+
+struct periodic_t {
+  osal_timerwheel_t *tw;
+  osal_timerwheel_timer_t timer;
+  int calls;
+  int max_calls;
+};
+
+static void periodic_handler(osal_void_t *arg) {
+  periodic_t *p = (periodic_t *)arg;
+
+  if (__atomic_add_fetch(&p->calls, 1, __ATOMIC_RELAXED) == p->max_calls) {
+    osal_timerwheel_cancel(p->tw, &p->timer);
+  }
+}
+
+TEST(TimerwheelFunction, PeriodicTask) {
+  osal_timerwheel_t tw;
+  periodic_t endless = {&tw, {}, 0, 0};
+  periodic_t limited = {&tw, {}, 0, 3};
+
+  ASSERT_EQ(osal_timerwheel_init(&tw, 1000000), OSAL_OK);
+  ASSERT_EQ(osal_timerwheel_start(&tw, NULL), OSAL_OK);
+  EXPECT_EQ(osal_timerwheel_start(&tw, NULL), OSAL_ERR_BUSY);
+
+  ASSERT_EQ(osal_timerwheel_timer_init(&endless.timer, periodic_handler,
+                                       &endless),
+            OSAL_OK);
+  ASSERT_EQ(osal_timerwheel_timer_init(&limited.timer, periodic_handler,
+                                       &limited),
+            OSAL_OK);
+  ASSERT_EQ(osal_timerwheel_arm(&tw, &endless.timer, 10000000, 10000000),
+            OSAL_OK);
+  ASSERT_EQ(osal_timerwheel_arm(&tw, &limited.timer, 5000000, 5000000),
+            OSAL_OK);
+
+  osal_sleep(205000000);
+
+  EXPECT_EQ(osal_timerwheel_cancel(&tw, &endless.timer), OSAL_OK);
+  EXPECT_EQ(osal_timerwheel_stop(&tw), OSAL_OK);
+  EXPECT_EQ(osal_timerwheel_stop(&tw), OSAL_ERR_NOT_FOUND);
+
+  int calls = __atomic_load_n(&endless.calls, __ATOMIC_RELAXED);
+  EXPECT_GE(calls, 15) << "periodic timer missed periods";
+  EXPECT_LE(calls, 21) << "periodic timer called too often";
+  EXPECT_EQ(limited.calls, 3) << "timer cancelled by its handler fired again";
+  EXPECT_EQ(osal_timerwheel_cancel(&tw, &limited.timer), OSAL_ERR_NOT_FOUND);
+
+  EXPECT_EQ(osal_timerwheel_destroy(&tw), OSAL_OK);
+}
+
+/* timers armed while a handler runs are due in the tick being
+   processed or shortly after, they must not wait for the slot to
+   come up a full turn of the wheel later. */
+
+struct chain_t {
+  osal_timerwheel_t *tw;
+  osal_timerwheel_timer_t timer;
+  record_t *next;
+  osal_timerwheel_timer_t *next_timer;
+  osal_uint64_t next_delay;
+};
+
+static void chain_handler(osal_void_t *arg) {
+  chain_t *c = (chain_t *)arg;
+
+  c->next->due = osal_timer_gettime_nsec() + c->next_delay;
+  osal_timerwheel_arm(c->tw, c->next_timer, c->next_delay, 0);
+}
+
+TEST(TimerwheelFunction, ArmFromHandler) {
+  const osal_uint64_t TICK_NS = 1000000;
+  const osal_uint64_t delays[] = {0, TICK_NS / 2, TICK_NS};
+  const int NUM = sizeof(delays) / sizeof(delays[0]);
+  osal_timerwheel_t tw;
+  vector<record_t> recs(NUM);
+  vector<osal_timerwheel_timer_t> timers(NUM);
+  vector<chain_t> chains(NUM);
+
+  ASSERT_EQ(osal_timerwheel_init(&tw, TICK_NS), OSAL_OK);
+
+  for (int i = 0; i < NUM; i++) {
+    recs[i] = {0, 0, 0};
+    chains[i] = {&tw, {}, &recs[i], &timers[i], delays[i]};
+    ASSERT_EQ(osal_timerwheel_timer_init(&timers[i], record_handler, &recs[i]),
+              OSAL_OK);
+    ASSERT_EQ(osal_timerwheel_timer_init(&chains[i].timer, chain_handler,
+                                         &chains[i]),
+              OSAL_OK);
+    ASSERT_EQ(osal_timerwheel_arm(&tw, &chains[i].timer, 5 * TICK_NS, 0),
+              OSAL_OK);
+  }
+
+  process_until(&tw, recs, 2000000000);
+
+  for (int i = 0; i < NUM; i++) {
+    EXPECT_EQ(recs[i].calls, 1) << "timer " << i;
+    EXPECT_GE(recs[i].fired, recs[i].due) << "timer " << i << " fired early";
+    EXPECT_LT(recs[i].fired, recs[i].due + LATE_TOLERANCE_NS)
+        << "timer " << i << " fired late";
+  }
+
+  EXPECT_EQ(osal_timerwheel_destroy(&tw), OSAL_OK);
+}
+
+TEST(TimerwheelReject, ZeroTick) {
+  osal_timerwheel_t tw;
+
+  EXPECT_EQ(osal_timerwheel_init(&tw, 0), OSAL_ERR_INVALID_PARAM);
+}
+
+} // namespace test_timerwheel
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
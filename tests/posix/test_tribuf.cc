@@ -0,0 +1,228 @@
+#include "libosal/osal.h"
+#include "libosal/tribuf.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace test_tribuf {
+
+using testutils::set_deadline;
+
+/*
+  Tests of the triple buffer. Samples are state vectors whose
+  elements all carry the same value, a sample with differing
+  elements was overwritten while the consumer owned it.
+*/
+
+#define SHM_NAME "/test_tribuf"
+
+const int NUM_VALUES = 64;
+
+struct sample_t {
+  uint64_t values[NUM_VALUES];
+};
+
+static void fill_sample(sample_t *sample, uint64_t value) {
+  for (int i = 0; i < NUM_VALUES; i++) {
+    sample->values[i] = value;
+  }
+}
+
+static bool is_consistent(const sample_t *sample) {
+  for (int i = 1; i < NUM_VALUES; i++) {
+    if (sample->values[i] != sample->values[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static osal_retval_t publish(osal_tribuf_t *tb, uint64_t value) {
+  osal_void_t *ptr = NULL;
+  osal_retval_t ret = osal_tribuf_get_write_buffer(tb, &ptr);
+  if (ret == OSAL_OK) {
+    fill_sample((sample_t *)ptr, value);
+    ret = osal_tribuf_publish(tb);
+  }
+  return ret;
+}
+
+static osal_tribuf_attr_t create_attr() {
+  return OSAL_TRIBUF_ATTR__FLAG__CREAT |
+         (S_IRWXU << OSAL_TRIBUF_ATTR__MODE__SHIFT);
+}
+
+/* the consumer sees nothing before the first publish and the
+   latest sample afterwards, older samples are dropped. */
+
+TEST(TribufFunction, LatestWins) {
+  osal_tribuf_t producer, consumer;
+  osal_tribuf_attr_t attr = create_attr();
+  const osal_void_t *ptr = NULL;
+  osal_size_t size = 0;
+
+  shm_unlink(SHM_NAME);
+  ASSERT_EQ(osal_tribuf_create(&producer, SHM_NAME, &attr, sizeof(sample_t)),
+            OSAL_OK);
+  ASSERT_EQ(osal_tribuf_attach(&consumer, SHM_NAME), OSAL_OK);
+  EXPECT_EQ(osal_tribuf_get_size(&consumer, &size), OSAL_OK);
+  EXPECT_EQ(size, sizeof(sample_t));
+
+  EXPECT_EQ(osal_tribuf_acquire_latest(&consumer, &ptr), OSAL_ERR_NO_DATA);
+
+  EXPECT_EQ(publish(&producer, 1), OSAL_OK);
+  EXPECT_EQ(osal_tribuf_acquire_latest(&consumer, &ptr), OSAL_OK);
+  EXPECT_EQ(((const sample_t *)ptr)->values[0], 1u);
+  EXPECT_EQ(osal_tribuf_acquire_latest(&consumer, &ptr), OSAL_ERR_NO_DATA);
+  EXPECT_EQ(((const sample_t *)ptr)->values[0], 1u)
+      << "previous sample was not kept";
+
+  for (uint64_t value = 2; value <= 5; value++) {
+    EXPECT_EQ(publish(&producer, value), OSAL_OK);
+  }
+  EXPECT_EQ(osal_tribuf_acquire_latest(&consumer, &ptr), OSAL_OK);
+  EXPECT_EQ(((const sample_t *)ptr)->values[0], 5u);
+  EXPECT_TRUE(is_consistent((const sample_t *)ptr));
+
+  EXPECT_EQ(osal_tribuf_close(&consumer), OSAL_OK);
+  EXPECT_EQ(osal_tribuf_close(&producer), OSAL_OK);
+  shm_unlink(SHM_NAME);
+}
+
+TEST(TribufDetect, AttachNotExisting) {
+  osal_tribuf_t tb;
+
+  shm_unlink(SHM_NAME);
+  EXPECT_EQ(osal_tribuf_attach(&tb, SHM_NAME), OSAL_ERR_NOT_FOUND);
+}
+
+TEST(TribufReject, ZeroSize) {
+  osal_tribuf_t tb;
+  osal_tribuf_attr_t attr = create_attr();
+
+  shm_unlink(SHM_NAME);
+  EXPECT_EQ(osal_tribuf_create(&tb, SHM_NAME, &attr, 0),
+            OSAL_ERR_INVALID_PARAM);
+  shm_unlink(SHM_NAME);
+}
+
+TEST(TribufFunction, WaitTimeout) {
+  osal_tribuf_t tb;
+  osal_tribuf_attr_t attr = create_attr();
+
+  shm_unlink(SHM_NAME);
+  ASSERT_EQ(osal_tribuf_create(&tb, SHM_NAME, &attr, sizeof(sample_t)),
+            OSAL_OK);
+
+  osal_timer_t deadline = set_deadline(0, 10000000);
+  EXPECT_EQ(osal_tribuf_wait(&tb, &deadline), OSAL_ERR_TIMEOUT);
+
+  EXPECT_EQ(publish(&tb, 1), OSAL_OK);
+  deadline = set_deadline(0, 10000000);
+  EXPECT_EQ(osal_tribuf_wait(&tb, &deadline), OSAL_OK)
+      << "pending sample was not reported";
+
+  EXPECT_EQ(osal_tribuf_close(&tb), OSAL_OK);
+  shm_unlink(SHM_NAME);
+}
+
+/* a producer thread publishes while the consumer is blocked in
+   osal_tribuf_wait. */
+
+static void *delayed_producer(void *arg) {
+  osal_tribuf_t *tb = (osal_tribuf_t *)arg;
+
+  osal_sleep(20000000);
+  publish(tb, 42);
+
+  return NULL;
+}
+
+TEST(TribufFunction, WaitWakeup) {
+  osal_tribuf_t producer, consumer;
+  osal_tribuf_attr_t attr = create_attr();
+  const osal_void_t *ptr = NULL;
+  pthread_t thread;
+
+  shm_unlink(SHM_NAME);
+  ASSERT_EQ(osal_tribuf_create(&producer, SHM_NAME, &attr, sizeof(sample_t)),
+            OSAL_OK);
+  ASSERT_EQ(osal_tribuf_attach(&consumer, SHM_NAME), OSAL_OK);
+
+  ASSERT_EQ(pthread_create(&thread, NULL, delayed_producer, &producer), 0);
+
+  osal_timer_t deadline = set_deadline(5, 0);
+  EXPECT_EQ(osal_tribuf_wait(&consumer, &deadline), OSAL_OK);
+  EXPECT_EQ(osal_tribuf_acquire_latest(&consumer, &ptr), OSAL_OK);
+  EXPECT_EQ(((const sample_t *)ptr)->values[0], 42u);
+
+  pthread_join(thread, NULL);
+  EXPECT_EQ(osal_tribuf_close(&consumer), OSAL_OK);
+  EXPECT_EQ(osal_tribuf_close(&producer), OSAL_OK);
+  shm_unlink(SHM_NAME);
+}
+
+/* a producer process publishes increasing values without pause,
+   the consumer must never see torn or outdated samples. */
+
+TEST(TribufFunction, InterProcess) {
+  const uint64_t LAST = 200000;
+  osal_tribuf_t tb;
+  osal_tribuf_attr_t attr = create_attr();
+  const osal_void_t *ptr = NULL;
+
+  shm_unlink(SHM_NAME);
+  ASSERT_EQ(osal_tribuf_create(&tb, SHM_NAME, &attr, sizeof(sample_t)),
+            OSAL_OK);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0) << "fork() failed";
+
+  if (pid == 0) {
+    osal_tribuf_t child;
+    if (osal_tribuf_attach(&child, SHM_NAME) != OSAL_OK) {
+      _exit(1);
+    }
+    for (uint64_t value = 1; value <= LAST; value++) {
+      publish(&child, value);
+    }
+    osal_tribuf_close(&child);
+    _exit(0);
+  }
+
+  uint64_t last = 0;
+  long failed = 0;
+  while (last < LAST) {
+    osal_timer_t deadline = set_deadline(5, 0);
+    if (osal_tribuf_wait(&tb, &deadline) != OSAL_OK) {
+      break;
+    }
+    EXPECT_EQ(osal_tribuf_acquire_latest(&tb, &ptr), OSAL_OK);
+    const sample_t *sample = (const sample_t *)ptr;
+    if (!is_consistent(sample) || (sample->values[0] <= last)) {
+      failed++;
+    }
+    last = sample->values[0];
+  }
+
+  EXPECT_EQ(last, LAST) << "last sample was not received";
+  EXPECT_EQ(failed, 0) << "consumer saw torn or outdated samples";
+
+  int status = -1;
+  waitpid(pid, &status, 0);
+  EXPECT_EQ(status, 0) << "producer process failed";
+
+  EXPECT_EQ(osal_tribuf_close(&tb), OSAL_OK);
+  shm_unlink(SHM_NAME);
+}
+
+} // namespace test_tribuf
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -46,7 +46,7 @@ inline osal_timer_t set_deadline(int sec, long nsec)
 {
   timespec now;
   clock_gettime(CLOCK_REALTIME, &now);
-  osal_timer_t deadline;
+  osal_timer_t deadline = OSAL_TIMER_INITIALIZER_CLOCK(CLOCK_REALTIME);
   deadline.sec = now.tv_sec + sec;
   deadline.nsec = now.tv_nsec + nsec;
   while (deadline.nsec > 1000000000) {
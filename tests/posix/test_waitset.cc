@@ -0,0 +1,293 @@
+#include "libosal/binary_semaphore.h"
+#include "libosal/mq.h"
+#include "libosal/osal.h"
+#include "libosal/semaphore.h"
+#include "libosal/waitset.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sys/stat.h>
+
+namespace test_waitset {
+
+using testutils::set_deadline;
+
+/*
+  Tests of pollable osal objects and of the waitset which blocks
+  on any subset of them with a single timeout.
+*/
+
+enum { ID_SEM = 1, ID_BINSEM = 2, ID_MQ = 3 };
+
+/* a pollable semaphore keeps its counting semantics and is
+   readable as long as its counter is greater than 0. */
+
+TEST(WaitsetFunction, PollableSemaphore) {
+  osal_semaphore_t sem;
+  osal_semaphore_attr_t attr = OSAL_SEMAPHORE_ATTR__POLLABLE;
+  osal_waitset_t ws;
+  osal_uint32_t ids[4];
+  osal_size_t cnt = 0;
+  osal_int32_t fd = -1;
+
+  ASSERT_EQ(osal_semaphore_init(&sem, &attr, 2), OSAL_OK);
+  ASSERT_EQ(osal_semaphore_get_fd(&sem, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_init(&ws), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_SEM), OSAL_OK);
+  EXPECT_EQ(osal_waitset_add(&ws, fd, ID_SEM), OSAL_ERR_INVALID_PARAM);
+
+  osal_timer_t deadline = set_deadline(0, 10000000);
+  EXPECT_EQ(osal_waitset_wait(&ws, ids, 4, &cnt, &deadline), OSAL_OK);
+  EXPECT_EQ(cnt, 1u);
+  EXPECT_EQ(ids[0], (osal_uint32_t)ID_SEM);
+
+  // readiness does not consume the semaphore
+  EXPECT_EQ(osal_semaphore_trywait(&sem), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_wait(&sem), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_trywait(&sem), OSAL_ERR_BUSY);
+
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_semaphore_timedwait(&sem, &deadline), OSAL_ERR_TIMEOUT);
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_waitset_wait(&ws, ids, 4, &cnt, &deadline), OSAL_ERR_TIMEOUT);
+  EXPECT_EQ(cnt, 0u);
+
+  EXPECT_EQ(osal_semaphore_post(&sem), OSAL_OK);
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_semaphore_timedwait(&sem, &deadline), OSAL_OK);
+
+  EXPECT_EQ(osal_waitset_remove(&ws, fd), OSAL_OK);
+  EXPECT_EQ(osal_waitset_remove(&ws, fd), OSAL_ERR_NOT_FOUND);
+  EXPECT_EQ(osal_waitset_destroy(&ws), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_destroy(&sem), OSAL_OK);
+}
+
+/* a non-pollable semaphore does not provide a descriptor. */
+
+TEST(WaitsetFunction, NotPollable) {
+  osal_semaphore_t sem;
+  osal_binary_semaphore_t binsem;
+  osal_int32_t fd = -1;
+
+  ASSERT_EQ(osal_semaphore_init(&sem, NULL, 0), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_get_fd(&sem, &fd), OSAL_ERR_NOT_IMPLEMENTED);
+  EXPECT_EQ(osal_semaphore_destroy(&sem), OSAL_OK);
+
+  ASSERT_EQ(osal_binary_semaphore_init(&binsem, NULL), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_get_fd(&binsem, &fd), OSAL_ERR_NOT_IMPLEMENTED);
+  EXPECT_EQ(osal_binary_semaphore_destroy(&binsem), OSAL_OK);
+}
+
+/* a pollable binary semaphore collapses several posts into one
+   signal. */
+
+TEST(WaitsetFunction, PollableBinarySemaphore) {
+  osal_binary_semaphore_t sem;
+  osal_binary_semaphore_attr_t attr = OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE;
+  osal_waitset_t ws;
+  osal_uint32_t ids[4];
+  osal_size_t cnt = 0;
+  osal_int32_t fd = -1;
+
+  ASSERT_EQ(osal_binary_semaphore_init(&sem, &attr), OSAL_OK);
+  ASSERT_EQ(osal_binary_semaphore_get_fd(&sem, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_init(&ws), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_BINSEM), OSAL_OK);
+
+  EXPECT_EQ(osal_binary_semaphore_trywait(&sem), OSAL_ERR_BUSY);
+  EXPECT_EQ(osal_binary_semaphore_timedwait(&sem, NULL), OSAL_ERR_TIMEOUT);
+
+  EXPECT_EQ(osal_binary_semaphore_post(&sem), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_post(&sem), OSAL_OK);
+
+  osal_timer_t deadline = set_deadline(0, 10000000);
+  EXPECT_EQ(osal_waitset_wait(&ws, ids, 4, &cnt, &deadline), OSAL_OK);
+  EXPECT_EQ(cnt, 1u);
+  EXPECT_EQ(ids[0], (osal_uint32_t)ID_BINSEM);
+
+  EXPECT_EQ(osal_binary_semaphore_wait(&sem), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_trywait(&sem), OSAL_ERR_BUSY);
+
+  deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_binary_semaphore_timedwait(&sem, &deadline), OSAL_ERR_TIMEOUT);
+
+  EXPECT_EQ(osal_waitset_destroy(&ws), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_destroy(&sem), OSAL_OK);
+}
+
+/* timeouts of pollable objects are not rounded up to whole
+   milliseconds. The shortest of several waits is checked, so
+   scheduling delays of single waits do not matter. */
+
+static osal_uint64_t timeout_nsec(osal_semaphore_t *sem,
+                                  osal_binary_semaphore_t *binsem,
+                                  osal_waitset_t *ws) {
+  const osal_uint64_t TIMEOUT_NS = 200000;
+  osal_uint64_t min_elapsed = UINT64_MAX;
+
+  for (int i = 0; i < 10; i++) {
+    osal_timer_t deadline;
+    osal_uint32_t ids[4];
+    osal_size_t cnt = 0;
+    osal_retval_t orv;
+
+    osal_timer_init(&deadline, TIMEOUT_NS);
+    osal_uint64_t start = osal_timer_gettime_nsec();
+    if (sem != NULL) {
+      orv = osal_semaphore_timedwait(sem, &deadline);
+    } else if (binsem != NULL) {
+      orv = osal_binary_semaphore_timedwait(binsem, &deadline);
+    } else {
+      orv = osal_waitset_wait(ws, ids, 4, &cnt, &deadline);
+    }
+    osal_uint64_t elapsed = osal_timer_gettime_nsec() - start;
+
+    EXPECT_EQ(orv, OSAL_ERR_TIMEOUT);
+    min_elapsed = (elapsed < min_elapsed) ? elapsed : min_elapsed;
+  }
+
+  return min_elapsed;
+}
+
+TEST(WaitsetFunction, SubMillisecondTimeout) {
+  osal_semaphore_t sem;
+  osal_semaphore_attr_t sem_attr = OSAL_SEMAPHORE_ATTR__POLLABLE;
+  osal_binary_semaphore_t binsem;
+  osal_binary_semaphore_attr_t binsem_attr =
+      OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE;
+  osal_int32_t fd = -1;
+
+  ASSERT_EQ(osal_semaphore_init(&sem, &sem_attr, 0), OSAL_OK);
+  ASSERT_EQ(osal_binary_semaphore_init(&binsem, &binsem_attr), OSAL_OK);
+
+  EXPECT_LT(timeout_nsec(&sem, NULL, NULL), 800000u) << "semaphore";
+  EXPECT_LT(timeout_nsec(NULL, &binsem, NULL), 800000u) << "binary semaphore";
+
+#if LIBOSAL_HAVE_EPOLL_PWAIT2 == 1
+  osal_waitset_t ws;
+  ASSERT_EQ(osal_waitset_init(&ws), OSAL_OK);
+  ASSERT_EQ(osal_semaphore_get_fd(&sem, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_SEM), OSAL_OK);
+  EXPECT_LT(timeout_nsec(NULL, NULL, &ws), 800000u) << "waitset";
+  EXPECT_EQ(osal_waitset_destroy(&ws), OSAL_OK);
+#else
+  (void)fd;
+#endif
+
+  EXPECT_EQ(osal_binary_semaphore_destroy(&binsem), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_destroy(&sem), OSAL_OK);
+}
+
+/* a thread posts to one of several objects, the waitset wakes up
+   and reports exactly that object. */
+
+struct poster_args {
+  osal_semaphore_t *sem;
+  osal_binary_semaphore_t *binsem;
+  osal_mq_t *mq;
+  int which;
+};
+
+static void *poster(void *arg) {
+  poster_args *args = (poster_args *)arg;
+  osal_sleep(10000000);
+
+  if (args->which == ID_SEM) {
+    osal_semaphore_post(args->sem);
+  } else if (args->which == ID_BINSEM) {
+    osal_binary_semaphore_post(args->binsem);
+  } else {
+    char msg = 'x';
+    osal_mq_send(args->mq, &msg, sizeof(msg), 0);
+  }
+
+  return NULL;
+}
+
+TEST(WaitsetFunction, WaitAny) {
+  osal_semaphore_t sem;
+  osal_semaphore_attr_t sem_attr = OSAL_SEMAPHORE_ATTR__POLLABLE;
+  osal_binary_semaphore_t binsem;
+  osal_binary_semaphore_attr_t binsem_attr = OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE;
+  osal_mq_t mq;
+  osal_mq_attr_t mq_attr = {};
+  osal_waitset_t ws;
+  osal_int32_t fd = -1;
+
+  mq_attr.oflags = OSAL_MQ_ATTR__OFLAG__RDWR | OSAL_MQ_ATTR__OFLAG__CREAT;
+  mq_attr.mode = S_IRUSR | S_IWUSR;
+  mq_attr.max_messages = 4;
+  mq_attr.max_message_size = 8;
+
+  ASSERT_EQ(osal_semaphore_init(&sem, &sem_attr, 0), OSAL_OK);
+  ASSERT_EQ(osal_binary_semaphore_init(&binsem, &binsem_attr), OSAL_OK);
+  ASSERT_EQ(osal_mq_open(&mq, "/test_waitset", &mq_attr), OSAL_OK);
+  ASSERT_EQ(osal_waitset_init(&ws), OSAL_OK);
+
+  ASSERT_EQ(osal_semaphore_get_fd(&sem, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_SEM), OSAL_OK);
+  ASSERT_EQ(osal_binary_semaphore_get_fd(&binsem, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_BINSEM), OSAL_OK);
+  ASSERT_EQ(osal_mq_get_fd(&mq, &fd), OSAL_OK);
+  ASSERT_EQ(osal_waitset_add(&ws, fd, ID_MQ), OSAL_OK);
+
+  for (int which = ID_SEM; which <= ID_MQ; which++) {
+    poster_args args = {&sem, &binsem, &mq, which};
+    pthread_t thread;
+    osal_uint32_t ids[4];
+    osal_size_t cnt = 0;
+
+    ASSERT_EQ(pthread_create(&thread, NULL, poster, &args), 0);
+
+    osal_timer_t deadline = set_deadline(5, 0);
+    EXPECT_EQ(osal_waitset_wait(&ws, ids, 4, &cnt, &deadline), OSAL_OK);
+    EXPECT_EQ(cnt, 1u);
+    EXPECT_EQ(ids[0], (osal_uint32_t)which);
+
+    pthread_join(thread, NULL);
+
+    if (which == ID_SEM) {
+      EXPECT_EQ(osal_semaphore_trywait(&sem), OSAL_OK);
+    } else if (which == ID_BINSEM) {
+      EXPECT_EQ(osal_binary_semaphore_trywait(&binsem), OSAL_OK);
+    } else {
+      char msg[8];
+      osal_uint32_t prio;
+      EXPECT_EQ(osal_mq_receive(&mq, msg, sizeof(msg), &prio), OSAL_OK);
+    }
+  }
+
+  osal_uint32_t ids[4];
+  osal_size_t cnt = 0;
+  osal_timer_t deadline = set_deadline(0, 20000000);
+  EXPECT_EQ(osal_waitset_wait(&ws, ids, 4, &cnt, &deadline), OSAL_ERR_TIMEOUT);
+
+  EXPECT_EQ(osal_waitset_destroy(&ws), OSAL_OK);
+  EXPECT_EQ(osal_mq_close(&mq), OSAL_OK);
+  EXPECT_EQ(osal_binary_semaphore_destroy(&binsem), OSAL_OK);
+  EXPECT_EQ(osal_semaphore_destroy(&sem), OSAL_OK);
+}
+
+/* a descriptor can not be shared through shared memory, pollable
+   process shared semaphores are rejected. */
+
+TEST(WaitsetReject, PollableProcessShared) {
+  osal_semaphore_t sem;
+  osal_binary_semaphore_t binsem;
+  osal_semaphore_attr_t attr =
+      OSAL_SEMAPHORE_ATTR__POLLABLE | OSAL_SEMAPHORE_ATTR__PROCESS_SHARED;
+  osal_binary_semaphore_attr_t binattr =
+      OSAL_BINARY_SEMAPHORE_ATTR__POLLABLE |
+      OSAL_BINARY_SEMAPHORE_ATTR__PROCESS_SHARED;
+
+  EXPECT_EQ(osal_semaphore_init(&sem, &attr, 0), OSAL_ERR_INVALID_PARAM);
+  EXPECT_EQ(osal_binary_semaphore_init(&binsem, &binattr),
+            OSAL_ERR_INVALID_PARAM);
+}
+
+} // namespace test_waitset
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}